@@ -0,0 +1,56 @@
+/*
+ *********************************************************************
+ * Ian Leuty
+ * inleuty@gmail.com
+ * 10/19/2026
+ *********************************************************************
+ * animation declaration
+ *********************************************************************
+ * Plays back a Trace of a Red_Black tree.
+ *
+ * The trace's starting shape is rebuilt in a shadow tree and every
+ * insert or remove in the trace is applied to it. Each one is a frame,
+ * its status line lists the rotations and color flips it caused.
+ *
+ * Frames are drawn by diffing against the previous frame, only the
+ * lines that changed are rewritten (cursor addressed), so large trees
+ * can be played at any frame rate. Without ANSI every frame is
+ * printed in full.
+ *********************************************************************
+ */
+
+#ifndef ANIMATION
+#define ANIMATION
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include "structures.h"
+
+template<typename KEY>
+class Animation
+{
+    public:
+        Animation(const Trace<KEY> &trace);
+
+        //play every frame, 'fps' frames per second (0 for no delay)
+        //returns the number of frames played
+        int play(std::ostream &out, int fps, bool ansi = true);
+
+    private:
+        const Trace<KEY> &trace;
+
+        //the tree being animated, only the keys matter
+        Red_Black<KEY, char> shadow;
+
+        //lines of the frame currently on screen
+        std::vector<std::string> screen;
+
+        int apply(int &index, std::string &status);
+        void draw(std::ostream &out, const std::string &status, bool ansi);
+        void split(const std::string &frame, std::vector<std::string> &lines) const;
+};
+
+#include "animation.tpp"
+
+#endif
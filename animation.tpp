@@ -0,0 +1,138 @@
+/*
+ *********************************************************************
+ * Ian Leuty
+ * inleuty@gmail.com
+ * 10/19/2026
+ *********************************************************************
+ * animation template definition
+ *********************************************************************
+ */
+
+/*
+ *********************************************************************
+ * animation template
+ * data members are:
+ *      const Trace<KEY> &trace;
+ *      Red_Black<KEY, char> shadow;
+ *      std::vector<std::string> screen;
+ *********************************************************************
+ */
+
+//constructor, the trace must outlive the animation
+template<typename KEY>
+Animation<KEY>::Animation(const Trace<KEY> &trace) : trace(trace) {}
+
+//rebuild the starting tree and play every insert or remove as a frame
+template<typename KEY>
+int Animation<KEY>::play(std::ostream &out, int fps, bool ansi)
+{
+    const auto delay{std::chrono::microseconds(fps > 0 ? 1000000 / fps : 0)};
+    int frames{};
+
+    trace.restore(shadow);
+    screen.clear();
+    if (ansi)
+        out << "\033[2J";
+
+    std::stringstream status;
+    status << "Start: " << shadow.size() << " keys, " << trace.size() << " events";
+    draw(out, status.str(), ansi);
+
+    int index{};
+    while (index < trace.size()){
+        std::string line;
+        if (!apply(index, line))
+            continue;
+        ++frames;
+        std::this_thread::sleep_for(delay);
+        draw(out, "#" + std::to_string(frames) + " " + line, ansi);
+    }
+    return frames;
+}
+
+//apply the insert or remove at 'index' to the shadow tree
+//the rotations and flips after it are collected into 'status'
+//returns 0 if the event at 'index' did not start a frame
+template<typename KEY>
+int Animation<KEY>::apply(int &index, std::string &status)
+{
+    std::stringstream line;
+    const Event event{trace.event(index)};
+    const KEY &key{trace.key(index)};
+    ++index;
+
+    if (event == Event::INSERT){
+        shadow.try_insert(key, char{});
+        line << "Inserted " << key;
+    }
+    else if (event == Event::REMOVE){
+        shadow.remove(key);
+        line << "Removed " << key;
+    }
+    else
+        return 0;
+
+    //everything up to the next insert or remove happened because of this one
+    int rotations{}, flips{};
+    while (index < trace.size() && trace.event(index) != Event::INSERT && trace.event(index) != Event::REMOVE){
+        line << (rotations + flips ? ", " : " | ");
+        switch (trace.event(index)){
+            case Event::ROTATE_LEFT:
+                line << "rotate left " << trace.key(index);
+                ++rotations;
+                break;
+            case Event::ROTATE_RIGHT:
+                line << "rotate right " << trace.key(index);
+                ++rotations;
+                break;
+            default:
+                line << "flip " << trace.key(index);
+                ++flips;
+                break;
+        }
+        ++index;
+    }
+    status = line.str();
+    return 1;
+}
+
+//draw the shadow tree under 'status'
+//with ANSI only the lines that differ from what is on screen are rewritten
+template<typename KEY>
+void Animation<KEY>::draw(std::ostream &out, const std::string &status, bool ansi)
+{
+    std::stringstream frame;
+    frame << status << "\n\n";
+    shadow.render(frame, -1, ansi);
+
+    if (!ansi){
+        out << frame.str() << "\n" << std::endl;
+        return;
+    }
+
+    std::vector<std::string> lines;
+    split(frame.str(), lines);
+
+    const size_t rows{std::max(lines.size(), screen.size())};
+    for (size_t row{}; row < rows; ++row){
+        //left over from a taller frame
+        if (row >= lines.size())
+            out << "\033[" << row + 1 << ";1H\033[K";
+        else if (row >= screen.size() || lines[row] != screen[row])
+            out << "\033[" << row + 1 << ";1H" << lines[row] << "\033[K";
+    }
+
+    //leave the cursor under the frame
+    out << "\033[" << lines.size() + 1 << ";1H" << std::flush;
+    screen.swap(lines);
+}
+
+//break a rendered frame into its lines
+template<typename KEY>
+void Animation<KEY>::split(const std::string &frame, std::vector<std::string> &lines) const
+{
+    std::stringstream in(frame);
+    std::string line;
+    while (getline(in, line))
+        lines.push_back(line);
+}
@@ -16,7 +16,7 @@ using namespace std;
  *********************************************************************
  * menu class implementation
  * data menmbers are:
-        Red_Black<std::string, std::shared_ptr<Contestant>> tree;
+        Red_Black<std::string, std::shared_ptr<Contestant>, Field_Stats> tree;
         bool cycling{}, walking{}, running {};
         std::ifstream filein;
         std::string filename;
@@ -70,12 +70,20 @@ void Menu::load_contestants()
     cout << "\n" << loaded << " contestants were loaded from the roster." << endl;
 }
 
-//load a roster of contestants from a file
+//ask for a roster file and load it
 int Menu::load()
 {
-    int num_loaded{};
+    string roster;
     cout << "\nEnter the name of the contestant roster file.\n>";
-    getline(cin, filename);
+    getline(cin, roster);
+    return load(roster);
+}
+
+//load a roster of contestants from a file
+int Menu::load(const string &roster)
+{
+    int num_loaded{};
+    filename = roster;
 
     //throw exception if file not opened
     filein.open(filename);
@@ -84,6 +92,8 @@ int Menu::load()
 
     filein.peek();
 
+    //rosters are usually sorted by name, so each insert is hinted just past the last one
+    int hint{};
     while (!filein.eof()){
         string name{};
         int type{};
@@ -94,41 +104,35 @@ int Menu::load()
         filein.ignore(100, ',');
         getline(filein, name, ',');
 
-        //check for duplicates
-        //operator[] doesn't care, it just overwrites tree[name]
-        //this is the intended behavior
-        //if you don't want this behavior, use the named insert function which throws
-        //a TREE_ERROR::duplicate_name_exception
-        if (tree.find(name))
-            dupl = true;
-
-        //this version uses the overloaded operator[] of the Red_Black template.
+        shared_ptr<Contestant> contestant;
         switch (type){
-            case 1: {
-                        auto walk_ptr{make_shared<Walking_Contestant>(name, filein)};
-                        tree[name] = move(walk_ptr);
-                        ++num_loaded;
-                    }
+            case 1:
+                contestant = make_shared<Walking_Contestant>(name, filein);
                 break;
-
-            case 2: {
-                        auto b_ptr{make_shared<Bicycle_Contestant>(name, filein)};
-                        tree[name] = move(b_ptr);
-                        ++num_loaded;
-                    }
+            case 2:
+                contestant = make_shared<Bicycle_Contestant>(name, filein);
                 break;
-
-            case 3: {
-                        auto hm_ptr{make_shared<Half_Marathon_Contestant>(name, filein)};
-                        tree[name] = move(hm_ptr);
-                        ++num_loaded;
-                    }
+            case 3:
+                contestant = make_shared<Half_Marathon_Contestant>(name, filein);
                 break;
-
             default:
                 break;
         }
 
+        //duplicates overwrite, this is the intended behavior
+        //take the old entry out of the other indexes before it is overwritten
+        if (contestant){
+            auto [held, inserted]{tree.insert_hint(hint, name, contestant)};
+            if (!inserted){
+                dupl = true;
+                withdraw(name);
+                *held = move(contestant);
+            }
+            enroll(name);
+            refresh(name);
+            ++num_loaded;
+        }
+
         if (dupl){
             cout << "\n" << name << " already registered, overwriting with newest named entry...." << endl;
             --num_loaded;
@@ -194,6 +198,8 @@ bool Menu::reg()
                     break;
         }
         if (success){
+            enroll(name);
+            refresh(name);
             cout << "\nContestant registered." << endl;
             return 1;
         }
@@ -268,14 +274,35 @@ void Menu::display_contestants()
 void Menu::find_contestant()
 {
     cout << "\nFind contestant(s)" << endl;
+    //the registry does not change while searching, so typing more of the same
+    //name narrows the last search instead of starting over
+    Red_Black<string, shared_ptr<Contestant>, Field_Stats>::prefix_cursor cursor;
     do{
         string name;
-        cout << "\nEnter a contstant's name to check if they're registered.\n>";
+        cout << "\nEnter a contstant's name (or the start of it) to check if they're registered.\n>";
         getline(cin, name);
-        if (tree.find(name))
+        //once registration closes the frozen roster answers instead of the tree
+        const bool closed{!roster.empty()};
+        if (closed ? roster.find(name) : tree.find(name))
             cout << "\n" << name << " is registered." << endl;
-        else
+        else{
             cout << "\n" << name << " is not registered." << endl;
+            vector<string> names;
+            vector<shared_ptr<Contestant>> contestants;
+            int listed{closed ? roster.prefix_search(name, COMPLETIONS, names, contestants)
+                              : tree.prefix_search(cursor, name, COMPLETIONS, names, contestants)};
+            if (listed){
+                int matches{closed ? roster.matches(name) : cursor.matches()};
+                cout << "\n" << matches << " name" << (matches == 1 ? "" : "s")
+                     << " start with \"" << name << "\":" << endl;
+                for (const auto &found : names)
+                    cout << "    " << found << endl;
+                if (matches > COMPLETIONS)
+                    cout << "    ..." << endl;
+            }
+            else
+                suggest(name);
+        }
 
         cout << "\nSearch ";
     } while (again());
@@ -289,22 +316,26 @@ void Menu::hydrate_runner()
         string name;
         cout << "\nEnter a runner's name to hydrate them.\n>";
         getline(cin, name);
-        try{
-            //use the Red_Black retrieve function (overloaded []) which returns a unique_ptr reference to the player at a node
-            //dynamic cast to ID the player type and allow them to hydrate properly if a runner....or..... :)
-            auto w_ptr{dynamic_pointer_cast<Walking_Contestant>(tree[name])};
-            auto hm_ptr{dynamic_pointer_cast<Half_Marathon_Contestant>(tree[name])};
-
-            if (hm_ptr)
-                hm_ptr -> hydrate();
+        //use the Red_Black find_ptr function which returns a pointer to the player at a node
+        //a mistyped name is just a nullptr, no exception (and no empty node like operator[] would make)
+        //dynamic cast to ID the player type and allow them to hydrate properly if a runner....or..... :)
+        if (auto contestant{tree.find_ptr(name)}){
+            auto w_ptr{dynamic_pointer_cast<Walking_Contestant>(*contestant)};
+            auto hm_ptr{dynamic_pointer_cast<Half_Marathon_Contestant>(*contestant)};
+
+            if (hm_ptr){
+                //better hydrated runners are projected to finish sooner
+                if (hm_ptr -> hydrate())
+                    refresh(name);
+            }
             else if (w_ptr)
                 cout << "\nSorry, the water is only for runners. Try the Benson Bubblers?" << endl;
             else
                 cout << "\nSorry, cyclists cannot be hydrated with normal water, only beer." << endl;
         }
-        //the search terminates in a sentinel node meaning the player was not present
-        catch (TREE_ERROR::not_found_exception &error){
-            cout << error.msg;
+        else{
+            cout << TREE_ERROR::not_found_exception().msg;
+            suggest(name);
         }
         cout << "\nHydrate ";
     } while (again());
@@ -319,6 +350,7 @@ void Menu::unregister()
         string name;
         cout << "\nEnter a contstant's name to remove them from the registration.\n>";
         getline(cin, name);
+        withdraw(name);
         if (tree.remove(name)){
             cout << "\n" << name << " was removed." << endl;
             ++unregistered;
@@ -331,6 +363,33 @@ void Menu::unregister()
     cout << "\n" << unregistered << " contestants were unregistered." << endl;
 }
 
+//remove every disqualified contestant, and optionally everyone who never checked in,
+//in one pass over the registry (see Red_Black::remove_if)
+void Menu::purge()
+{
+    char choice{};
+    cout << "\nRemove every disqualified contestant."
+         << "\nAlso remove the no-shows (contestants who never checked in)? (y/n)\n>";
+    cin >> choice;
+    cin.ignore(100, '\n');
+
+    int removed{purge(toupper(choice) == 'Y')};
+    cout << "\n" << removed << " contestants were removed, " << tree.size() << " remain." << endl;
+}
+
+//remove_if calls the predicate on everyone before removing anyone, so each one going
+//can still be found in the tree to take them off the other indexes
+int Menu::purge(bool no_shows)
+{
+    return tree.remove_if([this, no_shows](const string &name, const shared_ptr<Contestant> &contestant){
+        bool out{contestant -> is_status(Status::DISQUALIFIED)
+                 || (no_shows && (contestant -> is_status(Status::REGISTERED) || contestant -> is_status(Status::PRE_REGISTERED)))};
+        if (out)
+            withdraw(name);
+        return out;
+    });
+}
+
 //retrieve (a) contestant(s) and use their average speed as well as race specifics to estimate completion
 void Menu::estimate_completion()
 {
@@ -343,7 +402,7 @@ void Menu::estimate_completion()
 
         if (tree.find(name)){
             cout << "\n" << name << " is registered." << endl;
-            if (!tree[name] -> is_status("CHECKED IN")){
+            if (!tree[name] -> is_status(Status::CHECKED_IN)){
                 cout << "\nNot enough details to estimate " << name << "'s completion.\n"
                      << "This contestant must first check in.\n"
                      << "Check in now? (y/n)\n>";
@@ -378,6 +437,324 @@ void Menu::estimate_completion()
     } while (again());
 }
 
+//project every contestant in the field at once
+//uses the batch Projection instead of one virtual call per contestant
+void Menu::estimate_field()
+{
+    cout << "\nEstimate progress for the whole field." << endl;
+    vector<shared_ptr<Contestant>> contestants;
+    tree.fetch_data(contestants);
+
+    Projection field;
+    field.gather(contestants);
+    do{
+        int displayed{}, finished{};
+        cout << "\nEnter the elapsed time since the start of the races (minutes)." << endl;
+        int time_from_start{read_int()};
+
+        vector<float> completion;
+        field.project(time_from_start, completion);
+        for (int i{}; i < field.size(); ++i){
+            //only contestants who have checked in have a distance to complete
+            const auto &contestant{field.contestant(i)};
+            if (contestant -> is_status(Status::REGISTERED) || contestant -> is_status(Status::PRE_REGISTERED)
+            || contestant -> is_status(Status::DISQUALIFIED))
+                continue;
+            ++displayed;
+            if (completion[i] >= 100){
+                ++finished;
+                cout << "\n" << contestant -> get_name() << " will have finished.";
+            }
+            else if (completion[i] > 0)
+                cout << "\n" << contestant -> get_name() << " will be " << completion[i] << "% complete.";
+        }
+        cout << "\n\n" << finished << " of " << displayed << " checked in contestants will have finished after "
+             << time_from_start << " minutes." << endl;
+
+        cout << "\nEstimate ";
+    } while (again());
+}
+
+//show the leaders by projected finish and look up anyone's place
+void Menu::view_leaderboard()
+{
+    cout << "\nLeaderboard." << endl;
+    do{
+        cout << "\n" << leaderboard.size() << " contestants are checked in, racing or finished."
+             << "\nHow many leaders to view?" << endl;
+        int k{read_int()};
+
+        vector<Standing> leaders;
+        vector<shared_ptr<Contestant>> contestants;
+        int shown{leaderboard.top(k, leaders, contestants)};
+        for (int i{}; i < shown; ++i)
+            cout << "\n" << setw(4) << i + 1 << ". " << left << setw(30) << leaders[i].name << right
+                 << " projected to finish in " << leaders[i].finish << " minutes.";
+        cout << endl;
+
+        string name;
+        cout << "\nEnter a contestant's name to find their place (blank to skip).\n>";
+        getline(cin, name);
+        if (name != ""){
+            if (int place{leaderboard.position(name)})
+                cout << "\n" << name << " is in place " << place << " of " << leaderboard.size() << "." << endl;
+            else
+                cout << "\n" << name << " is not on the leaderboard." << endl;
+        }
+
+        cout << "\nView ";
+    } while (again());
+}
+
+//resolve bib numbers (what the timing mats report) to contestants
+void Menu::find_bib()
+{
+    cout << "\nFind half marathoner(s) by bib number." << endl;
+    do{
+        cout << "\nEnter a bib number." << endl;
+        int number{read_int()};
+        if (auto runner{bibs.find_ptr(number)})
+            cout << "\n" << **runner;
+        else
+            cout << "\nNo runner is wearing bib " << number << "." << endl;
+
+        cout << "\nSearch ";
+    } while (again());
+}
+
+//re-key a contestant under a corrected name
+//the node is extracted and put back, the contestant is never copied
+void Menu::correct_name()
+{
+    cout << "\nCorrect contestant name(s)." << endl;
+    do{
+        string name, corrected;
+        cout << "\nEnter the contestant's name as registered.\n>";
+        getline(cin, name);
+        cout << "\nEnter the corrected name.\n>";
+        getline(cin, corrected);
+
+        if (!tree.find(name))
+            cout << "\n" << name << " is not registered." << endl;
+        else if (tree.find(corrected))
+            cout << "\n" << corrected << " is already registered." << endl;
+        else{
+            withdraw(name);
+            auto handle{tree.extract(name)};
+            handle.key() = corrected;
+            handle.data() -> set_name(corrected);
+            tree.insert(move(handle));
+            enroll(corrected);
+            refresh(corrected);
+            cout << "\n" << name << " is now registered as " << corrected << "." << endl;
+        }
+
+        cout << "\nCorrect ";
+    } while (again());
+}
+
+//apply a stream of timing events (check in, start, split, finish)
+void Menu::ingest()
+{
+    string source;
+    cout << "\nEnter the event file, named pipe or Unix socket (- for standard input).\n>";
+    getline(cin, source);
+
+    long unknown{};
+    Pipeline pipeline;
+    auto began{chrono::steady_clock::now()};
+    long applied{};
+    try{
+        applied = ingest(pipeline, source, unknown);
+    }
+    catch (PIPELINE_ERROR::no_source_exception &error){
+        cout << error.msg;
+        return;
+    }
+    chrono::duration<double> elapsed{chrono::steady_clock::now() - began};
+
+    cout << "\n" << pipeline.events_read() << " events read in " << pipeline.batches() << " batches, "
+         << applied << " applied, " << unknown << " for unregistered names, "
+         << pipeline.events_rejected() << " unreadable lines."
+         << "\n" << elapsed.count() << " seconds (" << pipeline.events_read() / max(elapsed.count(), 1e-9)
+         << " events/s)." << endl;
+}
+
+//report what the registry and its indexes cost in memory
+void Menu::footprint()
+{
+    footprint(cout);
+}
+
+//counts, average speed and fastest cyclist for an alphabetical block of the field
+//every subtree of the registry keeps its Field_Stats, so any block adds up in O(log n)
+void Menu::field_stats()
+{
+    cout << "\nField statistics for the names from one name up to (not including) another."
+         << "\nLeave a name blank to go from the first or to the last name." << endl;
+    do{
+        string low, high;
+        cout << "\nFrom\n>";
+        getline(cin, low);
+        cout << "\nUp to\n>";
+        getline(cin, high);
+        //no UTF-8 name starts with a byte this high, so it is past the last name
+        if (high == "")
+            high = string(1, '\xff');
+
+        Field_Summary block{tree.aggregate(low, high)};
+        cout << "\n" << block.contestants << " contestants, " << block.racing << " racing, "
+             << block.finished << " finished, " << block.disqualified << " disqualified."
+             << "\nAverage speed " << block.average_speed() << " km/h." << endl;
+        if (block.fastest)
+            cout << "Fastest cyclist " << block.fastest -> get_name() << " at " << block.fastest_cyclist << " km/h." << endl;
+        else
+            cout << "No cyclists." << endl;
+
+        cout << "\nView more statistics ";
+    } while (again());
+}
+
+//freeze the registry's names into the roster, name lookups read it from now on
+//until someone registers or is removed
+void Menu::close_registration()
+{
+    if (!tree.size()){
+        cout << "\nNo contestants are registered yet." << endl;
+        return;
+    }
+    roster = freeze(tree);
+
+    Memory nodes, keys, unused, index, text;
+    tree.account(nodes, keys, unused);
+    roster.account(index, text, unused);
+    long before{nodes.allocated + keys.allocated}, after{index.allocated + text.allocated};
+    cout << "\nRegistration is closed, " << roster.size() << " names are frozen."
+         << "\nThe name index takes " << after << " bytes instead of " << before << " ("
+         << static_cast<double>(before) / max(after, 1L) << "x smaller)."
+         << "\nRegistering or removing a contestant opens registration again." << endl;
+}
+
+//copy every contestant into an archive of past events, under "<EVENT>/<NAME>"
+void Menu::archive()
+{
+    string file, event;
+    cout << "\nEnter the archive file (it is made if it does not exist).\n>";
+    getline(cin, file);
+    cout << "\nEnter a name for this event (for example 2026 Fall Classic).\n>";
+    getline(cin, event);
+
+    auto began{chrono::steady_clock::now()};
+    try{
+        int archived{archive(file, event)};
+        auto elapsed{chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - began)};
+        cout << "\n" << archived << " contestants were archived under \"" << event << "\" in "
+             << elapsed.count() << " ms." << endl;
+    }
+    catch (DISK_ERROR::open_exception &error){
+        cout << error.msg;
+    }
+    catch (DISK_ERROR::corrupt_exception &error){
+        cout << error.msg;
+    }
+    catch (DISK_ERROR::record_exception &error){
+        cout << error.msg;
+    }
+    catch (DISK_ERROR::write_exception &error){
+        cout << error.msg;
+    }
+}
+
+//archive the registry as 'event' in 'file', a contestant already there is written over
+//returns the number archived
+int Menu::archive(const string &file, const string &event)
+{
+    Disk_Tree<shared_ptr<Contestant>> past(file);
+    int archived{};
+    tree.for_each([&past, &event, &archived](const string &name, const shared_ptr<Contestant> &contestant){
+        past.assign(event + EVENT_SEPARATOR + name, contestant);
+        ++archived;
+    });
+    past.close();
+    return archived;
+}
+
+//look contestants of past events up in an archive, reading only the pages needed
+void Menu::search_archive()
+{
+    string file;
+    cout << "\nEnter the archive file.\n>";
+    getline(cin, file);
+    try{
+        Disk_Tree<shared_ptr<Contestant>> past(file);
+        cout << "\nThe archive holds " << past.size() << " contestants in " << past.pages() << " pages." << endl;
+        do{
+            string key;
+            cout << "\nEnter an event and name as <EVENT>" << EVENT_SEPARATOR
+                 << "<NAME>, or the start of one (an event lists its field).\n>";
+            getline(cin, key);
+            if (auto contestant{past.lookup(key)})
+                cout << "\n" << **contestant;
+            else{
+                vector<string> keys;
+                vector<shared_ptr<Contestant>> contestants;
+                int shown{past.prefix_search(key, COMPLETIONS, keys, contestants)};
+                if (!shown)
+                    cout << "\nNothing in the archive starts with \"" << key << "\"." << endl;
+                else
+                    cout << endl;
+                for (const auto &found : keys)
+                    cout << "    " << found << endl;
+                if (shown == COMPLETIONS)
+                    cout << "    ..." << endl;
+            }
+
+            cout << "\nSearch ";
+        } while (again());
+    }
+    catch (DISK_ERROR::open_exception &error){
+        cout << error.msg;
+    }
+    catch (DISK_ERROR::corrupt_exception &error){
+        cout << error.msg;
+    }
+}
+
+//run 'source' through 'pipeline'
+//each contestant is looked up, refreshed and journaled once per batch,
+//the lookups of a batch walk the tree together (find_many)
+//events for names that are not registered are counted in 'unknown'
+long Menu::ingest(Pipeline &pipeline, const string &source, long &unknown)
+{
+    vector<string> names;
+    vector<shared_ptr<Contestant>*> found;
+    auto apply = [this, &unknown, &names, &found](const vector<Run> &runs){
+        names.clear();
+        for (const auto &run : runs)
+            names.emplace_back(run.name);
+        tree.find_many(names, found);
+
+        long applied{};
+        for (size_t i{}; i < runs.size(); ++i){
+            if (!found[i]){
+                unknown += runs[i].count;
+                continue;
+            }
+            int done{};
+            bool changed{}, any{};
+            for (int j{}; j < runs[i].count; ++j){
+                done += Pipeline::apply(**found[i], runs[i].events[j], changed);
+                any |= changed;
+            }
+            if (any)
+                refresh(names[i]);
+            applied += done;
+        }
+        return applied;
+    };
+    return pipeline.run(source, apply);
+}
+
 //check in multiple contestants
 void Menu::check_in()
 {
@@ -398,15 +775,22 @@ void Menu::check(const string &name)
     char choice{};
     if (tree.find(name)){
         cout << "\n" << name << " is registered." << endl;
-        if (tree[name] -> is_status("CHECKED IN"))
+        if (tree[name] -> is_status(Status::CHECKED_IN))
             cout << "\n" << name << " was already checked in." << "\n" << endl;
-        else if (tree[name] -> check_in()){
-            cout << "\n" << name << " has been checked in." << "\n" << endl;
-            cout << *tree[name];
+        else{
+            //a failed check in can still change the contestant (a cyclist without a waiver is disqualified)
+            bool checked_in{tree[name] -> check_in()};
+            refresh(name);
+            if (checked_in){
+                cout << "\n" << name << " has been checked in." << "\n" << endl;
+                cout << *tree[name];
+            }
         }
     }
     else{
-        cout << "\n" << name << " is not registered. Would you like to register them? (y/n)\n>";
+        cout << "\n" << name << " is not registered." << endl;
+        suggest(name);
+        cout << "\nWould you like to register them? (y/n)\n>";
         cin >> choice;
         cin.ignore(100, '\n');
         if (toupper(choice) == 'Y')
@@ -414,14 +798,112 @@ void Menu::check(const string &name)
     }
 }
 
+//register a contestant of 'type' built from the rest of a roster row
+//false if the type is unknown or the name is taken, nothing is overwritten
+bool Menu::admit(int type, string &name, istream &row)
+{
+    shared_ptr<Contestant> contestant;
+    switch (type){
+        case 1:
+            contestant = make_shared<Walking_Contestant>(name, row);
+            break;
+        case 2:
+            contestant = make_shared<Bicycle_Contestant>(name, row);
+            break;
+        case 3:
+            contestant = make_shared<Half_Marathon_Contestant>(name, row);
+            break;
+        default:
+            return false;
+    }
+    if (name == "" || !tree.try_insert(name, contestant).second)
+        return false;
+    enroll(name);
+    refresh(name);
+    return true;
+}
+
+//put a contestant back on the leaderboard and into the field stats
+//after their state changed, and log their new state
+void Menu::refresh(const string &name)
+{
+    ++changes;
+    tree.update(name);
+    leaderboard.update(name, tree[name]);
+    journal.put(tree[name]);
+    journal.commit();
+}
+
+//index a contestant who was just put in the tree
+//every name is indexed for suggestions, half marathoners also get a unique bib,
+//redrawn if the number is taken
+void Menu::enroll(const string &name)
+{
+    ++churned;
+    roster.clear();
+    spellings.insert(name);
+    auto hm_ptr{dynamic_pointer_cast<Half_Marathon_Contestant>(tree[name])};
+    if (!hm_ptr || hm_ptr -> get_racer_number() == 0)
+        return;
+
+    int number{hm_ptr -> get_racer_number()};
+    if (bibs.find(number)){
+        int drawn{number};
+        //walk forward from a random bib to the first free one
+        //past 999 numbers are handed out above the range
+        number = rand() % 999 + 1;
+        for (int tries{}; bibs.find(number) && tries < 999; ++tries)
+            number = number % 999 + 1;
+        if (bibs.find(number))
+            number = 1000 + bibs.size();
+        //roster bibs can be above 999 too
+        while (bibs.find(number))
+            ++number;
+        hm_ptr -> set_racer_number(number);
+        cout << "\nBib " << drawn << " is already taken, " << name << " was given bib " << number << "." << endl;
+    }
+    bibs.insert(number, hm_ptr);
+}
+
+//take a contestant who is about to leave the tree out of the other indexes
+void Menu::withdraw(const string &name)
+{
+    auto contestant{tree.find_ptr(name)};
+    if (!contestant)
+        return;
+    ++changes;
+    ++churned;
+    roster.clear();
+    leaderboard.remove(name);
+    spellings.remove(name);
+    journal.erase(name);
+    journal.commit();
+
+    auto hm_ptr{dynamic_pointer_cast<Half_Marathon_Contestant>(*contestant)};
+    if (!hm_ptr)
+        return;
+    auto wearing{bibs.find_ptr(hm_ptr -> get_racer_number())};
+    if (wearing && *wearing == *contestant)
+        bibs.remove(hm_ptr -> get_racer_number());
+}
+
+//list the registered names closest to a mistyped one, if any are close
+void Menu::suggest(const string &name)
+{
+    vector<string> names;
+    vector<int> distances;
+    if (!spellings.search(name, SUGGESTIONS, names, distances))
+        return;
+    cout << "\nDid you mean ";
+    for (size_t i{}; i < names.size(); ++i)
+        cout << (i ? (i + 1 < names.size() ? ", " : " or ") : "") << names[i];
+    cout << "?" << endl;
+}
+
 //start a particular race
-//retrieve them all from the tree into a vector
-//then, loop through and
 //use RTTI to find correct contestants and mark them as started.
 void Menu::start_race()
 {
-    vector<shared_ptr<Contestant>> contestants;
-    tree.fetch_data(contestants);
     cout << "\nStart race(s)." << endl;
     do{
         int choice{};
@@ -432,39 +914,21 @@ void Menu::start_race()
 
         switch (choice){
             case 1:
-                    if (!walking){
-                        walking = true;
-                        for (auto &item : contestants){
-                            if (auto w_ptr{dynamic_pointer_cast<Walking_Contestant>(item)})
-                                w_ptr -> start();
-                        }
+                    if (start(1))
                         cout << "\nWalking Race started!" << endl;
-                    }
                     else
                         cout << "\nThe walking race has already started." << endl;
                 break;
             case 2:
-                    if (!cycling){
-                        cycling = true;
-                        for (auto &item : contestants){
-                            if (auto b_ptr{dynamic_pointer_cast<Bicycle_Contestant>(item)})
-                                b_ptr -> start();
-                        }
+                    if (start(2))
                         cout << "\nCycling Race started!" << endl;
-                    }
                     else
                         cout << "\nThe cycling race has already started." << endl;
                 break;
 
             case 3:
-                    if (!running){
-                        running = true;
-                        for (auto &item : contestants){
-                            if (auto hm_ptr{dynamic_pointer_cast<Half_Marathon_Contestant>(item)})
-                                hm_ptr -> start();
-                        }
+                    if (start(3))
                         cout << "\nHalf Marathon started!" << endl;
-                    }
                     else
                         cout << "\nThe half marathon has already started." << endl;
                 break;
@@ -476,6 +940,58 @@ void Menu::start_race()
     } while (again() && (!cycling || !walking || !running));
 }
 
+//start one race: 1 walking, 2 cycling, 3 half marathon
+//retrieve them all from the tree into a vector, then start the ones in that race
+//returns false if the race has already started
+bool Menu::start(int race)
+{
+    vector<shared_ptr<Contestant>> contestants;
+    switch (race){
+        case 1:
+                if (walking)
+                    return false;
+                walking = true;
+                journal.race(walking, cycling, running);
+                tree.fetch_data(contestants);
+                for (auto &item : contestants){
+                    if (auto w_ptr{dynamic_pointer_cast<Walking_Contestant>(item)}){
+                        w_ptr -> start();
+                        refresh(item -> get_name());
+                    }
+                }
+            break;
+        case 2:
+                if (cycling)
+                    return false;
+                cycling = true;
+                journal.race(walking, cycling, running);
+                tree.fetch_data(contestants);
+                for (auto &item : contestants){
+                    if (auto b_ptr{dynamic_pointer_cast<Bicycle_Contestant>(item)}){
+                        b_ptr -> start();
+                        refresh(item -> get_name());
+                    }
+                }
+            break;
+        case 3:
+                if (running)
+                    return false;
+                running = true;
+                journal.race(walking, cycling, running);
+                tree.fetch_data(contestants);
+                for (auto &item : contestants){
+                    if (auto hm_ptr{dynamic_pointer_cast<Half_Marathon_Contestant>(item)}){
+                        hm_ptr -> start();
+                        refresh(item -> get_name());
+                    }
+                }
+            break;
+        default:
+            return false;
+    }
+    return true;
+}
+
 //disqualify contestant(s)
 void Menu::disqualify()
 {
@@ -486,15 +1002,18 @@ void Menu::disqualify()
         getline(cin, name);
         if (tree.find(name)){
             cout << "\n" << name << " is registered." << endl;
-            if (tree[name] -> is_status("DISQUALIFIED"))
+            if (tree[name] -> is_status(Status::DISQUALIFIED))
                 cout << "\n" << name << " was already disqualified." << "\n" << endl;
             else if (tree[name] -> disqualify()){
+                refresh(name);
                 cout << "\n" << name << " has been disqualified." << "\n" << endl;
                 cout << *tree[name];
             }
         }
-        else
+        else{
             cout << "\n" << name << " is not registered." << endl;
+            suggest(name);
+        }
 
     cout << "\nDisqualify ";
     } while (again());
@@ -503,14 +1022,32 @@ void Menu::disqualify()
 
 //call the display tree graphical method of the BST
 //use to verify the tree is balanced
+//large trees can be limited to a few levels, or to the subtree around one contestant
 void Menu::graphical_tree()
 {
-    cout << tree;
+    //no color escapes when the output is redirected to a file or pipe
+    bool ansi{isatty(STDOUT_FILENO) != 0};
+
+    cout << "\nHow many levels should be displayed? (0 for all)" << endl;
+    int depth{read_int()};
+    if (depth <= 0)
+        depth = -1;
+
+    string name;
+    cout << "\nEnter a contestant's name to display the tree around them (blank for the whole tree).\n>";
+    getline(cin, name);
+
+    cout << "\nThe Tree:\n\n";
+    if (name == "")
+        tree.render(cout, depth, ansi);
+    else
+        tree.render(cout, name, depth, ansi);
+    cout << endl;
 }
 
 void Menu::test_copying()
 {
-    Red_Black<string, shared_ptr<Contestant>> new_copy;
+    Red_Black<string, shared_ptr<Contestant>, Field_Stats> new_copy;
     new_copy = tree;
     cout << "\nThis is the new after copying:\n" << new_copy;
     sleep(2);
@@ -540,6 +1077,7 @@ void Menu::animate()
 
              << "\n\n1. Insertion."
              << "\n2. Removal."
+             << "\n3. Play a saved trace."
              << "\n>";
         choice = read_int();
         switch (choice){
@@ -549,6 +1087,9 @@ void Menu::animate()
             case 2:
                 animate_removal();
                 break;
+            case 3:
+                animate_saved();
+                break;
             default:
                 break;
         }
@@ -557,13 +1098,20 @@ void Menu::animate()
 
 
 //load a file and create an "animation" of the insertion process.
+//the load is traced at full speed and played back afterwards
 void Menu::animate_load()
 {
-    int items{tree.size()};
     int num_loaded{};
+    Trace<string> recording;
     tree.remove_all();
-    cout << "\nBeginning animation of tree insertion. There are " << items << " items in the tree.\n"
-         << "This \"animation\" should take roughly " << items * 2 << " seconds to complete." << endl;
+    leaderboard.remove_all();
+    bibs.remove_all();
+    spellings.clear();
+    roster.clear();
+    journal.clear();
+    ++changes;
+    tree.trace(&recording);
+    cout << "\nRecording tree insertion..." << endl;
     //throw exception if file not opened
     filein.open(filename);
     if (!filein)
@@ -585,18 +1133,24 @@ void Menu::animate_load()
                 case 1: {
                             auto walk_ptr{make_shared<Walking_Contestant>(name, filein)};
                             num_loaded += tree.insert(name, move(walk_ptr));
+                            enroll(name);
+                            refresh(name);
                         }
                     break;
 
                 case 2: {
                             auto b_ptr{make_shared<Bicycle_Contestant>(name, filein)};
                             num_loaded += tree.insert(name, move(b_ptr));
+                            enroll(name);
+                            refresh(name);
                         }
                     break;
 
                 case 3: {
                             auto hm_ptr{make_shared<Half_Marathon_Contestant>(name, filein)};
                             num_loaded += tree.insert(name, move(hm_ptr));
+                            enroll(name);
+                            refresh(name);
                         }
                     break;
 
@@ -608,12 +1162,12 @@ void Menu::animate_load()
         catch (TREE_ERROR::duplicate_name_exception &error){
             cout << error.msg << "Skipping...." << endl;
         }
-
-        cout << "\033[2J\033[1;1H" << endl;
-        cout << "Put #" << num_loaded << "/" << items << "\n" << tree;
-        sleep(1);
     }
     filein.close();
+    tree.trace(nullptr);
+
+    cout << num_loaded << " contestants inserted." << endl;
+    play(recording);
 }
 
 void Menu::animate_removal()
@@ -624,21 +1178,146 @@ void Menu::animate_removal()
         int original_size{tree.size()};
         int removed{1};
         vector<string> keys{};
+        Trace<string> recording;
         tree.fetch_keys(keys);
+        tree.trace(&recording);
+        cout << "\nRecording tree removal..." << endl;
         while (removed <= original_size){
-            string to_remove{keys[rand() % keys.size()]};
-            cout << "\033[2J\033[1;1H" << endl;
-            cout << "Removal #" << removed << "/" << original_size << "\n"
-                 << "Removing: " << to_remove << "\n" << tree;
+            //swap the pick with the last key and pop it, erasing from the middle is O(n) each time
+            size_t pick{rand() % keys.size()};
+            string to_remove{move(keys[pick])};
+            keys[pick] = move(keys.back());
+            keys.pop_back();
             ++removed;
-            sleep(1);
+            withdraw(to_remove);
             tree.remove(to_remove);
-            keys.erase(find(keys.begin(), keys.end(), to_remove));
         }
+        tree.trace(nullptr);
+
+        cout << original_size << " contestants removed." << endl;
+        play(recording);
     }
 
 }
 
+//play a trace exported by an earlier animation
+void Menu::animate_saved()
+{
+    string trace_file;
+    Trace<string> recording;
+    cout << "\nEnter the name of the trace file.\n>";
+    getline(cin, trace_file);
+    if (!recording.load(trace_file))
+        cout << "\n" << trace_file << " is not a trace file." << endl;
+    else
+        play(recording, false);
+}
+
+//ask for a frame rate and play 'recording'
+//offers to export it afterwards unless it came from a file
+void Menu::play(const Trace<string> &recording, bool offer_export)
+{
+    cout << "\nHow many frames per second? (0 for as fast as possible)" << endl;
+    int fps{read_int()};
+
+    Animation<string> animation(recording);
+    int frames{animation.play(cout, fps, isatty(STDOUT_FILENO) != 0)};
+    cout << "\n" << frames << " frames played." << endl;
+
+    if (!offer_export)
+        return;
+    string trace_file;
+    cout << "\nEnter a file name to export the trace (blank to skip).\n>";
+    getline(cin, trace_file);
+    if (trace_file != ""){
+        if (recording.save(trace_file))
+            cout << "\nTrace saved to " << trace_file << "." << endl;
+        else
+            cout << "\nCould not write " << trace_file << "." << endl;
+    }
+}
+
+//recover the registry from a journal and keep logging to it
+//the indexes are rebuilt from the recovered contestants and a fresh snapshot is taken
+void Menu::open_journal(const string &filename)
+{
+    auto began{chrono::steady_clock::now()};
+    int replayed{};
+    try{
+        replayed = journal.open(filename, tree, walking, cycling, running);
+    }
+    catch (JOURNAL_ERROR::open_exception &error){
+        cout << error.msg << "Continuing without a journal." << endl;
+        return;
+    }
+
+    vector<string> names;
+    tree.fetch_keys(names);
+    for (const auto &name : names){
+        enroll(name);
+        refresh(name);
+    }
+    journal.compact(tree, walking, cycling, running);
+
+    auto elapsed{chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - began)};
+    cout << "\nRecovered " << tree.size() << " contestants from " << replayed << " journal records in "
+         << elapsed.count() << " ms." << endl;
+}
+
+//publish the registry to the shared memory segment '/name' for local readers
+void Menu::open_snapshot(const string &name)
+{
+    try{
+        snapshot.open(name);
+    }
+    catch (SNAPSHOT_ERROR::segment_exception &error){
+        cout << error.msg << "Continuing without a snapshot." << endl;
+        return;
+    }
+    published_changes = -1;
+    checkpoint();
+}
+
+//make every change so far durable and visible to snapshot readers
+//false if the journal could not be written, its records are kept for the next checkpoint
+bool Menu::checkpoint()
+{
+    const bool durable{sync_journal()};
+    if (!snapshot.is_open() || changes == published_changes)
+        return durable;
+    try{
+        snapshot.publish(tree, leaderboard);
+        published_changes = changes;
+    }
+    catch (SNAPSHOT_ERROR::segment_exception &error){
+        cout << error.msg << "Readers keep the last snapshot." << endl;
+    }
+    return durable;
+}
+
+//the O(n) upkeep, for when nothing is waiting (between menu actions, an idle server wake):
+//the journal is compacted once it grows long enough, which bounds recovery time,
+//and the registry's nodes are laid out together again once enough of them have come and gone
+void Menu::compact_if_due()
+{
+    if (journal.size() >= COMPACT_AFTER && sync_journal())
+        journal.compact(tree, walking, cycling, running);
+    if (churned && churned * RELAYOUT_FRACTION >= tree.size()){
+        tree.compact();
+        churned = 0;
+    }
+}
+
+//make the journal's buffered records durable, the first failure of a run is reported
+bool Menu::sync_journal()
+{
+    const bool durable{journal.sync()};
+    if (!durable && !unsynced)
+        cerr << JOURNAL_ERROR::write_exception().msg;
+    unsynced = !durable;
+    return durable;
+}
+
 //reads an int in and return it
 const int Menu::read_int()
 {
@@ -669,3 +1348,59 @@ bool Menu::again()
     return false;
 }
 
+//bytes per contestant across the registry tree, the contestants and the indexes
+//requested is what was asked of the allocator, allocated is what it used
+void Menu::footprint(ostream &out)
+{
+    const long contestants{tree.size()};
+    Memory nodes, keys, held;
+    tree.account(nodes, keys, held);
+
+    vector<shared_ptr<Contestant>> field;
+    tree.fetch_data(field);
+    Memory by_type[3];
+    long counts[3]{};
+    account_by_type(field, by_type, counts);
+
+    Memory board_nodes, board_keys;
+    leaderboard.account(board_nodes, board_keys);
+
+    Memory bib_nodes, unused;
+    bibs.account(bib_nodes, unused, unused);
+
+    Memory profiles;
+    Profile_Store::shared().account(profiles);
+
+    Memory spelling;
+    spellings.account(spelling);
+
+    //the roster's DATA are the registry's contestants, already counted
+    Memory frozen;
+    roster.account(frozen, frozen, unused);
+
+    Memory total;
+    for (const Memory *part : {&nodes, &keys, &held, &board_nodes, &board_keys, &bib_nodes, &profiles, &spelling, &frozen})
+        total += *part;
+
+    out << "\nMemory footprint of " << contestants << " contestants (bytes).\n\n";
+    print_usage_header(out, "per entry");
+    print_usage(out, "registry nodes", nodes, contestants);
+    print_usage(out, "registry name keys", keys, contestants);
+    print_usage(out, "contestants", held, contestants);
+    print_usage(out, "   walking", by_type[0], counts[0]);
+    print_usage(out, "   cycling", by_type[1], counts[1]);
+    print_usage(out, "   half marathon", by_type[2], counts[2]);
+    print_usage(out, "leaderboard nodes", board_nodes, leaderboard.size());
+    print_usage(out, "leaderboard keys", board_keys, leaderboard.size());
+    print_usage(out, "bib index nodes", bib_nodes, bibs.size());
+    print_usage(out, "profile store", profiles, Profile_Store::shared().size());
+    print_usage(out, "name trigram index", spelling, spellings.size());
+    print_usage(out, "frozen roster", frozen, roster.size());
+    print_usage(out, "total", total, contestants);
+
+    out << "\nstrings: " << total.inline_strings << " inline, " << total.heap_strings << " on the heap"
+        << "\nsizeof: node " << sizeof(Node<string, shared_ptr<Contestant>, Field_Stats>) << ", string " << sizeof(string)
+        << ", shared_ptr " << sizeof(shared_ptr<Contestant>) << ", control block " << SHARED_CONTROL
+        << ", walking " << sizeof(Walking_Contestant) << ", cycling " << sizeof(Bicycle_Contestant)
+        << ", half marathon " << sizeof(Half_Marathon_Contestant) << endl;
+}
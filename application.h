@@ -14,6 +14,15 @@
  *       void hydrate_runner();
  *       void unregister();
  *       void estimate_completion();
+ *       void estimate_field();
+ *       void view_leaderboard();
+ *       void find_bib();
+ *       void correct_name();
+ *       void ingest();
+ *       void footprint();
+ *       void close_registration();
+ *       void archive();
+ *       void search_archive();
  *       void check_in();
  *       void start_race();
  *       void disqualify();
@@ -22,11 +31,31 @@
  *       void animate();
  *       void animate_load();
  *       void animate_removal();
+ *       void animate_saved();
+ *       void open_journal(const std::string &filename);
+ *       void open_snapshot(const std::string &name);
+ *       bool checkpoint();
+ *       void compact_if_due();
  *********************************************************************
  */
+
+#ifndef APPLICATION
+#define APPLICATION
+
 #include <unistd.h>
 #include "structures.h"
 #include "core.h"
+#include "projection.h"
+#include "leaderboard.h"
+#include "animation.h"
+#include "journal.h"
+#include "pipeline.h"
+#include "snapshot.h"
+#include "fuzzy.h"
+#include "stats.h"
+#include "frozen.h"
+#include "disk.h"
+#include "flat.h"
 
 //exceptions related to the application
 struct APPLICATION_ERROR
@@ -52,7 +81,18 @@ class Menu
         void find_contestant();
         void hydrate_runner();
         void unregister();
+        void purge();
         void estimate_completion();
+        void estimate_field();
+        void view_leaderboard();
+        void find_bib();
+        void correct_name();
+        void ingest();
+        void footprint();
+        void field_stats();
+        void close_registration();
+        void archive();
+        void search_archive();
         void check_in();
         void start_race();
         void disqualify();
@@ -61,25 +101,86 @@ class Menu
         void animate();
         void animate_load();
         void animate_removal();
+        void animate_saved();
+        void open_journal(const std::string &filename);
+        void open_snapshot(const std::string &name);
+        bool checkpoint();
+        void compact_if_due();
         const int read_int();
         bool again();
 
     protected:
+        //sync the journal, reporting the first failure of a run (see checkpoint)
+        bool sync_journal();
+
         //instantiation of the Red_Black tree template using
         //a string key (name) and a Contestant smart pointer.
         //use dynamic_pointer_cast on shared_ptr when downcasting
-        Red_Black<std::string, std::shared_ptr<Contestant>> tree;
+        Red_Black<std::string, std::shared_ptr<Contestant>, Field_Stats> tree;
+
+        //contestants ordered by projected finish, kept in step with 'tree'
+        Leaderboard leaderboard;
+
+        //half marathoners by bib number, numbers are unique
+        Tree_For<int, std::shared_ptr<Contestant>> bibs;
+
+        //every registered name by trigram, for suggesting names when one is mistyped
+        Fuzzy_Index spellings;
+        static const int SUGGESTIONS{5};
 
         //markers for if these races have started aready
         bool cycling{}, walking{}, running {};
 
+        //every change to the registry is logged here when a journal is open
+        //it is compacted into a snapshot once it holds this many records (see compact_if_due)
+        Journal journal;
+        static const int COMPACT_AFTER{10000};
+
+        //a failed journal write is reported once, until a checkpoint gets through again
+        bool unsynced{};
+
+        //the registry is compacted (Red_Black::compact) by compact_if_due once the contestants
+        //added and removed since the last time reach 1 / RELAYOUT_FRACTION of it
+        long churned{};
+        static const int RELAYOUT_FRACTION{4};
+
+        //the registry's names front coded into one read-only block once registration
+        //closes (see Frozen), name lookups read it instead of the tree. Registering or
+        //removing anyone clears it, which opens registration again
+        Frozen<std::shared_ptr<Contestant>> roster;
+
+        //archived contestants are keyed "<EVENT>/<NAME>", so an event is one range
+        static const char EVENT_SEPARATOR{'/'};
+
+        //names find_contestant lists for a partial name
+        static const int COMPLETIONS{10};
+
+        //the registry is republished to shared memory at a checkpoint
+        //when it has changed since the last publish
+        Snapshot_Publisher snapshot;
+        long changes{};
+        long published_changes{-1};
+
         //for reading in from a file
         std::ifstream filein;
         std::string filename;
 
         //utility functions used by the application interface
         int load();
+        int load(const std::string &roster);
         bool reg();
+        bool admit(int type, std::string &name, std::istream &row);
+        bool start(int race);
+        long ingest(Pipeline &pipeline, const std::string &source, long &unknown);
         void check(const std::string &name);
+        void refresh(const std::string &name);
+        void enroll(const std::string &name);
+        void withdraw(const std::string &name);
+        int purge(bool no_shows);
+        int archive(const std::string &file, const std::string &event);
+        void suggest(const std::string &name);
+        void play(const Trace<std::string> &recording, bool offer_export = true);
+        void footprint(std::ostream &out);
 };
 
+#endif
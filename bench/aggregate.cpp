@@ -0,0 +1,109 @@
+/*
+ *********************************************************************
+ * Ian Leuty
+ * inleuty@gmail.com
+ * 10/19/2026
+ *********************************************************************
+ * range aggregate benchmark
+ *********************************************************************
+ * Field statistics over random alphabetical blocks of the registry,
+ * from the Field_Stats kept in every subtree (aggregate) and by
+ * visiting every contestant and adding up the ones in the block. Also
+ * what keeping the augmentation costs: inserting the field into a
+ * plain and an augmented tree, and re-reading changed contestants
+ * (update).
+ *
+ *      usage: bench/aggregate [contestants] [queries] [scanned queries]
+ *********************************************************************
+ */
+
+#include <algorithm>
+#include <random>
+#include "bench.h"
+#include "../stats.h"
+
+using namespace std;
+
+int main(int argc, char *argv[])
+{
+    int count{argc > 1 ? atoi(argv[1]) : 200000};
+    int queries{argc > 2 ? atoi(argv[2]) : 100000};
+    int scanned{argc > 3 ? atoi(argv[3]) : 50};
+
+    vector<shared_ptr<Contestant>> field;
+    make_field(count, field);
+
+    Red_Black<string, shared_ptr<Contestant>> plain;
+    double start{now()};
+    for (const auto &contestant : field)
+        plain.insert(contestant -> get_name(), contestant);
+    double plain_insert{now() - start};
+
+    Red_Black<string, shared_ptr<Contestant>, Field_Stats> tree;
+    start = now();
+    for (const auto &contestant : field)
+        tree.insert(contestant -> get_name(), contestant);
+    double augmented_insert{now() - start};
+
+    //blocks between two registered names, from a few names to most of the field
+    vector<string> sorted;
+    sorted.reserve(count);
+    for (const auto &contestant : field)
+        sorted.push_back(contestant -> get_name());
+    sort(sorted.begin(), sorted.end());
+    mt19937 random(42);
+    vector<pair<string, string>> blocks;
+    for (int i{}; i < queries; ++i){
+        int low(random() % count), high(random() % count);
+        if (low > high)
+            swap(low, high);
+        blocks.emplace_back(sorted[low], sorted[high]);
+    }
+
+    long total{};
+    start = now();
+    for (const auto &[low, high] : blocks)
+        total += tree.aggregate(low, high).contestants;
+    double aggregating{now() - start};
+
+    //the same blocks the slow way, which must add up the same
+    bool right{true};
+    start = now();
+    for (int i{}; i < scanned && i < queries; ++i){
+        const auto &[low, high]{blocks[i]};
+        Field_Summary block{Field_Stats::identity()};
+        tree.for_each([&](const string &name, const shared_ptr<Contestant> &contestant){
+            if (!(name < low) && name < high)
+                block = Field_Stats::combine(block, Field_Stats::of(name, contestant));
+        });
+        Field_Summary fast{tree.aggregate(low, high)};
+        right = right && fast.contestants == block.contestants && fast.finished == block.finished
+                && fast.fastest == block.fastest && abs(fast.speed - block.speed) < 1e-6 * (1 + block.speed);
+    }
+    double scanning{now() - start};
+
+    //disqualify every tenth contestant in place and re-read them
+    int updates{};
+    start = now();
+    for (int i{}; i < count; i += 10){
+        field[i] -> disqualify();
+        updates += tree.update(field[i] -> get_name());
+    }
+    double updating{now() - start};
+    long disqualified{};
+    for (const auto &contestant : field)
+        disqualified += contestant -> is_status(Status::DISQUALIFIED);
+    right = right && tree.aggregate().disqualified == disqualified;
+
+    cout << "contestants:        " << count << " (node " << sizeof(Node<string, shared_ptr<Contestant>>) << " bytes, "
+         << sizeof(Node<string, shared_ptr<Contestant>, Field_Stats>) << " with Field_Stats)\n"
+         << "insert, plain:      " << plain_insert * 1e9 / count << " ns per contestant\n"
+         << "insert, augmented:  " << augmented_insert * 1e9 / count << " ns per contestant\n"
+         << "aggregate:          " << aggregating * 1e9 / queries << " ns per block, "
+         << static_cast<double>(total) / queries << " contestants each\n"
+         << "visiting everyone:  " << scanning * 1e9 / max(1, min(scanned, queries)) << " ns per block ("
+         << scanning / max(1, min(scanned, queries)) / (aggregating / queries) << "x slower)\n"
+         << "update:             " << updating * 1e9 / max(1, updates) << " ns per contestant\n"
+         << "\nanswers " << (right ? "match" : "DO NOT MATCH") << endl;
+    return right ? 0 : 1;
+}
@@ -0,0 +1,137 @@
+/*
+ *********************************************************************
+ * Ian Leuty
+ * inleuty@gmail.com
+ * 10/19/2026
+ *********************************************************************
+ * archive benchmark
+ *********************************************************************
+ * A season archive in a Disk_Tree: 'events' events of 'contestants'
+ * each, keyed "<EVENT>/<NAME>". Reports how fast it is written (one
+ * commit per event) and how big the file is, then times lookups of
+ * random past contestants and scans of one event's field, each twice:
+ * cold, right after the file is dropped from the page cache, and warm,
+ * the same requests again once the pages they need are in memory.
+ * Resident pages show how little of the file the requests touched.
+ *
+ *      usage: bench/archive [contestants] [events] [lookups] [directory]
+ *********************************************************************
+ */
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <random>
+#include "bench.h"
+#include "../disk.h"
+
+using namespace std;
+
+typedef Disk_Tree<shared_ptr<Contestant>> archive;
+
+//write the file out and drop it from the page cache, it must not be mapped
+static void evict(const string &file)
+{
+    int fd{::open(file.c_str(), O_RDONLY)};
+    if (fd < 0)
+        return;
+    fdatasync(fd);
+    posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+    ::close(fd);
+}
+
+static string event_name(int event)
+{
+    return "Season " + to_string(2000 + event / 4) + " Race " + to_string(event % 4 + 1);
+}
+
+int main(int argc, char *argv[])
+{
+    int count{argc > 1 ? atoi(argv[1]) : 50000};
+    int events{argc > 2 ? atoi(argv[2]) : 20};
+    int queries{argc > 3 ? atoi(argv[3]) : 2000};
+    string directory{argc > 4 ? argv[4] : "/tmp"};
+    string file{directory + "/bench.archive"};
+    std::remove(file.c_str());
+
+    //in name order, the way Menu::archive writes the registry
+    vector<shared_ptr<Contestant>> field;
+    make_field(count, field);
+    sort(field.begin(), field.end(), [](const shared_ptr<Contestant> &a, const shared_ptr<Contestant> &b){
+        return a -> get_name() < b -> get_name();
+    });
+
+    double start{now()};
+    {
+        archive past(file);
+        for (int event{}; event < events; ++event){
+            const string prefix{event_name(event) + "/"};
+            for (const auto &contestant : field)
+                past.insert(prefix + contestant -> get_name(), contestant);
+            past.commit();
+        }
+    }
+    double writing{now() - start};
+    long total{static_cast<long>(count) * events};
+
+    mt19937 random(42);
+    vector<string> wanted(queries);
+    for (auto &key : wanted)
+        key = event_name(random() % events) + "/" + bench_name(random() % count);
+    vector<string> low(queries / 10), high(queries / 10);
+    for (size_t i{}; i < low.size(); ++i){
+        int event(random() % events), first(random() % count);
+        low[i] = event_name(event) + "/" + bench_name(first);
+        high[i] = event_name(event) + "/~";
+    }
+
+    //lookups, then scans of 100 names, each cold and then warm
+    double lookup_time[2]{}, scan_time[2]{};
+    long resident[3]{}, pages{}, found{}, scanned{};
+    int height{};
+    evict(file);
+    {
+        archive past(file);
+        pages = past.pages();
+        height = past.height();
+        resident[0] = past.resident();
+        for (int pass{}; pass < 2; ++pass){
+            start = now();
+            for (const auto &key : wanted)
+                found += past.lookup(key).has_value();
+            lookup_time[pass] = (now() - start) * 1e6 / queries;
+        }
+        resident[1] = past.resident();
+    }
+    evict(file);
+    {
+        archive past(file);
+        vector<string> keys;
+        vector<shared_ptr<Contestant>> contestants;
+        for (int pass{}; pass < 2; ++pass){
+            start = now();
+            for (size_t i{}; i < low.size(); ++i)
+                scanned += past.fetch_range(low[i], high[i], 100, keys, contestants);
+            scan_time[pass] = (now() - start) * 1e6 / max<size_t>(1, low.size());
+        }
+        resident[2] = past.resident();
+    }
+    std::remove(file.c_str());
+
+    bool right{found == 2L * queries};
+    cout << "archived:           " << total << " contestants (" << events << " events of " << count << ")\n"
+         << "written in:         " << writing << " s, " << total / writing << " contestants/s, one commit per event\n"
+         << "file:               " << pages << " pages of " << Pager::PAGE << " bytes ("
+         << pages * Pager::PAGE / 1048576.0 << " MB), " << height << " levels\n"
+         << "resident when cold: " << resident[0] << " pages\n"
+         << "lookups:            " << queries << "\n"
+         << "   cold:            " << lookup_time[0] << " us per lookup\n"
+         << "   warm:            " << lookup_time[1] << " us per lookup\n"
+         << "   resident after:  " << resident[1] << " pages\n"
+         << "scans of 100:       " << low.size() << " (" << scanned / 2 << " contestants each pass)\n"
+         << "   cold:            " << scan_time[0] << " us per scan\n"
+         << "   warm:            " << scan_time[1] << " us per scan\n"
+         << "   resident after:  " << resident[2] << " pages\n"
+         << "\nanswers " << (right ? "match" : "DO NOT MATCH") << endl;
+    return right ? 0 : 1;
+}
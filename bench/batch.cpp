@@ -0,0 +1,81 @@
+/*
+ *********************************************************************
+ * Ian Leuty
+ * inleuty@gmail.com
+ * 10/19/2026
+ *********************************************************************
+ * batched lookup benchmark
+ *********************************************************************
+ * Resolves random names (a share of them misses) one find_ptr at a
+ * time and with find_many in batches of several sizes, on a tree
+ * built in random order so neighbouring nodes are far apart in
+ * memory. Make 'names' large enough that the tree is well past the
+ * last level cache.
+ *
+ *      usage: bench/batch [names] [lookups] [miss percent]
+ *********************************************************************
+ */
+
+#include <algorithm>
+#include <random>
+#include "bench.h"
+#include "../structures.h"
+
+using namespace std;
+
+int main(int argc, char *argv[])
+{
+    int count{argc > 1 ? atoi(argv[1]) : 2000000};
+    int lookups{argc > 2 ? atoi(argv[2]) : 1000000};
+    int miss_percent{argc > 3 ? atoi(argv[3]) : 10};
+
+    mt19937 random(42);
+    vector<int> order(count);
+    for (int i{}; i < count; ++i)
+        order[i] = i;
+    shuffle(order.begin(), order.end(), random);
+
+    Red_Black<string, int> tree;
+    for (int i : order)
+        tree.try_insert(bench_name(i), i);
+
+    vector<string> names;
+    names.reserve(lookups);
+    for (int i{}; i < lookups; ++i){
+        string name{bench_name(random() % count)};
+        if (static_cast<int>(random() % 100) < miss_percent)
+            name += "x";
+        names.push_back(name);
+    }
+
+    //one at a time
+    vector<const int*> single(lookups);
+    double start{now()};
+    for (int i{}; i < lookups; ++i)
+        single[i] = tree.find_ptr(names[i]);
+    double looped{now() - start};
+
+    cout << "names:        " << count << "\n"
+         << "lookups:      " << lookups << " (" << miss_percent << "% misses)\n\n"
+         << "find_ptr loop:          " << looped * 1e9 / lookups << " ns per lookup\n";
+
+    const Red_Black<string, int> &reading{tree};
+    bool right{true};
+    for (int batch : {16, 64, 256, 1024}){
+        vector<string> keys;
+        vector<const int*> found;
+        double spent{};
+        for (int first{}; first < lookups; first += batch){
+            keys.assign(names.begin() + first, names.begin() + min(lookups, first + batch));
+            start = now();
+            reading.find_many(keys, found);
+            spent += now() - start;
+            for (size_t i{}; i < found.size(); ++i)
+                right = right && found[i] == single[first + i];
+        }
+        cout << "find_many, batch " << batch << (batch < 100 ? ":  " : ": ") << (batch < 1000 ? " " : "")
+             << spent * 1e9 / lookups << " ns per lookup (" << looped / spent << "x)\n";
+    }
+    cout << "\nresults " << (right ? "match" : "DO NOT MATCH") << endl;
+    return right ? 0 : 1;
+}
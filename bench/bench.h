@@ -0,0 +1,83 @@
+/*
+ *********************************************************************
+ * Ian Leuty
+ * inleuty@gmail.com
+ * 10/19/2026
+ *********************************************************************
+ * benchmark helpers
+ *********************************************************************
+ * Shared by the programs in bench/. Build them with "make bench".
+ *********************************************************************
+ */
+
+#ifndef BENCH
+#define BENCH
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "../core.h"
+
+//wall clock seconds
+inline double now()
+{
+    using namespace std::chrono;
+    return duration<double>(steady_clock::now().time_since_epoch()).count();
+}
+
+//unique, roster style name for contestant 'i'
+inline std::string bench_name(int i)
+{
+    static const char *first[]{"Sarah", "Michael", "Emily", "James", "Maria", "Lisa", "William", "Jennifer"};
+    static const char *last[]{"Chen", "Brown", "Davis", "Johnson", "Garcia", "Taylor", "Turner", "White"};
+    return std::string(first[i % 8]) + " " + last[(i / 8) % 8] + " " + std::to_string(i);
+}
+
+//roster fields after the name for contestant 'i', whose type is i % 3 + 1
+inline std::string bench_fields(int i)
+{
+    switch (i % 3){
+        case 0:
+            return std::to_string(3 + i % 5) + ",Weather";
+        case 1:
+            return std::to_string(20 + i % 15) + ",Trek Madone";
+        default:
+            return std::to_string(8 + i % 7) + "," + std::to_string(90 + i % 90) + "," + std::to_string(i % 999 + 1);
+    }
+}
+
+//build 'count' contestants of every type, checked in unless 'check_in' is false
+//each one is constructed from a roster line, the same as a loaded roster
+inline void make_field(int count, std::vector<std::shared_ptr<Contestant>> &field, bool check_in = true)
+{
+    field.reserve(count);
+    for (int i{}; i < count; ++i){
+        std::string name{bench_name(i)};
+        std::stringstream line(bench_fields(i)), details;
+        std::shared_ptr<Contestant> contestant;
+        switch (i % 3){
+            case 0:
+                contestant = std::make_shared<Walking_Contestant>(name, line);
+                details << 1 + i % 20 << ",Y";
+                break;
+            case 1:
+                contestant = std::make_shared<Bicycle_Contestant>(name, line);
+                details << 2 + i % 9 << ",Y,555-0100";
+                break;
+            default:
+                contestant = std::make_shared<Half_Marathon_Contestant>(name, line);
+                details << "N," << 20 + i % 81;
+                break;
+        }
+        if (check_in)
+            contestant -> check_in(details);
+        field.push_back(contestant);
+    }
+}
+
+#endif
@@ -0,0 +1,95 @@
+/*
+ *********************************************************************
+ * Ian Leuty
+ * inleuty@gmail.com
+ * 10/19/2026
+ *********************************************************************
+ * flat tree benchmark
+ *********************************************************************
+ * Red_Black<int, int> against Flat_Red_Black<int, int> on the same
+ * random chip ids: inserting them, looking up random ids (half of
+ * them never issued), copying the whole tree, then removing half of
+ * the ids. Reports the memory of each and checks both hold the same.
+ *
+ *      usage: bench/flat [keys] [lookups]
+ *********************************************************************
+ */
+
+#include <random>
+#include "bench.h"
+#include "../flat.h"
+
+using namespace std;
+
+struct Timings
+{
+    double insert{}, lookup{}, copy{}, remove{};
+    long found{};
+    long bytes{};
+    vector<int> kept;
+};
+
+//the same run on either tree, ns per operation except the copy (ms)
+template<typename TREE>
+static Timings run(const vector<int> &ids, const vector<int> &wanted)
+{
+    Timings result;
+    TREE tree;
+    double start{now()};
+    for (int id : ids)
+        tree.insert(id, id / 2);
+    result.insert = (now() - start) * 1e9 / ids.size();
+
+    start = now();
+    for (int id : wanted)
+        result.found += tree.find_ptr(id) != nullptr;
+    result.lookup = (now() - start) * 1e9 / wanted.size();
+
+    start = now();
+    TREE copy{tree};
+    result.copy = (now() - start) * 1e3;
+
+    Memory nodes, unused;
+    copy.account(nodes, unused, unused);
+    result.bytes = nodes.allocated;
+
+    start = now();
+    for (size_t i{}; i < ids.size(); i += 2)
+        tree.remove(ids[i]);
+    result.remove = (now() - start) * 1e9 / (ids.size() / 2);
+
+    tree.fetch_keys(result.kept);
+    return result;
+}
+
+int main(int argc, char *argv[])
+{
+    int count{argc > 1 ? atoi(argv[1]) : 1000000};
+    int queries{argc > 2 ? atoi(argv[2]) : 5000000};
+
+    //distinct ids spread over the whole int range, issued in no order
+    mt19937 random(42);
+    vector<int> ids(count);
+    for (int i{}; i < count; ++i)
+        ids[i] = i * 2048 + static_cast<int>(random() % 2048);
+    shuffle(ids.begin(), ids.end(), random);
+    vector<int> wanted(queries);
+    for (auto &id : wanted)
+        id = random() % 2 ? ids[random() % count] : static_cast<int>(random() % (2048L * count));
+
+    Timings generic{run<Red_Black<int, int>>(ids, wanted)};
+    Timings flat{run<Flat_Red_Black<int, int>>(ids, wanted)};
+
+    bool right{generic.found == flat.found && generic.kept == flat.kept};
+    cout << "keys:                 " << count << " random ints\n"
+         << "                      Red_Black    Flat_Red_Black\n"
+         << "insert:               " << generic.insert << " ns\t" << flat.insert << " ns\n"
+         << "lookup:               " << generic.lookup << " ns\t" << flat.lookup << " ns ("
+         << queries << ", " << generic.found << " found)\n"
+         << "copy:                 " << generic.copy << " ms\t" << flat.copy << " ms\n"
+         << "remove:               " << generic.remove << " ns\t" << flat.remove << " ns\n"
+         << "node memory:          " << static_cast<double>(generic.bytes) / count << " B\t"
+         << static_cast<double>(flat.bytes) / count << " B per key\n"
+         << "\nanswers " << (right ? "match" : "DO NOT MATCH") << endl;
+    return right ? 0 : 1;
+}
@@ -0,0 +1,80 @@
+/*
+ *********************************************************************
+ * Ian Leuty
+ * inleuty@gmail.com
+ * 10/19/2026
+ *********************************************************************
+ * memory footprint benchmark
+ *********************************************************************
+ * Bytes per registrant for a registry of 'contestants' checked in
+ * contestants and the leaderboard that ranks them, broken down into
+ * tree nodes, name keys, the contestants (by type), the cold profile
+ * strings, the name trigram index and allocator overhead. Use it to size hosts and to catch regressions in the
+ * layout of Node or the contestant classes.
+ *
+ *      usage: bench/footprint [contestants]
+ *********************************************************************
+ */
+
+#include "bench.h"
+#include "../leaderboard.h"
+#include "../fuzzy.h"
+#include "../stats.h"
+
+using namespace std;
+
+int main(int argc, char *argv[])
+{
+    int count{argc > 1 ? atoi(argv[1]) : 100000};
+
+    vector<shared_ptr<Contestant>> field;
+    make_field(count, field);
+    Red_Black<string, shared_ptr<Contestant>, Field_Stats> tree;
+    Leaderboard leaderboard;
+    Fuzzy_Index spellings;
+    for (const auto &contestant : field){
+        tree.insert(contestant -> get_name(), contestant);
+        leaderboard.update(contestant -> get_name(), contestant);
+        spellings.insert(contestant -> get_name());
+    }
+
+    Memory nodes, keys, held;
+    double start{now()};
+    tree.account(nodes, keys, held);
+    double taken{now() - start};
+
+    Memory by_type[3];
+    long counts[3]{};
+    account_by_type(field, by_type, counts);
+
+    Memory board_nodes, board_keys;
+    leaderboard.account(board_nodes, board_keys);
+
+    Memory profiles;
+    Profile_Store::shared().account(profiles);
+
+    Memory spelling;
+    spellings.account(spelling);
+
+    Memory total;
+    for (const Memory *part : {&nodes, &keys, &held, &board_nodes, &board_keys, &profiles, &spelling})
+        total += *part;
+
+    cout << "contestants:  " << count << "\n"
+         << "accounting:   " << taken * 1e9 / max(count, 1) << " ns per node\n\n";
+    print_usage_header(cout, "per entry");
+    print_usage(cout, "registry nodes", nodes, count);
+    print_usage(cout, "registry name keys", keys, count);
+    print_usage(cout, "contestants", held, count);
+    print_usage(cout, "   walking", by_type[0], counts[0]);
+    print_usage(cout, "   cycling", by_type[1], counts[1]);
+    print_usage(cout, "   half marathon", by_type[2], counts[2]);
+    print_usage(cout, "leaderboard nodes", board_nodes, leaderboard.size());
+    print_usage(cout, "leaderboard keys", board_keys, leaderboard.size());
+    print_usage(cout, "profile store", profiles, Profile_Store::shared().size());
+    print_usage(cout, "name trigram index", spelling, spellings.size());
+    print_usage(cout, "total", total, count);
+    cout << "\nstrings: " << total.inline_strings << " inline, " << total.heap_strings << " on the heap" << endl;
+
+    return 0;
+}
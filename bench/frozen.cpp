@@ -0,0 +1,111 @@
+/*
+ *********************************************************************
+ * Ian Leuty
+ * inleuty@gmail.com
+ * 10/19/2026
+ *********************************************************************
+ * frozen roster benchmark
+ *********************************************************************
+ * The registry's name index as a Red_Black tree (as registered, then
+ * compacted) and frozen (front coded text under a bucket index):
+ * the memory of each, lookups of registered and unregistered names
+ * and prefix searches as a desk terminal would send them.
+ *
+ *      usage: bench/frozen [contestants] [lookups]
+ *********************************************************************
+ */
+
+#include <random>
+#include "bench.h"
+#include "../stats.h"
+#include "../frozen.h"
+
+using namespace std;
+
+typedef Red_Black<string, shared_ptr<Contestant>, Field_Stats> registry;
+
+//ns per lookup of 'names' in order, 'found' counts the hits
+template<typename INDEX>
+static double lookups(const INDEX &index, const vector<string> &names, long &found)
+{
+    found = 0;
+    double start{now()};
+    for (const auto &name : names)
+        found += index.find_ptr(name) != nullptr;
+    return (now() - start) * 1e9 / names.size();
+}
+
+//ns per prefix search of 'prefixes', 'found' adds up the names returned
+template<typename INDEX>
+static double prefixes(const INDEX &index, const vector<string> &prefixes, long &found)
+{
+    found = 0;
+    vector<string> names;
+    vector<shared_ptr<Contestant>> contestants;
+    double start{now()};
+    for (const auto &prefix : prefixes)
+        found += index.prefix_search(prefix, 10, names, contestants);
+    return (now() - start) * 1e9 / prefixes.size();
+}
+
+int main(int argc, char *argv[])
+{
+    int count{argc > 1 ? atoi(argv[1]) : 200000};
+    int queries{argc > 2 ? atoi(argv[2]) : 1000000};
+
+    vector<shared_ptr<Contestant>> field;
+    make_field(count, field);
+    mt19937 random(42);
+    shuffle(field.begin(), field.end(), random);
+    registry tree;
+    for (const auto &contestant : field)
+        tree.insert(contestant -> get_name(), contestant);
+
+    double start{now()};
+    Frozen<shared_ptr<Contestant>> roster{freeze(tree)};
+    double freezing{now() - start};
+
+    //every other lookup is for someone who never registered
+    vector<string> wanted(queries), typed(queries / 10);
+    for (int i{}; i < queries; ++i)
+        wanted[i] = bench_name(random() % (2 * count));
+    for (auto &prefix : typed){
+        prefix = bench_name(random() % count);
+        prefix.resize(prefix.size() - 1 - random() % 3);
+    }
+
+    Memory nodes, keys, unused, index, text;
+    tree.account(nodes, keys, unused);
+    roster.account(index, text, unused);
+
+    long found{}, hits[3]{}, listed[3]{};
+    double as_registered{lookups(tree, wanted, hits[0])};
+    double searched{prefixes(tree, typed, listed[0])};
+    tree.compact();
+    double compacted{lookups(tree, wanted, hits[1])};
+    double compact_searched{prefixes(tree, typed, listed[1])};
+    double frozen{lookups(roster, wanted, hits[2])};
+    double frozen_searched{prefixes(roster, typed, listed[2])};
+
+    vector<string> a, b;
+    tree.fetch_keys(a);
+    roster.fetch_keys(b);
+    found = hits[0];
+    bool right{a == b && hits[1] == found && hits[2] == found && listed[1] == listed[0] && listed[2] == listed[0]};
+
+    long tree_bytes{nodes.allocated + keys.allocated}, frozen_bytes{index.allocated + text.allocated};
+    cout << "contestants:          " << count << " (frozen in " << freezing * 1e3 << " ms)\n"
+         << "name index, tree:     " << tree_bytes << " bytes, " << static_cast<double>(tree_bytes) / count << " per name\n"
+         << "name index, frozen:   " << frozen_bytes << " bytes, " << static_cast<double>(frozen_bytes) / count
+         << " per name (" << text.allocated << " of it text, " << static_cast<double>(tree_bytes) / frozen_bytes << "x smaller)\n"
+         << "lookups:              " << queries << " (" << found << " registered)\n"
+         << "   tree:              " << as_registered << " ns per lookup\n"
+         << "   compacted tree:    " << compacted << " ns per lookup\n"
+         << "   frozen:            " << frozen << " ns per lookup\n"
+         << "prefix searches:      " << typed.size() << " (up to 10 names)\n"
+         << "   tree:              " << searched << " ns per search\n"
+         << "   compacted tree:    " << compact_searched << " ns per search\n"
+         << "   frozen:            " << frozen_searched << " ns per search\n"
+         << "\nanswers " << (right ? "match" : "DO NOT MATCH") << endl;
+    return right ? 0 : 1;
+}
@@ -0,0 +1,137 @@
+/*
+ *********************************************************************
+ * Ian Leuty
+ * inleuty@gmail.com
+ * 10/19/2026
+ *********************************************************************
+ * fuzzy name search benchmark
+ *********************************************************************
+ * Indexes generated names (see generator.h), then looks up names with
+ * one or two random edits, through the trigram index and by checking
+ * the edit distance of every name. The scan is slow, so only a sample
+ * of the queries is scanned and the two answers are compared on it.
+ * Half the names are then removed, which rebuilds the index.
+ *
+ *      usage: bench/fuzzy [names] [queries] [scanned queries]
+ *********************************************************************
+ */
+
+#include <algorithm>
+#include <random>
+#include "bench.h"
+#include "../fuzzy.h"
+#include "../generator.h"
+
+using namespace std;
+
+//the top 'k' names within 'distance' of 'query' the slow way
+static void scan(const vector<string> &names, const string &query, int k, int distance,
+                 vector<string> &found, vector<int> &distances)
+{
+    vector<pair<int, string>> within;
+    for (const auto &name : names){
+        int edits{Fuzzy_Index::edit_distance(query, name, distance)};
+        if (edits <= distance)
+            within.emplace_back(edits, name);
+    }
+    sort(within.begin(), within.end());
+    found.clear();
+    distances.clear();
+    for (size_t i{}; i < within.size() && static_cast<int>(i) < k; ++i){
+        distances.push_back(within[i].first);
+        found.push_back(within[i].second);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    int count{argc > 1 ? atoi(argv[1]) : 1000000};
+    int queries{argc > 2 ? atoi(argv[2]) : 10000};
+    int scanned{argc > 3 ? atoi(argv[3]) : 20};
+    const int k{5};
+
+    Roster_Options options;
+    options.count = count;
+    Roster_Generator generator(options);
+    vector<string> names(count);
+    for (int i{}; i < count; ++i)
+        generator.name(i, names[i]);
+
+    Fuzzy_Index index;
+    double start{now()};
+    for (const auto &name : names)
+        index.insert(name);
+    double indexing{now() - start};
+
+    //one or two substitutions, insertions or deletions of lowercase letters
+    mt19937 random(42);
+    vector<string> typed;
+    vector<int> meant;
+    for (int i{}; i < queries; ++i){
+        int which(random() % count);
+        string query{names[which]};
+        for (int edits(1 + random() % 2); edits > 0; --edits){
+            size_t at{random() % query.size()};
+            char letter(static_cast<char>('a' + random() % 26));
+            switch (random() % 3){
+                case 0:
+                    query[at] = letter;
+                    break;
+                case 1:
+                    query.insert(query.begin() + at, letter);
+                    break;
+                default:
+                    if (query.size() > 1)
+                        query.erase(at, 1);
+                    break;
+            }
+        }
+        typed.push_back(query);
+        meant.push_back(which);
+    }
+
+    vector<string> found;
+    vector<int> distances;
+    long hits{}, matches{};
+    start = now();
+    for (int i{}; i < queries; ++i){
+        matches += index.search(typed[i], k, found, distances);
+        hits += find(found.begin(), found.end(), names[meant[i]]) != found.end();
+    }
+    double searching{now() - start};
+
+    //the same queries the slow way, which must give the same answers
+    bool right{true};
+    vector<string> slow_found;
+    vector<int> slow_distances;
+    start = now();
+    for (int i{}; i < scanned && i < queries; ++i){
+        scan(names, typed[i], k, Fuzzy_Index::MAX_DISTANCE, slow_found, slow_distances);
+        index.search(typed[i], k, found, distances);
+        right = right && found == slow_found && distances == slow_distances;
+    }
+    double scanning{now() - start};
+
+    start = now();
+    for (int i{}; i < count; i += 2)
+        index.remove(names[i]);
+    double removing{now() - start};
+    for (int i{}; i < count && right; i += max(1, count / 1000)){
+        index.search(names[i], 1, found, distances);
+        right = (i % 2 == 0) ? found.empty() || found[0] != names[i] : found.size() == 1 && found[0] == names[i];
+    }
+
+    Memory usage;
+    index.account(usage);
+    cout << "names:              " << count << " (" << usage.allocated / count << " bytes each indexed)\n"
+         << "indexing:           " << indexing * 1e9 / count << " ns per name\n"
+         << "queries:            " << queries << " with 1 or 2 edits, top " << k << "\n"
+         << "index search:       " << searching * 1e6 / queries << " us per query, "
+         << static_cast<double>(matches) / queries << " matches each\n"
+         << "intended name found " << 100.0 * hits / queries << "% of the time\n"
+         << "scanning every name " << scanning * 1e6 / max(1, min(scanned, queries)) << " us per query ("
+         << scanning / max(1, min(scanned, queries)) / (searching / queries) << "x slower)\n"
+         << "removing half:      " << removing * 1e9 / ((count + 1) / 2) << " ns per name, with rebuilds\n"
+         << "\nanswers " << (right ? "match" : "DO NOT MATCH") << endl;
+    return right ? 0 : 1;
+}
@@ -0,0 +1,110 @@
+/*
+ *********************************************************************
+ * Ian Leuty
+ * inleuty@gmail.com
+ * 10/19/2026
+ *********************************************************************
+ * ingest benchmark
+ *********************************************************************
+ * Sustained events per second through the timing event pipeline.
+ * Every contestant checks in, starts, crosses 'splits' mats and
+ * finishes. The events are applied to a registry and leaderboard the
+ * way Menu::ingest applies them, then again with an applier that does
+ * nothing to show what the reader, parser and batcher alone sustain.
+ *
+ *      usage: bench/ingest [contestants] [splits] [batch size]
+ *********************************************************************
+ */
+
+#include "bench.h"
+#include "../pipeline.h"
+#include "../leaderboard.h"
+#include "../stats.h"
+
+using namespace std;
+
+int main(int argc, char *argv[])
+{
+    int count{argc > 1 ? atoi(argv[1]) : 100000};
+    int splits{argc > 2 ? atoi(argv[2]) : 16};
+    int batch_size{argc > 3 ? atoi(argv[3]) : 4096};
+    const char *events_file{"/tmp/bench_events.in"};
+
+    vector<shared_ptr<Contestant>> field;
+    make_field(count, field, false);
+    Red_Black<string, shared_ptr<Contestant>, Field_Stats> tree;
+    for (const auto &contestant : field)
+        tree.insert(contestant -> get_name(), contestant);
+
+    //mats report in waves, so one contestant's events are spread over the stream
+    long expected{};
+    {
+        ofstream out(events_file);
+        for (int i{}; i < count; ++i){
+            switch (i % 3){
+                case 0:
+                    out << "C," << bench_name(i) << "," << 1 + i % 20 << ",Y\n";
+                    break;
+                case 1:
+                    out << "C," << bench_name(i) << "," << 2 + i % 9 << ",Y,555-0100\n";
+                    break;
+                default:
+                    out << "C," << bench_name(i) << ",N," << 20 + i % 81 << "\n";
+                    break;
+            }
+        }
+        for (int i{}; i < count; ++i)
+            out << "S," << bench_name(i) << "\n";
+        for (int mat{1}; mat <= splits; ++mat)
+            for (int i{}; i < count; ++i)
+                out << "P," << bench_name(i) << "," << mat * 0.5 << "," << mat * (3 + i % 5) << "\n";
+        for (int i{}; i < count; ++i)
+            out << "F," << bench_name(i) << "," << (splits + 1) * (3 + i % 5) << "\n";
+        expected = static_cast<long>(count) * (splits + 3);
+    }
+
+    Leaderboard leaderboard;
+    Pipeline pipeline(64, batch_size);
+    double start{now()};
+    vector<string> names;
+    vector<shared_ptr<Contestant>*> found;
+    long applied{pipeline.run(events_file, [&](const vector<Run> &runs){
+        names.clear();
+        for (const auto &run : runs)
+            names.emplace_back(run.name);
+        tree.find_many(names, found);
+        long done{};
+        for (size_t i{}; i < runs.size(); ++i){
+            if (!found[i])
+                continue;
+            bool changed{};
+            for (int j{}; j < runs[i].count; ++j)
+                done += Pipeline::apply(**found[i], runs[i].events[j], changed);
+            tree.update(names[i]);
+            leaderboard.update(names[i], *found[i]);
+        }
+        return done;
+    })};
+    double full{now() - start};
+
+    Pipeline bare(64, batch_size);
+    start = now();
+    long passed{bare.run(events_file, [](const vector<Run> &runs){
+        long n{};
+        for (const auto &run : runs)
+            n += run.count;
+        return n;
+    })};
+    double stages{now() - start};
+    std::remove(events_file);
+
+    cout << "contestants:            " << count << "\n"
+         << "events:                 " << pipeline.events_read() << " (" << splits << " splits each)\n"
+         << "batches:                " << pipeline.batches() << " (up to " << batch_size << " events)\n"
+         << "applied:                " << applied << " / " << expected << "\n"
+         << "finishers on the board: " << leaderboard.size() << "\n"
+         << "pipeline + registry:    " << pipeline.events_read() / full << " events/s\n"
+         << "pipeline alone:         " << bare.events_read() / stages << " events/s" << endl;
+
+    return applied != expected || passed != expected || pipeline.events_rejected() != 0;
+}
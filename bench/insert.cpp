@@ -0,0 +1,130 @@
+/*
+ *********************************************************************
+ * Ian Leuty
+ * inleuty@gmail.com
+ * 10/19/2026
+ *********************************************************************
+ * hinted insert benchmark
+ *********************************************************************
+ * Builds a tree of names from sorted, nearly sorted (a share of the
+ * names swapped with a close neighbour) and random input with
+ * try_insert, insert_hint carrying its hint from insert to insert,
+ * and append, reporting time and KEY compares per insert. Every tree
+ * is checked against the names and then emptied in random order.
+ *
+ *      usage: bench/insert [names] [percent out of order]
+ *********************************************************************
+ */
+
+#include <algorithm>
+#include <random>
+#include "bench.h"
+#include "../structures.h"
+
+using namespace std;
+
+//a name that counts how often it is compared
+struct Counted
+{
+    string name;
+    static long compares;
+};
+long Counted::compares{};
+
+bool operator<(const Counted &a, const Counted &b)
+{
+    ++Counted::compares;
+    return a.name < b.name;
+}
+
+bool operator>(const Counted &a, const Counted &b)
+{
+    ++Counted::compares;
+    return a.name > b.name;
+}
+
+bool operator==(const Counted &a, const Counted &b)
+{
+    ++Counted::compares;
+    return a.name == b.name;
+}
+
+//time and compares of building a tree from 'keys' with 'method'
+//0 try_insert, 1 insert_hint, 2 append (try_insert when append refuses)
+static bool build(const vector<Counted> &keys, int method, double &taken, long &compares)
+{
+    Red_Black<Counted, int> tree;
+    int hint{};
+    Counted::compares = 0;
+    double start{now()};
+    for (size_t i{}; i < keys.size(); ++i){
+        switch (method){
+            case 0:
+                tree.try_insert(keys[i], i);
+                break;
+            case 1:
+                tree.insert_hint(hint, keys[i], i);
+                break;
+            default:
+                if (!tree.append(keys[i], i))
+                    tree.try_insert(keys[i], i);
+                break;
+        }
+    }
+    taken = now() - start;
+    compares = Counted::compares;
+
+    //every key is there, in order, and the tree can be taken apart again
+    vector<Counted> held;
+    tree.fetch_keys(held);
+    vector<Counted> sorted(keys);
+    sort(sorted.begin(), sorted.end());
+    bool right{held.size() == sorted.size()};
+    for (size_t i{}; right && i < held.size(); ++i)
+        right = held[i].name == sorted[i].name;
+
+    vector<Counted> order(keys);
+    shuffle(order.begin(), order.end(), mt19937(7));
+    for (const auto &key : order)
+        right = right && tree.remove(key);
+    return right && tree.size() == 0;
+}
+
+int main(int argc, char *argv[])
+{
+    int count{argc > 1 ? atoi(argv[1]) : 200000};
+    int disorder{argc > 2 ? atoi(argv[2]) : 2};
+
+    vector<Counted> sorted;
+    for (int i{}; i < count; ++i)
+        sorted.push_back(Counted{bench_name(i)});
+    sort(sorted.begin(), sorted.end());
+
+    mt19937 random(42);
+    vector<Counted> nearly(sorted);
+    for (int i{}; i + 8 < count; ++i)
+        if (static_cast<int>(random() % 100) < disorder)
+            swap(nearly[i], nearly[i + 1 + random() % 8]);
+
+    vector<Counted> shuffled(sorted);
+    shuffle(shuffled.begin(), shuffled.end(), random);
+
+    const char *orders[]{"sorted", "nearly sorted", "random"};
+    const vector<Counted> *inputs[]{&sorted, &nearly, &shuffled};
+    const char *methods[]{"try_insert", "insert_hint", "append"};
+
+    cout << "names: " << count << ", " << disorder << "% out of order\n\n"
+         << "order           method         ns per insert   compares per insert\n";
+    bool right{true};
+    for (int order{}; order < 3; ++order){
+        for (int method{}; method < 3; ++method){
+            double taken{};
+            long compares{};
+            right = build(*inputs[order], method, taken, compares) && right;
+            printf("%-15s %-14s %13.1f %21.2f\n", orders[order], methods[method], taken * 1e9 / count,
+                   static_cast<double>(compares) / count);
+        }
+    }
+    cout << "\ntrees " << (right ? "match" : "DO NOT MATCH") << " their input" << endl;
+    return right ? 0 : 1;
+}
@@ -0,0 +1,122 @@
+/*
+ *********************************************************************
+ * Ian Leuty
+ * inleuty@gmail.com
+ * 10/19/2026
+ *********************************************************************
+ * journal benchmark
+ *********************************************************************
+ * Cost of durability: registry updates (the same work Menu does per
+ * change) with no journal, then journaled with fdatasync per record
+ * and with group commit. Then recovery time from a long journal
+ * versus from a compacted snapshot.
+ *
+ *      usage: bench/journal [contestants] [updates] [directory]
+ *********************************************************************
+ */
+
+#include "bench.h"
+#include "../journal.h"
+
+using namespace std;
+
+typedef Red_Black<string, shared_ptr<Contestant>, Field_Stats> registry;
+
+//'updates' state changes spread over the field, each one logged and committed
+double run(registry &tree, const vector<shared_ptr<Contestant>> &field, int updates, Journal *journal)
+{
+    double start{now()};
+    for (int i{}; i < updates; ++i){
+        const auto &contestant{field[(i * 7919LL) % field.size()]};
+        stringstream details;
+        details << 1 + i % 20 << ",Y";
+        contestant -> check_in(details);
+        tree[contestant -> get_name()] = contestant;
+        if (journal){
+            journal -> put(contestant);
+            journal -> commit();
+        }
+    }
+    if (journal)
+        journal -> sync();
+    return now() - start;
+}
+
+int main(int argc, char *argv[])
+{
+    int count{argc > 1 ? atoi(argv[1]) : 20000};
+    int updates{argc > 2 ? atoi(argv[2]) : 200000};
+    string directory{argc > 3 ? argv[3] : "/tmp"};
+    string file{directory + "/bench.journal"};
+
+    vector<shared_ptr<Contestant>> field;
+    make_field(count, field);
+
+    registry plain;
+    double memory{run(plain, field, updates, nullptr)};
+
+    //fdatasync per record is slow, so it only gets a slice of the updates
+    int slice{min(updates, 2000)};
+    double single{};
+    {
+        std::remove(file.c_str());
+        std::remove((file + ".snapshot").c_str());
+        registry tree;
+        bool walking{}, cycling{}, running{};
+        Journal journal;
+        journal.open(file, tree, walking, cycling, running);
+        journal.set_group(1, 0);
+        single = run(tree, field, slice, &journal) * updates / slice;
+    }
+
+    double grouped{};
+    {
+        std::remove(file.c_str());
+        std::remove((file + ".snapshot").c_str());
+        registry tree;
+        bool walking{}, cycling{}, running{};
+        Journal journal;
+        journal.open(file, tree, walking, cycling, running);
+        journal.set_group(1024, 10);
+        grouped = run(tree, field, updates, &journal);
+    }
+
+    //recover the long journal, compact it and recover again
+    double replay{}, compacted{};
+    int recovered{}, from_snapshot{};
+    {
+        registry tree;
+        bool walking{}, cycling{}, running{};
+        Journal journal;
+        double start{now()};
+        int records{journal.open(file, tree, walking, cycling, running)};
+        replay = now() - start;
+        recovered = tree.size();
+        cout << "records replayed:       " << records << "\n";
+        journal.compact(tree, walking, cycling, running);
+    }
+    {
+        registry tree;
+        bool walking{}, cycling{}, running{};
+        Journal journal;
+        double start{now()};
+        journal.open(file, tree, walking, cycling, running);
+        compacted = now() - start;
+        from_snapshot = tree.size();
+    }
+    std::remove(file.c_str());
+    std::remove((file + ".snapshot").c_str());
+
+    cout << "contestants:            " << count << "\n"
+         << "updates:                " << updates << "\n"
+         << "no journal:             " << updates / memory << " updates/s\n"
+         << "fdatasync per record:   " << updates / single << " updates/s (from " << slice << ")\n"
+         << "group commit:           " << updates / grouped << " updates/s (1024 records / 10 ms)\n"
+         << "journal cost:           " << (grouped - memory) * 1e6 / updates << " us per update\n"
+         << "group commit overhead:  " << (grouped - memory) / grouped * 100 << "% of throughput\n"
+         << "recover journal:        " << replay * 1000 << " ms\n"
+         << "recover snapshot:       " << compacted * 1000 << " ms\n"
+         << "recovered:              " << recovered << " / " << from_snapshot << endl;
+
+    return recovered != count || from_snapshot != count;
+}
@@ -0,0 +1,77 @@
+/*
+ *********************************************************************
+ * Ian Leuty
+ * inleuty@gmail.com
+ * 10/19/2026
+ *********************************************************************
+ * lookup benchmark
+ *********************************************************************
+ * Miss-heavy lookups (bad reads from the mats) through the throwing
+ * retrieve versus the non-throwing find_ptr and lookup.
+ *
+ *      usage: bench/lookup [contestants] [lookups] [miss percent]
+ *********************************************************************
+ */
+
+#include "bench.h"
+#include "../structures.h"
+
+using namespace std;
+
+int main(int argc, char *argv[])
+{
+    int count{argc > 1 ? atoi(argv[1]) : 200000};
+    int lookups{argc > 2 ? atoi(argv[2]) : 1000000};
+    int miss_percent{argc > 3 ? atoi(argv[3]) : 90};
+
+    vector<shared_ptr<Contestant>> field;
+    make_field(count, field);
+    Red_Black<string, shared_ptr<Contestant>> tree;
+    for (const auto &contestant : field)
+        tree.insert(contestant -> get_name(), contestant);
+
+    //misspelled names sort right next to real ones, so misses walk full paths
+    vector<string> names;
+    names.reserve(lookups);
+    for (int i{}; i < lookups; ++i){
+        string name{bench_name(static_cast<int>((i * 7919LL) % count))};
+        if (i % 100 < miss_percent)
+            name += "x";
+        names.push_back(name);
+    }
+
+    int found{};
+    double start{now()};
+    for (const auto &name : names){
+        try{
+            tree.retrieve(name);
+            ++found;
+        }
+        catch (TREE_ERROR::not_found_exception &error){}
+    }
+    double throwing{now() - start};
+
+    int found_ptr{};
+    start = now();
+    for (const auto &name : names)
+        if (tree.find_ptr(name))
+            ++found_ptr;
+    double pointer{now() - start};
+
+    int found_optional{};
+    start = now();
+    for (const auto &name : names)
+        if (tree.lookup(name))
+            ++found_optional;
+    double optional{now() - start};
+
+    cout << "contestants:          " << count << "\n"
+         << "lookups:              " << lookups << " (" << miss_percent << "% misses)\n"
+         << "retrieve + catch:     " << throwing * 1e9 / lookups << " ns per lookup\n"
+         << "find_ptr:             " << pointer * 1e9 / lookups << " ns per lookup\n"
+         << "lookup (optional):    " << optional * 1e9 / lookups << " ns per lookup\n"
+         << "speedup (find_ptr):   " << throwing / pointer << "x\n"
+         << "found:                " << found << " / " << found_ptr << " / " << found_optional << endl;
+
+    return found != found_ptr || found != found_optional;
+}
@@ -0,0 +1,63 @@
+/*
+ *********************************************************************
+ * Ian Leuty
+ * inleuty@gmail.com
+ * 10/19/2026
+ *********************************************************************
+ * projection benchmark
+ *********************************************************************
+ * Virtual predict_completion one contestant at a time versus a batch
+ * Projection sweep over the same field.
+ *
+ *      usage: bench/projection [contestants] [refreshes]
+ *********************************************************************
+ */
+
+#include <cstring>
+#include "bench.h"
+#include "../projection.h"
+
+using namespace std;
+
+int main(int argc, char *argv[])
+{
+    int count{argc > 1 ? atoi(argv[1]) : 1000000};
+    int refreshes{argc > 2 ? atoi(argv[2]) : 20};
+
+    vector<shared_ptr<Contestant>> field;
+    make_field(count, field);
+    vector<float> scalar(count), batch(count);
+
+    //one virtual call per contestant per refresh
+    double start{now()};
+    for (int r{}; r < refreshes; ++r)
+        for (int i{}; i < count; ++i)
+            scalar[i] = field[i] -> predict_completion(10 + r);
+    double scalar_time{(now() - start) / refreshes};
+
+    //gather once, then sweep on each refresh
+    start = now();
+    Projection projection;
+    projection.gather(field);
+    double gather_time{now() - start};
+
+    start = now();
+    for (int r{}; r < refreshes; ++r)
+        projection.project(10 + r, batch);
+    double batch_time{(now() - start) / refreshes};
+
+    //the last refresh of each must match bit for bit
+    int mismatched{};
+    for (int i{}; i < count; ++i)
+        if (memcmp(&scalar[i], &batch[i], sizeof(float)) != 0)
+            ++mismatched;
+
+    cout << "contestants:        " << count << "\n"
+         << "predict_completion: " << scalar_time * 1000 << " ms per refresh\n"
+         << "gather (once):      " << gather_time * 1000 << " ms\n"
+         << "projection:         " << batch_time * 1000 << " ms per refresh\n"
+         << "speedup:            " << scalar_time / batch_time << "x\n"
+         << "mismatched results: " << mismatched << endl;
+
+    return mismatched != 0;
+}
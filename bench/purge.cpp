@@ -0,0 +1,73 @@
+/*
+ *********************************************************************
+ * Ian Leuty
+ * inleuty@gmail.com
+ * 10/19/2026
+ *********************************************************************
+ * purge benchmark
+ *********************************************************************
+ * Purging a share of the registry (disqualified contestants) by
+ * finding them and calling remove for each name, versus one
+ * remove_if, which removes a few one at a time and rebuilds the tree
+ * once many go. Each share starts from a copy of the same registry.
+ *
+ *      usage: bench/purge [contestants]
+ *********************************************************************
+ */
+
+#include "bench.h"
+#include "../stats.h"
+
+using namespace std;
+
+typedef Red_Black<string, shared_ptr<Contestant>, Field_Stats> registry;
+
+int main(int argc, char *argv[])
+{
+    int count{argc > 1 ? atoi(argv[1]) : 200000};
+
+    vector<shared_ptr<Contestant>> field;
+    make_field(count, field);
+    registry full;
+    for (const auto &contestant : field)
+        full.insert(contestant -> get_name(), contestant);
+
+    bool right{true};
+    cout << "contestants: " << count << "\n\n"
+         << "removed      find, remove each      remove_if\n";
+    double disqualified{};
+    for (double share : {0.001, 0.01, 0.02, 0.05, 0.1, 0.25, 0.5, 0.9}){
+        //disqualify a spread out 'share' of the field, on top of the last share
+        for (int i{}; i < count; ++i)
+            if (i * 7919L % 1000 >= disqualified * 1000 && i * 7919L % 1000 < share * 1000)
+                field[i] -> disqualify();
+        disqualified = share;
+        auto out = [](const string &, const shared_ptr<Contestant> &contestant){
+            return contestant -> is_status(Status::DISQUALIFIED);
+        };
+
+        //the way before remove_if: find who is out, then remove them one by one
+        registry single{full};
+        double start{now()};
+        vector<string> names;
+        single.for_each([&names, &out](const string &name, const shared_ptr<Contestant> &contestant){
+            if (out(name, contestant))
+                names.push_back(name);
+        });
+        for (const auto &name : names)
+            single.remove(name);
+        double one_at_a_time{now() - start};
+
+        registry filtered{full};
+        start = now();
+        int removed{filtered.remove_if(out)};
+        double filtering{now() - start};
+
+        right = right && removed == static_cast<int>(names.size()) && filtered.size() == single.size()
+                && filtered.aggregate().contestants == single.size() && filtered.aggregate().disqualified == 0;
+        cout << setw(6) << share * 100 << "% " << setw(18) << one_at_a_time * 1e3 << " ms "
+             << setw(11) << filtering * 1e3 << " ms\n";
+    }
+    cout << "\nanswers " << (right ? "match" : "DO NOT MATCH") << endl;
+    return right ? 0 : 1;
+}
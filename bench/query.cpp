@@ -0,0 +1,227 @@
+/*
+ *********************************************************************
+ * Ian Leuty
+ * inleuty@gmail.com
+ * 10/19/2026
+ *********************************************************************
+ * query server load generator
+ *********************************************************************
+ * Registers a field through the query server, then drives it from
+ * 'connections' client threads at pipeline depths 1, 4, 16, ... up to
+ * 'depth', reporting requests per second and latency percentiles at
+ * each. The depth with the most requests per second is the server's
+ * maximum QPS on this machine.
+ *
+ * With no address a server is started in this process on a Unix
+ * socket, otherwise the one at 'address' (see server.h) is used.
+ *
+ * Query mix: 60% lookup, 20% find (half misses), 10% range of 20
+ * names, 10% standings top 10.
+ *
+ *      usage: bench/query [contestants] [requests] [connections] [depth] [address]
+ *********************************************************************
+ */
+
+#include <algorithm>
+#include <deque>
+#include <iomanip>
+#include <random>
+#include <thread>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "bench.h"
+#include "../server.h"
+
+using namespace std;
+
+//any response but MALFORMED is expected
+static const char ANY{-1};
+
+//what one connection saw
+struct Drive
+{
+    vector<double> latencies;
+    long errors{};
+};
+
+//append request 'i' to 'out', returns the status it should get
+typedef function<char(long i, string &out)> maker;
+
+//send 'requests' requests keeping up to 'depth' of them unanswered
+//latency is from when a request is queued to when its response is read
+static Drive drive(const string &address, long requests, int depth, const maker &make)
+{
+    Drive result;
+    int fd{Protocol::connect(address)};
+    if (fd < 0){
+        result.errors = requests;
+        return result;
+    }
+    result.latencies.reserve(requests);
+
+    deque<pair<double, char>> waiting;
+    string out, in;
+    long issued{}, answered{};
+    char buffer[1 << 16];
+    while (answered < requests){
+        out.clear();
+        while (issued < requests && issued - answered < depth){
+            char expected{make(issued++, out)};
+            waiting.push_back({now(), expected});
+        }
+        for (size_t sent{}; sent < out.size();){
+            ssize_t count{send(fd, out.data() + sent, out.size() - sent, MSG_NOSIGNAL)};
+            if (count <= 0){
+                ::close(fd);
+                result.errors += requests - answered;
+                return result;
+            }
+            sent += count;
+        }
+
+        ssize_t count{recv(fd, buffer, sizeof(buffer), 0)};
+        if (count <= 0)
+            break;
+        in.append(buffer, count);
+
+        size_t used{};
+        size_t length{};
+        while ((length = Protocol::framed(in.data() + used, in.size() - used)) && length <= Protocol::MAX_FRAME){
+            char status{in[used + sizeof(uint32_t)]};
+            auto [queued, expected]{waiting.front()};
+            waiting.pop_front();
+            result.latencies.push_back((now() - queued) * 1e6);
+            if (status == Protocol::MALFORMED || (expected != ANY && status != expected))
+                ++result.errors;
+            used += length;
+            ++answered;
+        }
+        in.erase(0, used);
+    }
+    result.errors += requests - answered;
+    ::close(fd);
+    return result;
+}
+
+//roster row for contestant 'i', half marathoners get unique bibs
+static string row(int i)
+{
+    if (i % 3 != 2)
+        return bench_name(i) + "," + bench_fields(i);
+    return bench_name(i) + "," + to_string(8 + i % 7) + "," + to_string(90 + i % 90) + "," + to_string(i + 1);
+}
+
+//latency at fraction 'p' of the sorted samples
+static double percentile(const vector<double> &sorted, double p)
+{
+    return sorted.empty() ? 0 : sorted[min(sorted.size() - 1, static_cast<size_t>(p * sorted.size()))];
+}
+
+int main(int argc, char *argv[])
+{
+    int count{argc > 1 ? atoi(argv[1]) : 100000};
+    long requests{argc > 2 ? atol(argv[2]) : 50000};
+    int connections{argc > 3 ? atoi(argv[3]) : 4};
+    int max_depth{argc > 4 ? atoi(argv[4]) : 64};
+    string address{argc > 5 ? argv[5] : "/tmp/bench_query.sock"};
+
+    Server server;
+    thread serving;
+    if (argc <= 5){
+        server.listen(address);
+        serving = thread(&Server::serve, &server);
+    }
+
+    long errors{};
+    double start{now()};
+    Drive registered{drive(address, count, max_depth, [](long i, string &out){
+        size_t frame{Protocol::begin(out, Protocol::REGISTER)};
+        out.push_back(static_cast<char>(i % 3 + 1));
+        Protocol::put(out, row(i));
+        Protocol::finish(out, frame);
+        return ANY;
+    })};
+    double loading{now() - start};
+    errors += registered.errors;
+
+    cout << "contestants:       " << count << "\n"
+         << "registered:        " << count / loading << " requests/s (depth " << max_depth << ")\n"
+         << "connections:       " << connections << "\n"
+         << "requests each:     " << requests << "\n\n"
+         << setw(8) << "depth" << setw(14) << "requests/s" << setw(10) << "p50 us" << setw(10) << "p99 us"
+         << setw(10) << "p99.9 us" << setw(10) << "max us" << "\n";
+
+    vector<int> depths;
+    for (int depth{1}; depth < max_depth; depth *= 4)
+        depths.push_back(depth);
+    depths.push_back(max_depth);
+
+    double best{};
+    int best_depth{};
+    for (int depth : depths){
+        vector<Drive> results(connections);
+        vector<thread> clients;
+        start = now();
+        for (int c{}; c < connections; ++c){
+            clients.emplace_back([&, c, depth]{
+                mt19937 random(c * 7919 + depth);
+                results[c] = drive(address, requests, depth, [&](long, string &out){
+                    int i(random() % count);
+                    int pick(random() % 10);
+                    size_t frame{};
+                    char expected{Protocol::OK};
+                    if (pick < 6){
+                        frame = Protocol::begin(out, Protocol::LOOKUP);
+                        Protocol::put(out, bench_name(i));
+                    }
+                    else if (pick < 8){
+                        bool miss{random() % 2 == 0};
+                        frame = Protocol::begin(out, Protocol::FIND);
+                        Protocol::put(out, miss ? "Nobody " + to_string(i) : bench_name(i));
+                        expected = miss ? Protocol::MISSING : Protocol::OK;
+                    }
+                    else if (pick < 9){
+                        frame = Protocol::begin(out, Protocol::RANGE);
+                        Protocol::put(out, bench_name(i));
+                        Protocol::put(out, string("\x7f"));
+                        Protocol::put(out, static_cast<uint16_t>(20));
+                    }
+                    else{
+                        frame = Protocol::begin(out, Protocol::STANDINGS);
+                        Protocol::put(out, static_cast<uint16_t>(10));
+                    }
+                    Protocol::finish(out, frame);
+                    return expected;
+                });
+            });
+        }
+        for (auto &client : clients)
+            client.join();
+        double taken{now() - start};
+
+        vector<double> latencies;
+        for (auto &result : results){
+            latencies.insert(latencies.end(), result.latencies.begin(), result.latencies.end());
+            errors += result.errors;
+        }
+        sort(latencies.begin(), latencies.end());
+        double rate{latencies.size() / taken};
+        if (rate > best){
+            best = rate;
+            best_depth = depth;
+        }
+        cout << fixed << setprecision(1) << setw(8) << depth << setw(14) << rate
+             << setw(10) << percentile(latencies, 0.5) << setw(10) << percentile(latencies, 0.99)
+             << setw(10) << percentile(latencies, 0.999) << setw(10) << (latencies.empty() ? 0 : latencies.back()) << "\n";
+    }
+
+    cout << "\nmax:               " << best << " requests/s at depth " << best_depth << "\n"
+         << "errors:            " << errors << endl;
+
+    if (serving.joinable()){
+        server.stop();
+        serving.join();
+        unlink(address.c_str());
+    }
+    return errors != 0;
+}
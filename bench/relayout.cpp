@@ -0,0 +1,112 @@
+/*
+ *********************************************************************
+ * Ian Leuty
+ * inleuty@gmail.com
+ * 10/19/2026
+ *********************************************************************
+ * relayout benchmark
+ *********************************************************************
+ * Lookups in a registry after hours of churn (rounds of removing and
+ * registering a share of the field again, between other allocations
+ * that come and go), then in the same tree after compact, and in a
+ * tree bulk loaded from scratch (appended in sorted order into a
+ * fresh heap) as the target to match.
+ *
+ *      usage: bench/relayout [contestants] [lookups] [churn rounds]
+ *********************************************************************
+ */
+
+#include <algorithm>
+#include <random>
+#include "bench.h"
+#include "../stats.h"
+
+using namespace std;
+
+typedef Red_Black<string, shared_ptr<Contestant>, Field_Stats> registry;
+
+//ns per lookup of 'names' in order, 'found' counts the hits
+static double lookups(const registry &tree, const vector<string> &names, long &found)
+{
+    found = 0;
+    double start{now()};
+    for (const auto &name : names)
+        found += tree.find_ptr(name) != nullptr;
+    return (now() - start) * 1e9 / names.size();
+}
+
+int main(int argc, char *argv[])
+{
+    int count{argc > 1 ? atoi(argv[1]) : 200000};
+    int queries{argc > 2 ? atoi(argv[2]) : 2000000};
+    int rounds{argc > 3 ? atoi(argv[3]) : 20};
+
+    vector<shared_ptr<Contestant>> field;
+    make_field(count, field);
+    vector<string> names(count);
+    for (int i{}; i < count; ++i)
+        names[i] = field[i] -> get_name();
+
+    mt19937 random(42);
+    vector<int> picks(count);
+    for (int i{}; i < count; ++i)
+        picks[i] = i;
+    shuffle(picks.begin(), picks.end(), random);
+
+    registry tree;
+    for (int i : picks)
+        tree.insert(names[i], field[i]);
+
+    //each round a quarter of the field leaves and registers again, while other
+    //allocations of about a node's size are made and freed around them
+    vector<unique_ptr<char[]>> clutter(count / 2);
+    double start{now()};
+    for (int round{}; round < rounds; ++round){
+        shuffle(picks.begin(), picks.end(), random);
+        for (int i{}; i < count / 4; ++i){
+            tree.remove(names[picks[i]]);
+            clutter[random() % clutter.size()].reset(new char[48 + random() % 96]);
+        }
+        for (int i{}; i < count / 4; ++i){
+            tree.insert(names[picks[i]], field[picks[i]]);
+            clutter[random() % clutter.size()].reset(new char[48 + random() % 96]);
+        }
+    }
+    double churning{now() - start};
+
+    vector<string> wanted(queries);
+    for (auto &name : wanted)
+        name = names[random() % count];
+
+    long found{}, hits{};
+    double churned{lookups(tree, wanted, found)};
+    hits += found;
+
+    start = now();
+    tree.compact();
+    double compacting{now() - start};
+    double compacted{lookups(tree, wanted, found)};
+    hits += found;
+
+    //the same entries appended in sorted order, each node allocated right after the last
+    clutter.clear();
+    vector<int> sorted(count);
+    for (int i{}; i < count; ++i)
+        sorted[i] = i;
+    sort(sorted.begin(), sorted.end(), [&names](int a, int b){ return names[a] < names[b]; });
+    registry fresh;
+    for (int i : sorted)
+        fresh.append(names[i], field[i]);
+    double bulk{lookups(fresh, wanted, found)};
+    hits += found;
+
+    bool right{hits == 3L * queries && tree.size() == count && tree.aggregate().contestants == count};
+    cout << "contestants:        " << count << " (" << rounds << " rounds of churn, "
+         << churning * 1e3 << " ms)\n"
+         << "lookups:            " << queries << "\n"
+         << "after churn:        " << churned << " ns per lookup\n"
+         << "after compact:      " << compacted << " ns per lookup (compact took " << compacting * 1e3 << " ms)\n"
+         << "bulk loaded:        " << bulk << " ns per lookup\n"
+         << "\nanswers " << (right ? "match" : "DO NOT MATCH") << endl;
+    return right ? 0 : 1;
+}
@@ -0,0 +1,108 @@
+/*
+ *********************************************************************
+ * Ian Leuty
+ * inleuty@gmail.com
+ * 10/19/2026
+ *********************************************************************
+ * synthetic roster generator
+ *********************************************************************
+ * Writes a roster of any size for the loader and tree benchmarks
+ * (see generator.h) and reports how fast it was written.
+ *
+ *      usage: bench/roster [options] <file>
+ *          -n <count>              rows (100000)
+ *          -m <walk:bike:half>     type mix by weight (1:1:1)
+ *          -d <rate>               fraction of rows repeating a name (0)
+ *          -l <mean>[,<spread>]    name length (16,4)
+ *          -o <order>[,<disorder>] sorted, reverse, random or nearly (random)
+ *          -t <threads>            (all cores)
+ *          -s <seed>               (1)
+ *
+ *      bench/roster -n 1000000 -d 0.01 -o nearly,0.05 roster_1m.in
+ *********************************************************************
+ */
+
+#include <cstring>
+#include <unistd.h>
+#include "bench.h"
+#include "../generator.h"
+
+using namespace std;
+
+static int usage(const char *program)
+{
+    cerr << "usage: " << program << " [-n count] [-m walk:bike:half] [-d duplicate rate] [-l mean[,spread]]"
+         << " [-o sorted|reverse|random|nearly[,disorder]] [-t threads] [-s seed] <file>" << endl;
+    return 1;
+}
+
+int main(int argc, char *argv[])
+{
+    Roster_Options options;
+    int option{};
+    while ((option = getopt(argc, argv, "n:m:d:l:o:t:s:")) != -1){
+        switch (option){
+            case 'n':
+                options.count = atol(optarg);
+                break;
+            case 'm':
+                if (sscanf(optarg, "%d:%d:%d", &options.mix[0], &options.mix[1], &options.mix[2]) != 3)
+                    return usage(argv[0]);
+                break;
+            case 'd':
+                options.duplicates = atof(optarg);
+                break;
+            case 'l':
+                if (sscanf(optarg, "%d,%d", &options.name_length, &options.name_spread) < 1)
+                    return usage(argv[0]);
+                break;
+            case 'o': {
+                    string order{optarg};
+                    size_t comma{order.find(',')};
+                    if (comma != string::npos)
+                        options.disorder = atof(order.c_str() + comma + 1);
+                    order = order.substr(0, comma);
+                    if (order == "sorted")
+                        options.order = Order::SORTED;
+                    else if (order == "reverse")
+                        options.order = Order::REVERSE;
+                    else if (order == "random")
+                        options.order = Order::RANDOM;
+                    else if (order == "nearly")
+                        options.order = Order::NEARLY;
+                    else
+                        return usage(argv[0]);
+                }
+                break;
+            case 't':
+                options.threads = atoi(optarg);
+                break;
+            case 's':
+                options.seed = strtoull(optarg, nullptr, 10);
+                break;
+            default:
+                return usage(argv[0]);
+        }
+    }
+    if (optind != argc - 1)
+        return usage(argv[0]);
+
+    Roster_Generator generator(options);
+    double start{now()};
+    long bytes{};
+    try{
+        bytes = generator.write(argv[optind]);
+    }
+    catch (GENERATOR_ERROR::no_file_exception &error){
+        cerr << error.msg;
+        return 1;
+    }
+    double taken{now() - start};
+
+    cerr << "rows:     " << options.count << "\n"
+         << "bytes:    " << bytes << "\n"
+         << "seconds:  " << taken << "\n"
+         << "rows/s:   " << options.count / taken << "\n"
+         << "MB/s:     " << bytes / taken / 1e6 << endl;
+    return 0;
+}
@@ -0,0 +1,119 @@
+/*
+ *********************************************************************
+ * Ian Leuty
+ * inleuty@gmail.com
+ * 10/19/2026
+ *********************************************************************
+ * shared memory snapshot benchmark
+ *********************************************************************
+ * The parent keeps moving contestants along and republishes the
+ * registry; a forked reader process maps the segment and does name
+ * lookups and a top ten scan for the same time, checking that every
+ * snapshot it reads is whole (names found, standings in order).
+ *
+ *      usage: bench/snapshot [contestants] [seconds] [lookups per read]
+ *********************************************************************
+ */
+
+#include <sys/wait.h>
+#include <unistd.h>
+#include "bench.h"
+#include "../snapshot.h"
+
+using namespace std;
+
+int main(int argc, char *argv[])
+{
+    int count{argc > 1 ? atoi(argv[1]) : 100000};
+    double seconds{argc > 2 ? atof(argv[2]) : 2.0};
+    int per_read{argc > 3 ? atoi(argv[3]) : 16};
+
+    vector<shared_ptr<Contestant>> field;
+    make_field(count, field);
+    Red_Black<string, shared_ptr<Contestant>, Field_Stats> tree;
+    Leaderboard leaderboard;
+    for (const auto &contestant : field){
+        contestant -> start();
+        tree.insert(contestant -> get_name(), contestant);
+        leaderboard.update(contestant -> get_name(), contestant);
+    }
+
+    const string name{"/llrb_bench_" + to_string(getpid())};
+    Snapshot_Publisher publisher;
+    publisher.open(name);
+    publisher.publish(tree, leaderboard);
+
+    int report[2];
+    if (pipe(report) < 0)
+        return 1;
+    //the reader leaves with _exit so the copy of the publisher it inherited never unlinks the segment
+    pid_t reader_pid{fork()};
+    if (reader_pid == 0){
+        ::close(report[0]);
+        Snapshot_Reader reader;
+        if (!reader.open(name))
+            _exit(1);
+
+        long reads{}, visits{}, found{}, broken{};
+        uint64_t first{}, last{};
+        double start{now()};
+        for (int i{}; now() - start < seconds; ++i){
+            //a rerun starts over, only the visit that read a whole snapshot counts
+            long visit_found{}, visit_broken{};
+            last = reader.read([&](const Snapshot_View &view){
+                ++visits;
+                visit_found = visit_broken = 0;
+                for (int j{}; j < per_read; ++j){
+                    string wanted{bench_name(static_cast<int>(((i * per_read + j) * 7919LL) % count))};
+                    const Snapshot_Entry *entry{view.find(wanted)};
+                    visit_found += entry != nullptr;
+                    visit_broken += !entry;
+                }
+                for (long place{2}; place <= min(10L, view.ranked()); ++place)
+                    visit_broken += view.standing(place).finish < view.standing(place - 1).finish;
+            });
+            found += visit_found;
+            broken += visit_broken;
+            if (!first)
+                first = last;
+            ++reads;
+        }
+        double taken{now() - start};
+
+        ostringstream out;
+        out << "reads:              " << reads << " (" << reads / taken << " per second)\n"
+            << "lookups:            " << found << " (" << found / taken / 1e6 << " million per second)\n"
+            << "reruns:             " << visits - reads << "\n"
+            << "snapshots seen:     " << last - first + 1 << "\n"
+            << "torn reads:         " << broken << "\n";
+        string text{out.str()};
+        _exit(write(report[1], text.data(), text.size()) < 0);
+    }
+    ::close(report[1]);
+
+    //move everyone a little further along between publishes
+    long publishes{};
+    double publishing{};
+    double start{now()};
+    for (int round{1}; now() - start < seconds; ++round){
+        for (int i{round % 100}; i < count; i += 100){
+            field[i] -> split(0.01f * round, round);
+            leaderboard.update(field[i] -> get_name(), field[i]);
+        }
+        double began{now()};
+        publisher.publish(tree, leaderboard);
+        publishing += now() - began;
+        ++publishes;
+    }
+
+    string text(4096, '\0');
+    ssize_t got{read(report[0], &text[0], text.size())};
+    text.resize(got > 0 ? got : 0);
+    waitpid(reader_pid, nullptr, 0);
+
+    cout << "contestants:        " << count << "\n"
+         << "segment:            " << publisher.segment_size() / 1024 << " KiB\n"
+         << "publishes:          " << publishes << " (" << publishing / max(publishes, 1L) * 1e3 << " ms each)\n"
+         << text;
+    return 0;
+}
@@ -10,6 +10,7 @@
  */
 
 #include "core.h"
+#include "structures.h"
 
 //core.h scope overloaded method to display a contesntant with <<
 //by calling overridden:
@@ -26,15 +27,20 @@ std::ostream& operator<<(std::ostream &out, const Contestant &here)
  * Abstract Base Class
  *
  * data members are:
- *      std::string name;
- *      std::string status;
- *      bool disqualified;
+ *      float covered;
+ *      int elapsed;
  *      int avg_speed;
+ *      Status status;
+ *      bool disqualified;
+ *      std::string name;
  *********************************************************************
  */
 
+//empty contestant, filled in by read_state
+Contestant::Contestant() : covered(0), elapsed(0), avg_speed(0), status(Status::REGISTERED), disqualified(false) {}
+
 //default constructor - create a contestant from stdin
-Contestant::Contestant(std::string &name_in) : name(name_in), status("REGISTERED"), disqualified(false)
+Contestant::Contestant(std::string &name_in) : covered(0), elapsed(0), status(Status::REGISTERED), disqualified(false), name(name_in)
 {
     using std::cin, std::cout;
 
@@ -42,8 +48,8 @@ Contestant::Contestant(std::string &name_in) : name(name_in), status("REGISTERED
     avg_speed = read_int();
 }
 
-//file constructor - create a contestant from ifstream
-Contestant::Contestant(std::string &name_in, std::ifstream &filein) : name(name_in), status("PRE-REGISTERED"), disqualified(false)
+//file constructor - create a contestant from a roster stream (file or single line)
+Contestant::Contestant(std::string &name_in, std::istream &filein) : covered(0), elapsed(0), status(Status::PRE_REGISTERED), disqualified(false), name(name_in)
 {
     filein >> avg_speed;
     filein.ignore(100, ',');
@@ -53,7 +59,7 @@ Contestant::Contestant(std::string &name_in, std::ifstream &filein) : name(name_
 Contestant::~Contestant()
 {
     name = "";
-    status = "";
+    status = Status::NONE;
     disqualified = false;
 }
 
@@ -65,7 +71,7 @@ void Contestant::display() const
     if (name == "")
         throw CONTESTANT_ERROR::no_name_exception();
 
-    cout << "| " << left << setw(30) << name << " | " << setw(8) << avg_speed << "km/hr" << " | " << setw(15) << status;
+    cout << "| " << left << setw(30) << name << " | " << setw(8) << avg_speed << "km/hr" << " | " << setw(15) << status_name(status);
 }
 
 //display the base traits of a contestant
@@ -77,7 +83,7 @@ void Contestant::display(std::ostream &out) const
     if (name == "")
         throw CONTESTANT_ERROR::no_name_exception();
 
-    out << "| " << left << setw(30) << name << " | " << setw(8) << avg_speed << "km/hr" << " | " << setw(15) << status;
+    out << "| " << left << setw(30) << name << " | " << setw(8) << avg_speed << "km/hr" << " | " << setw(15) << status_name(status);
 }
 
 //disqualify a contestant
@@ -85,16 +91,59 @@ bool Contestant::disqualify()
 {
     if (disqualified)
         return false;
-    status = "DISQUALIFIED";
+    status = Status::DISQUALIFIED;
     return disqualified = true;
 }
 
+//a split from the timing mats, only contestants who are racing can have one
+//splits must move forward in both distance and time
+bool Contestant::split(float km, int minutes)
+{
+    if (!is_racing())
+        return false;
+    if (km <= covered || minutes <= elapsed)
+        return false;
+    covered = km;
+    elapsed = minutes;
+    return true;
+}
+
+//crossed the finish line after 'minutes'
+bool Contestant::finish(int minutes)
+{
+    if (!is_racing())
+        return false;
+    if (minutes <= 0 || minutes < elapsed)
+        return false;
+    elapsed = minutes;
+    status = Status::FINISHED;
+    return true;
+}
+
+//km covered at the last split
+float Contestant::get_covered() const
+{
+    return covered;
+}
+
+//minutes at the last split or at the finish
+int Contestant::get_elapsed() const
+{
+    return elapsed;
+}
+
 //something something getter bad (see structures.cpp line 176 for the only use of this)
 std::string Contestant::get_name() const
 {
     return name;
 }
 
+//correct a misspelled name, the registry re-keys the contestant to match
+void Contestant::set_name(const std::string &name_in)
+{
+    name = name_in;
+}
+
 //compare the name of the contestant with a key passed in
 int Contestant::compare_names(const std::string &key)
 {
@@ -114,7 +163,77 @@ int Contestant::compare_names(const Contestant &to_compare)
 //check if the passed in matched the contestants status
 bool Contestant::is_status(const std::string &status)
 {
-    return this -> status.compare(status) == 0;
+    return this -> status == status_named(status);
+}
+
+//the same check without building or comparing a string
+bool Contestant::is_status(Status status) const
+{
+    return this -> status == status;
+}
+
+//walking, cycling or running
+bool Contestant::is_racing() const
+{
+    return status == Status::WALKING || status == Status::CYCLING || status == Status::RUNNING;
+}
+
+//the status itself, for copying out of the registry
+Status Contestant::get_status() const
+{
+    return status;
+}
+
+//names of the statuses, in the order of Status
+static const char *STATUS_NAMES[]{"", "REGISTERED", "PRE-REGISTERED", "CHECKED IN", "WALKING", "CYCLING", "RUNNING",
+                                  "FINISHED", "DISQUALIFIED", "INJURED"};
+
+//the name a status is displayed (and journaled) with
+const char* Contestant::status_name(Status status)
+{
+    return STATUS_NAMES[static_cast<int>(status)];
+}
+
+//the status with 'name', NONE if there is none
+Status Contestant::status_named(const std::string &name)
+{
+    for (size_t i{1}; i < std::size(STATUS_NAMES); ++i)
+        if (name == STATUS_NAMES[i])
+            return static_cast<Status>(i);
+    return Status::NONE;
+}
+
+//write the base traits in binary
+//write_key / read_key (structures.h) handle both the strings and the plain values
+void Contestant::write_state(std::ostream &out) const
+{
+    write_key(out, name);
+    write_key(out, std::string(status_name(status)));
+    write_key(out, avg_speed);
+    write_key(out, disqualified);
+    write_key(out, covered);
+    write_key(out, elapsed);
+}
+
+//read back what write_state wrote
+bool Contestant::read_state(std::istream &in)
+{
+    std::string named;
+    read_key(in, name);
+    read_key(in, named);
+    status = status_named(named);
+    read_key(in, avg_speed);
+    read_key(in, disqualified);
+    read_key(in, covered);
+    read_key(in, elapsed);
+    return static_cast<bool>(in);
+}
+
+//the name, derived classes add the object itself
+//cold strings are counted by the profile store
+void Contestant::account(Memory &usage, size_t shared) const
+{
+    usage.string(name);
 }
 
 //reads an int in and return it
@@ -142,33 +261,41 @@ const int Contestant::read_int()
  *
  * data members are:
  *      int kms_registered;
- *      std::string conversation_topic;
  *      bool tied_shoes;
+ *      uint32_t topic_id;
  **********************************************************************
  */
 
+//empty Walking_Contestant, filled in by read_state
+Walking_Contestant::Walking_Contestant() : kms_registered(0), tied_shoes(false), topic_id(0) {}
+
 //default constructor - create a Walking_Contestant from stdin
-Walking_Contestant::Walking_Contestant(std::string &name) : Contestant(name), kms_registered(0), tied_shoes(false)
+Walking_Contestant::Walking_Contestant(std::string &name) : Contestant(name), kms_registered(0), tied_shoes(false), topic_id(0)
 {
     using std::cin, std::cout;
 
+    std::string topic;
     cout << "Enter " << name << "'s favorite conversation topic.\n>";
-    getline(cin, conversation_topic);
+    getline(cin, topic);
+    Profile_Store::shared().set(topic_id, topic);
 }
 
-//file contstructor - create a Walking_Contestant from ifstream
+//file contstructor - create a Walking_Contestant from a roster stream
 //format: <CONTESTANT TYPE>,<NAME>,<AVG_SPEED>,<CONVERSATION TOPIC>
-Walking_Contestant::Walking_Contestant(std::string &name, std::ifstream &filein) : Contestant(name, filein), kms_registered(0), tied_shoes(false)
+Walking_Contestant::Walking_Contestant(std::string &name, std::istream &filein) : Contestant(name, filein), kms_registered(0), tied_shoes(false), topic_id(0)
 {
-    getline(filein, conversation_topic);
+    std::string topic;
+    getline(filein, topic);
+    Profile_Store::shared().set(topic_id, topic);
 }
 
-//destructor - reset members to null values
+//destructor - reset members to null values, the topic goes back to the profile store
 Walking_Contestant::~Walking_Contestant()
 {
     kms_registered = 0;
     tied_shoes = false;
-    conversation_topic = "";
+    Profile_Store::shared().release(topic_id);
+    topic_id = 0;
 }
 
 //display - virtual and self-similar for all
@@ -182,7 +309,7 @@ void Walking_Contestant::display() const
         throw error;
     }
 
-    cout << " | " << left << setw(21) << "Likes to talk about: " << setw(29) << conversation_topic << " | "
+    cout << " | " << left << setw(21) << "Likes to talk about: " << setw(29) << Profile_Store::shared().get(topic_id) << " | "
          << setw(14) <<  "Registered for: " << setw(3) << kms_registered << setw(16) << "  kms        |" << endl;
 }
 
@@ -191,13 +318,13 @@ void Walking_Contestant::display(std::ostream &out) const
 {
     using std::endl, std::setw, std::left;
 
-    try {Contestant::display();}
+    try {Contestant::display(out);}
 
     catch(CONTESTANT_ERROR::no_name_exception &error){
         throw error;
     }
 
-    out << " | " << left << setw(21) << "Likes to talk about: " << setw(29) << conversation_topic << " | "
+    out << " | " << left << setw(21) << "Likes to talk about: " << setw(29) << Profile_Store::shared().get(topic_id) << " | "
          << setw(14) <<  "Registered for: " << setw(3) << kms_registered << setw(16) << "  kms        |" << endl;
 }
 
@@ -205,19 +332,19 @@ void Walking_Contestant::display(std::ostream &out) const
 bool Walking_Contestant::start()
 {
     if (disqualified){
-        status = "DISQUALIFIED";
+        status = Status::DISQUALIFIED;
         Contestant::disqualify();
         return false;
     }
 
-    if (status.compare("CHECKED IN") != 0){
+    if (status != Status::CHECKED_IN){
         Contestant::disqualify();
         if (!tied_shoes)
-            status = "INJURED";
+            status = Status::INJURED;
         return false;
     }
 
-    status = "WALKING";
+    status = Status::WALKING;
     return true;
 }
 
@@ -241,7 +368,25 @@ bool Walking_Contestant::check_in()
     else
         cout << "\nWarning, untied shoes are a hazard." << endl;
 
-    status = "CHECKED IN";
+    status = Status::CHECKED_IN;
+    return true;
+}
+
+//check in a contestant without prompting
+//format: <KMS REGISTERED>,<SHOES TIED (Y/N)>
+bool Walking_Contestant::check_in(std::istream &in)
+{
+    int kms{};
+    char tied{};
+    in >> kms;
+    in.ignore(100, ',');
+    in >> tied;
+    if (in.fail() || kms > 20 || kms < 1)
+        return false;
+
+    kms_registered = kms;
+    tied_shoes = toupper(tied) == 'Y';
+    status = Status::CHECKED_IN;
     return true;
 }
 
@@ -253,6 +398,42 @@ float Walking_Contestant::predict_completion(int time)
     return ((hours * static_cast<float>(avg_speed)) / static_cast<float>(kms_registered)) * 100;
 }
 
+//hand the terms of predict_completion to a batch projection
+//completion is ((hours * rate) / span) * 100 for every contestant type
+void Walking_Contestant::gather(float &rate, float &span) const
+{
+    rate = static_cast<float>(avg_speed);
+    span = static_cast<float>(kms_registered);
+}
+
+//base traits then the walker's
+void Walking_Contestant::write_state(std::ostream &out) const
+{
+    Contestant::write_state(out);
+    write_key(out, kms_registered);
+    write_key(out, Profile_Store::shared().get(topic_id));
+    write_key(out, tied_shoes);
+}
+
+//read back what write_state wrote
+bool Walking_Contestant::read_state(std::istream &in)
+{
+    Contestant::read_state(in);
+    read_key(in, kms_registered);
+    std::string topic;
+    read_key(in, topic);
+    Profile_Store::shared().set(topic_id, topic);
+    read_key(in, tied_shoes);
+    return static_cast<bool>(in);
+}
+
+//the object and its control block
+void Walking_Contestant::account(Memory &usage, size_t shared) const
+{
+    usage.allocation(sizeof(*this) + shared);
+    Contestant::account(usage);
+}
+
 
 
 /*
@@ -260,34 +441,43 @@ float Walking_Contestant::predict_completion(int time)
  * Bicycle_Contestant class definition
  *
  * data members are:
- *      bool signed_waiver;
  *      int race_stages;
- *      std::string fav_bike;
- *      std::string emergency_contact;
+ *      bool signed_waiver;
+ *      uint32_t bike_id;
+ *      uint32_t contact_id;
  **********************************************************************
  */
 
+//empty Bicycle_Contestant, filled in by read_state
+Bicycle_Contestant::Bicycle_Contestant() : race_stages(0), signed_waiver(false), bike_id(0), contact_id(0) {}
+
 //default constructor - creates a Bicycle_Contestant from stdin
-Bicycle_Contestant::Bicycle_Contestant(std::string &name) : Contestant(name), race_stages(0), signed_waiver(false)
+Bicycle_Contestant::Bicycle_Contestant(std::string &name) : Contestant(name), race_stages(0), signed_waiver(false), bike_id(0), contact_id(0)
 {
     using std::cout, std::cin;
 
+    std::string bike;
     cout << "Enter a description of " << name << "'s bike.\n>";
-    getline(cin, fav_bike);
+    getline(cin, bike);
+    Profile_Store::shared().set(bike_id, bike);
 }
 
-//file constructor - creates a Bicycle_Contestant from ifstream
+//file constructor - creates a Bicycle_Contestant from a roster stream
 //format: <CONTESTANT TYPE>,<NAME>,<AVG_SPEED>,<FAV BIKE>
-Bicycle_Contestant::Bicycle_Contestant(std::string &name, std::ifstream &filein) : Contestant(name, filein), race_stages(0), signed_waiver(false)
+Bicycle_Contestant::Bicycle_Contestant(std::string &name, std::istream &filein) : Contestant(name, filein), race_stages(0), signed_waiver(false), bike_id(0), contact_id(0)
 {
-    getline(filein, fav_bike);
+    std::string bike;
+    getline(filein, bike);
+    Profile_Store::shared().set(bike_id, bike);
 }
 
-//destrutor
+//destrutor, the bike and contact go back to the profile store
 Bicycle_Contestant::~Bicycle_Contestant()
 {
-    fav_bike = "";
-    emergency_contact = "";
+    Profile_Store::shared().release(bike_id);
+    Profile_Store::shared().release(contact_id);
+    bike_id = 0;
+    contact_id = 0;
     race_stages = 0;
     signed_waiver = false;
 }
@@ -303,7 +493,7 @@ void Bicycle_Contestant::display() const
         throw error;
     }
 
-    cout << " | " << left << setw(18) << "Bike description: " << setw(32) << fav_bike << " | "
+    cout << " | " << left << setw(18) << "Bike description: " << setw(32) << Profile_Store::shared().get(bike_id) << " | "
          << setw(14) << "Registered for: " << setw(3) << race_stages << setw(9) << " 3km stages  |" << endl;
 }
 
@@ -312,26 +502,26 @@ void Bicycle_Contestant::display(std::ostream &out) const
 {
     using std::endl, std::setw, std::left;
 
-    try {Contestant::display();}
+    try {Contestant::display(out);}
 
     catch(CONTESTANT_ERROR::no_name_exception &error){
         throw error;
     }
 
-    out << " | " << left << setw(18) << "Bike description: " << setw(32) << fav_bike << " | "
+    out << " | " << left << setw(18) << "Bike description: " << setw(32) << Profile_Store::shared().get(bike_id) << " | "
          << setw(14) << "Registered for: " << setw(3) << race_stages << setw(9) << " 3km stages  |" << endl;
 }
 
 //start a Bicycle_Contestant - set status to "RIDING"
 bool Bicycle_Contestant::start()
 {
-    if (disqualified || status.compare("CHECKED IN") != 0 || !signed_waiver){
-        status = "DISQUALIFIED";
+    if (disqualified || status != Status::CHECKED_IN || !signed_waiver){
+        status = Status::DISQUALIFIED;
         Contestant::disqualify();
         return false;
     }
 
-    status = "CYCLING";
+    status = Status::CYCLING;
     return true;
 }
 
@@ -354,19 +544,49 @@ bool Bicycle_Contestant::check_in()
     if (toupper(check) == 'Y')
         signed_waiver = true;
     else{
-        status = "DISQUALIFIED";
+        status = Status::DISQUALIFIED;
         Contestant::disqualify();
         return false;
     }
 
+    std::string contact;
     cout << "Enter an emergency contact for " << name << " (optional)\n>";
-    getline(cin, emergency_contact);
+    getline(cin, contact);
+    Profile_Store::shared().set(contact_id, contact);
 
-    status = "CHECKED IN";
+    status = Status::CHECKED_IN;
     return true;
 
 }
 
+//check in a bicycle contestant without prompting
+//format: <RACE STAGES>,<SIGNED WAIVER (Y/N)>,<EMERGENCY CONTACT>
+bool Bicycle_Contestant::check_in(std::istream &in)
+{
+    int stages{};
+    char check{};
+    in >> stages;
+    in.ignore(100, ',');
+    in >> check;
+    if (in.fail() || stages > 10 || stages < 2)
+        return false;
+
+    race_stages = stages;
+    if (toupper(check) != 'Y'){
+        status = Status::DISQUALIFIED;
+        Contestant::disqualify();
+        return false;
+    }
+    signed_waiver = true;
+
+    std::string contact;
+    in.ignore(100, ',');
+    getline(in, contact);
+    Profile_Store::shared().set(contact_id, contact);
+    status = Status::CHECKED_IN;
+    return true;
+}
+
 //return a percent completion based on 3km stages inteded to complete and avg_speed
 float Bicycle_Contestant::predict_completion(int time)
 {
@@ -374,6 +594,44 @@ float Bicycle_Contestant::predict_completion(int time)
     return ((hours * static_cast<float>(avg_speed)) / (3 * race_stages)) * 100;
 }
 
+//batch projection terms, 3km per stage
+void Bicycle_Contestant::gather(float &rate, float &span) const
+{
+    rate = static_cast<float>(avg_speed);
+    span = static_cast<float>(3 * race_stages);
+}
+
+//base traits then the cyclist's
+void Bicycle_Contestant::write_state(std::ostream &out) const
+{
+    Contestant::write_state(out);
+    write_key(out, race_stages);
+    write_key(out, signed_waiver);
+    write_key(out, Profile_Store::shared().get(bike_id));
+    write_key(out, Profile_Store::shared().get(contact_id));
+}
+
+//read back what write_state wrote
+bool Bicycle_Contestant::read_state(std::istream &in)
+{
+    Contestant::read_state(in);
+    read_key(in, race_stages);
+    read_key(in, signed_waiver);
+    std::string bike, contact;
+    read_key(in, bike);
+    read_key(in, contact);
+    Profile_Store::shared().set(bike_id, bike);
+    Profile_Store::shared().set(contact_id, contact);
+    return static_cast<bool>(in);
+}
+
+//the object and its control block
+void Bicycle_Contestant::account(Memory &usage, size_t shared) const
+{
+    usage.allocation(sizeof(*this) + shared);
+    Contestant::account(usage);
+}
+
 
 
 /*
@@ -388,6 +646,9 @@ float Bicycle_Contestant::predict_completion(int time)
  *********************************************************************
  */
 
+//empty Half_Marathon_Contestant, filled in by read_state
+Half_Marathon_Contestant::Half_Marathon_Contestant() : racer_number(0), hydration_level(50), record_holder(false), previous_best(0) {}
+
 //default constructor, creates a Half_Marathon_Contestant from stdin
 Half_Marathon_Contestant::Half_Marathon_Contestant(std::string &name) : Contestant(name), racer_number(rand() % 999), hydration_level(50), record_holder(false)
 {
@@ -397,9 +658,9 @@ Half_Marathon_Contestant::Half_Marathon_Contestant(std::string &name) : Contesta
     previous_best = read_int();
 }
 
-//file constructor, creates a Half_Marathon_Contestant from ifstream
+//file constructor, creates a Half_Marathon_Contestant from a roster stream
 //format: <CONTESTANT TYPE>,<NAME>,<AVG_SPEED>,<PREVIOUS BEST>,<RACER NUMBER>
-Half_Marathon_Contestant::Half_Marathon_Contestant(std::string &name, std::ifstream &filein) : Contestant(name, filein), hydration_level(50), record_holder(false)
+Half_Marathon_Contestant::Half_Marathon_Contestant(std::string &name, std::istream &filein) : Contestant(name, filein), hydration_level(50), record_holder(false)
 {
     filein >> previous_best;
     filein.ignore(100, ',');
@@ -441,7 +702,7 @@ void Half_Marathon_Contestant::display(std::ostream &out) const
 {
     using std::endl, std::setw, std::left;
 
-    try {Contestant::display();}
+    try {Contestant::display(out);}
 
     catch(CONTESTANT_ERROR::no_name_exception &error){
         throw error;
@@ -480,15 +741,27 @@ bool Half_Marathon_Contestant::hydrate()
     return false;
 }
 
+//bib number, the key timing mats report
+int Half_Marathon_Contestant::get_racer_number() const
+{
+    return racer_number;
+}
+
+//reassign the bib number, used when the one drawn is already taken
+void Half_Marathon_Contestant::set_racer_number(int number)
+{
+    racer_number = number;
+}
+
 bool Half_Marathon_Contestant::start()
 {
-    if (disqualified || status.compare("CHECKED IN") != 0 || racer_number == 0){
-        status = "DISQUALIFIED";
+    if (disqualified || status != Status::CHECKED_IN || racer_number == 0){
+        status = Status::DISQUALIFIED;
         Contestant::disqualify();
         return false;
     }
 
-    status = "RUNNING";
+    status = Status::RUNNING;
     return true;
 }
 
@@ -512,11 +785,29 @@ bool Half_Marathon_Contestant::check_in()
     }
     if (hydration_level > 100 || hydration_level < 0)
         hydration_level = 50;
-    status = "CHECKED IN";
+    status = Status::CHECKED_IN;
     return true;
 
 }
 
+//check in a Half_Marathon_Contestant without prompting
+//format: <RECORD HOLDER (Y/N)>,<HYDRATION LEVEL>
+bool Half_Marathon_Contestant::check_in(std::istream &in)
+{
+    char confirm{};
+    int hydration{};
+    in >> confirm;
+    in.ignore(100, ',');
+    in >> hydration;
+    if (in.fail() || hydration < 20)
+        return false;
+
+    record_holder = toupper(confirm) == 'Y';
+    hydration_level = hydration > 100 ? 50 : hydration;
+    status = Status::CHECKED_IN;
+    return true;
+}
+
 //predict completion percentage of the Half_Marathon_Contestant based on hydration level, average of previous best, and avg_speed
 float Half_Marathon_Contestant::predict_completion(int time)
 {
@@ -526,3 +817,100 @@ float Half_Marathon_Contestant::predict_completion(int time)
     return ((hours * adjusted_speed) / 21) * 100;
 }
 
+//batch projection terms, adjusted exactly as predict_completion does
+//a contestant with no hydration at all makes no progress
+void Half_Marathon_Contestant::gather(float &rate, float &span) const
+{
+    if (hydration_level == 0){
+        rate = 0;
+        span = 21;
+        return;
+    }
+    rate = static_cast<float>(avg_speed) + (static_cast<float>(previous_best) / 21) / 2;
+    rate *= (100 / hydration_level);
+    span = 21;
+}
+
+//base traits then the runner's
+void Half_Marathon_Contestant::write_state(std::ostream &out) const
+{
+    Contestant::write_state(out);
+    write_key(out, racer_number);
+    write_key(out, hydration_level);
+    write_key(out, record_holder);
+    write_key(out, previous_best);
+}
+
+//read back what write_state wrote
+bool Half_Marathon_Contestant::read_state(std::istream &in)
+{
+    Contestant::read_state(in);
+    read_key(in, racer_number);
+    read_key(in, hydration_level);
+    read_key(in, record_holder);
+    read_key(in, previous_best);
+    return static_cast<bool>(in);
+}
+
+//the object and its control block
+void Half_Marathon_Contestant::account(Memory &usage, size_t shared) const
+{
+    usage.allocation(sizeof(*this) + shared);
+    Contestant::account(usage);
+}
+
+//a shared contestant is counted where its DATA lives
+void heap_usage(const std::shared_ptr<Contestant> &contestant, Memory &usage)
+{
+    if (contestant)
+        contestant -> account(usage, SHARED_CONTROL);
+}
+
+//the type by RTTI, 1 walking, 2 cycling, 3 half marathon
+void to_bytes(const std::shared_ptr<Contestant> &contestant, std::string &out)
+{
+    char type{3};
+    if (std::dynamic_pointer_cast<Walking_Contestant>(contestant))
+        type = 1;
+    else if (std::dynamic_pointer_cast<Bicycle_Contestant>(contestant))
+        type = 2;
+    std::ostringstream state;
+    contestant -> write_state(state);
+    out.push_back(type);
+    out += state.str();
+}
+
+bool from_bytes(std::string_view bytes, std::shared_ptr<Contestant> &contestant)
+{
+    if (bytes.empty())
+        return false;
+    switch (bytes[0]){
+        case 1:
+            contestant = std::make_shared<Walking_Contestant>();
+            break;
+        case 2:
+            contestant = std::make_shared<Bicycle_Contestant>();
+            break;
+        case 3:
+            contestant = std::make_shared<Half_Marathon_Contestant>();
+            break;
+        default:
+            return false;
+    }
+    std::istringstream state(std::string(bytes.substr(1)));
+    return contestant -> read_state(state);
+}
+
+//split a field's memory by contestant type
+void account_by_type(const std::vector<std::shared_ptr<Contestant>> &field, Memory (&by_type)[3], long (&counts)[3])
+{
+    for (const auto &contestant : field){
+        int type{2};
+        if (std::dynamic_pointer_cast<Walking_Contestant>(contestant))
+            type = 0;
+        else if (std::dynamic_pointer_cast<Bicycle_Contestant>(contestant))
+            type = 1;
+        heap_usage(contestant, by_type[type]);
+        ++counts[type];
+    }
+}
@@ -38,11 +38,14 @@
  *********************************************************************
  */
 
+#ifndef CORE
+#define CORE
 
 #include <cstring>
 #include <iostream>
 #include <iomanip>
 #include <string>
+#include <string_view>
 #include <memory>
 #include <vector>
 #include <fstream>
@@ -51,6 +54,8 @@
 #include <sstream>
 #include <cstdlib>
 #include <ctime>
+#include "footprint.h"
+#include "profile.h"
 
 //exceptions related to the core hierarchy
 struct CONTESTANT_ERROR
@@ -63,13 +68,17 @@ struct CONTESTANT_ERROR
     };
 };
 
+//where a contestant is in the event
+enum class Status : char{NONE, REGISTERED, PRE_REGISTERED, CHECKED_IN, WALKING, CYCLING, RUNNING,
+                         FINISHED, DISQUALIFIED, INJURED};
+
 //abstract contestant base class
 class Contestant
 {
     public:
         Contestant();
         Contestant(std::string &name);
-        Contestant(std::string &name, std::ifstream &filein);
+        Contestant(std::string &name, std::istream &filein);
 
         friend std::ostream& operator<<(std::ostream &out, const Contestant &here);
         virtual ~Contestant();
@@ -77,21 +86,51 @@ class Contestant
         virtual void display(std::ostream &out) const;
         virtual bool start() = 0;
         virtual bool check_in() = 0;
+        virtual bool check_in(std::istream &in) = 0;
         virtual float predict_completion(int time) = 0;
+        virtual void gather(float &rate, float &span) const = 0;
+
+        //binary copy of everything about the contestant, for the journal
+        virtual void write_state(std::ostream &out) const;
+        virtual bool read_state(std::istream &in);
+
+        //heap the contestant owns, counted into 'usage'
+        //'shared' bytes of control block were allocated along with the object
+        virtual void account(Memory &usage, size_t shared = 0) const;
+
+        //timing mat readings, 'km' covered after 'minutes' racing
+        bool split(float km, int minutes);
+        bool finish(int minutes);
+        float get_covered() const;
+        int get_elapsed() const;
 
         bool set_winner();
         bool disqualify();
         std::string get_name() const;
+        void set_name(const std::string &name_in);
         int compare_names(const std::string &key);
         int compare_names(const Contestant &to_compare);
         bool is_status(const std::string &status);
+        bool is_status(Status status) const;
+        bool is_racing() const;
+        Status get_status() const;
+
+        //"CHECKED IN", "WALKING", ...
+        static const char* status_name(Status status);
+        static Status status_named(const std::string &name);
 
     protected:
-        std::string name;
-        std::string status;
-        const int read_int();
+        //hot state, read by every whole field sweep, kept together at the front
+        //(in the object, not a separate array: see README, Projection is the contiguous copy)
+        //last split (or finish) reported by the mats
+        float covered;
+        int elapsed;
         int avg_speed;
+        Status status;
         bool disqualified;
+
+        std::string name;
+        const int read_int();
 };
 
 //derived contestant - walking
@@ -100,18 +139,28 @@ class Walking_Contestant: public Contestant
     public:
         Walking_Contestant();
         Walking_Contestant(std::string &name);
-        Walking_Contestant(std::string &name, std::ifstream &filein);
+        Walking_Contestant(std::string &name, std::istream &filein);
         ~Walking_Contestant();
+        //each holds profile store references, released once by the destructor
+        Walking_Contestant(const Walking_Contestant &source) = delete;
+        Walking_Contestant& operator=(const Walking_Contestant &source) = delete;
         void display() const;
         void display(std::ostream &out) const;
         bool start();
         bool check_in();
+        bool check_in(std::istream &in);
         float predict_completion(int time);
+        void gather(float &rate, float &span) const;
+        void write_state(std::ostream &out) const;
+        bool read_state(std::istream &in);
+        void account(Memory &usage, size_t shared = 0) const;
 
     protected:
         int kms_registered;
-        std::string conversation_topic;
         bool tied_shoes;
+
+        //cold, kept in the profile store
+        uint32_t topic_id;
 };
 
 //derived contestant - bicycle
@@ -120,19 +169,29 @@ class Bicycle_Contestant : public Contestant
     public:
         Bicycle_Contestant();
         Bicycle_Contestant(std::string &name);
-        Bicycle_Contestant(std::string &name, std::ifstream &filein);
+        Bicycle_Contestant(std::string &name, std::istream &filein);
         ~Bicycle_Contestant();
+        //as Walking_Contestant
+        Bicycle_Contestant(const Bicycle_Contestant &source) = delete;
+        Bicycle_Contestant& operator=(const Bicycle_Contestant &source) = delete;
         void display() const;
         void display(std::ostream &out) const;
         bool start();
         bool check_in();
+        bool check_in(std::istream &in);
         float predict_completion(int time);
+        void gather(float &rate, float &span) const;
+        void write_state(std::ostream &out) const;
+        bool read_state(std::istream &in);
+        void account(Memory &usage, size_t shared = 0) const;
 
     protected:
         int race_stages;
         bool signed_waiver;
-        std::string fav_bike;
-        std::string emergency_contact;
+
+        //cold, kept in the profile store
+        uint32_t bike_id;
+        uint32_t contact_id;
 };
 
 //derived contestant marathon runner
@@ -141,14 +200,21 @@ class Half_Marathon_Contestant : public Contestant
     public:
         Half_Marathon_Contestant();
         Half_Marathon_Contestant(std::string &name);
-        Half_Marathon_Contestant(std::string &name, std::ifstream &filein);
+        Half_Marathon_Contestant(std::string &name, std::istream &filein);
         ~Half_Marathon_Contestant();
         void display() const;
         void display(std::ostream &out) const;
         bool start();
         bool hydrate();
+        int get_racer_number() const;
+        void set_racer_number(int number);
         bool check_in();
+        bool check_in(std::istream &in);
         float predict_completion(int time);
+        void gather(float &rate, float &span) const;
+        void write_state(std::ostream &out) const;
+        bool read_state(std::istream &in);
+        void account(Memory &usage, size_t shared = 0) const;
 
     protected:
         int racer_number;
@@ -157,3 +223,15 @@ class Half_Marathon_Contestant : public Contestant
         int previous_best;
 };
 
+//a registry's DATA owns the contestant and its control block (made with make_shared)
+void heap_usage(const std::shared_ptr<Contestant> &contestant, Memory &usage);
+
+//a contestant on disk (see disk.h): its type, as in a roster, then write_state
+//from_bytes makes a new contestant and is false if the bytes do not read back
+void to_bytes(const std::shared_ptr<Contestant> &contestant, std::string &out);
+bool from_bytes(std::string_view bytes, std::shared_ptr<Contestant> &contestant);
+
+//memory and number of each contestant in 'field' by type: walking, cycling, half marathon
+void account_by_type(const std::vector<std::shared_ptr<Contestant>> &field, Memory (&by_type)[3], long (&counts)[3]);
+
+#endif
@@ -0,0 +1,850 @@
+/*
+ *********************************************************************
+ * Ian Leuty
+ * inleuty@gmail.com
+ * 10/19/2026
+ *********************************************************************
+ * disk tree definition
+ *********************************************************************
+ */
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cstddef>
+#include "disk.h"
+
+using std::string, std::string_view, std::vector;
+
+//"DskTree1", the first bytes of both meta pages
+static const uint64_t MAGIC{0x31656572546b7344};
+
+/*
+ *********************************************************************
+ * page layout
+ *********************************************************************
+ * <HEADER><uint16 SLOT>...  free  ...<RECORD><RECORD>
+ *
+ * slots are the offsets of the records in key order, records are
+ * added from the back. A leaf record is <uint16 KEY LENGTH><uint16
+ * VALUE LENGTH><KEY><VALUE>, a branch record <uint32 PAGE><uint16 KEY
+ * LENGTH><KEY> and holds the keys from KEY up to the next record's.
+ * Keys below the first record's are in the header's 'first' page.
+ * A removed record leaves 'garbage' until the page is packed.
+ *********************************************************************
+ */
+
+struct Page_Header
+{
+    uint8_t leaf;
+    uint8_t unused;
+    uint16_t count;
+    uint16_t heap;
+    uint16_t garbage;
+    page_id first;
+    uint32_t reserved;
+};
+
+static const size_t HEADER{sizeof(Page_Header)};
+static_assert(HEADER == 16, "the page header is 16 bytes");
+
+static Page_Header& header(char *page)
+{
+    return *reinterpret_cast<Page_Header*>(page);
+}
+
+static const Page_Header& header(const char *page)
+{
+    return *reinterpret_cast<const Page_Header*>(page);
+}
+
+static uint16_t u16(const char *bytes)
+{
+    uint16_t value;
+    memcpy(&value, bytes, sizeof(value));
+    return value;
+}
+
+static uint32_t u32(const char *bytes)
+{
+    uint32_t value;
+    memcpy(&value, bytes, sizeof(value));
+    return value;
+}
+
+static uint16_t slot(const char *page, int i)
+{
+    return u16(page + HEADER + 2 * i);
+}
+
+static string_view key_at(const char *page, int i)
+{
+    const char *record{page + slot(page, i)};
+    if (header(page).leaf)
+        return string_view(record + 4, u16(record));
+    return string_view(record + 6, u16(record + 4));
+}
+
+static string_view value_at(const char *page, int i)
+{
+    const char *record{page + slot(page, i)};
+    return string_view(record + 4 + u16(record), u16(record + 2));
+}
+
+//the page below record 'i' of a branch, -1 for the first page
+static page_id child_at(const char *page, int i)
+{
+    return i < 0 ? header(page).first : u32(page + slot(page, i));
+}
+
+static void set_child(char *page, int i, page_id id)
+{
+    if (i < 0)
+        header(page).first = id;
+    else
+        memcpy(page + slot(page, i), &id, sizeof(id));
+}
+
+static size_t record_size(const char *page, int i)
+{
+    const char *record{page + slot(page, i)};
+    if (header(page).leaf)
+        return 4 + u16(record) + u16(record + 2);
+    return 6 + u16(record + 4);
+}
+
+//first record whose key is not less than 'key'
+static int lower(const char *page, string_view key)
+{
+    int low{}, high{header(page).count};
+    while (low < high){
+        int middle{low + (high - low) / 2};
+        if (key_at(page, middle) < key)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    return low;
+}
+
+//the branch record whose page holds 'key', -1 for the first page
+static int below(const char *page, string_view key)
+{
+    int low{}, high{header(page).count};
+    while (low < high){
+        int middle{low + (high - low) / 2};
+        if (key < key_at(page, middle))
+            high = middle;
+        else
+            low = middle + 1;
+    }
+    return low - 1;
+}
+
+static size_t room(const char *page)
+{
+    return header(page).heap - HEADER - 2 * header(page).count;
+}
+
+static string leaf_record(string_view key, string_view value)
+{
+    string record(4, '\0');
+    uint16_t lengths[2]{static_cast<uint16_t>(key.size()), static_cast<uint16_t>(value.size())};
+    memcpy(&record[0], lengths, sizeof(lengths));
+    record += key;
+    record += value;
+    return record;
+}
+
+static string branch_record(page_id child, string_view key)
+{
+    string record(6, '\0');
+    uint16_t length{static_cast<uint16_t>(key.size())};
+    memcpy(&record[0], &child, sizeof(child));
+    memcpy(&record[4], &length, sizeof(length));
+    record += key;
+    return record;
+}
+
+//the key of a record made by leaf_record or branch_record
+static string_view record_key(const string &record, bool leaf)
+{
+    if (leaf)
+        return string_view(record.data() + 4, u16(record.data()));
+    return string_view(record.data() + 6, u16(record.data() + 4));
+}
+
+//every record of a page, in key order
+static void records(const char *page, vector<string> &out)
+{
+    out.clear();
+    for (int i{}; i < header(page).count; ++i)
+        out.emplace_back(page + slot(page, i), record_size(page, i));
+}
+
+//lay 'page' out again holding 'from' through 'to' of 'list'
+static void fill(char *page, bool leaf, page_id first, const vector<string> &list, size_t from, size_t to)
+{
+    memset(page, 0, Pager::PAGE);
+    Page_Header &top{header(page)};
+    top.leaf = leaf;
+    top.first = first;
+    top.heap = Pager::PAGE;
+    for (size_t i{from}; i < to; ++i){
+        top.heap -= list[i].size();
+        memcpy(page + top.heap, list[i].data(), list[i].size());
+        memcpy(page + HEADER + 2 * top.count, &top.heap, sizeof(top.heap));
+        ++top.count;
+    }
+}
+
+//add 'record' as record 'i', packing the page first if only its garbage makes room
+//false if it does not fit at all
+static bool place(char *page, int i, const string &record)
+{
+    const size_t need{record.size() + 2};
+    if (room(page) < need){
+        if (room(page) + header(page).garbage < need)
+            return false;
+        vector<string> list;
+        records(page, list);
+        fill(page, header(page).leaf, header(page).first, list, 0, list.size());
+    }
+    Page_Header &top{header(page)};
+    top.heap -= record.size();
+    memcpy(page + top.heap, record.data(), record.size());
+    char *slots{page + HEADER};
+    memmove(slots + 2 * (i + 1), slots + 2 * i, 2 * (top.count - i));
+    memcpy(slots + 2 * i, &top.heap, sizeof(top.heap));
+    ++top.count;
+    return true;
+}
+
+static void drop(char *page, int i)
+{
+    Page_Header &top{header(page)};
+    top.garbage += record_size(page, i);
+    char *slots{page + HEADER};
+    memmove(slots + 2 * i, slots + 2 * (i + 1), 2 * (top.count - i - 1));
+    --top.count;
+}
+
+//the shortest prefix of 'right' that is still greater than 'left'
+static string_view separator(string_view left, string_view right)
+{
+    size_t shared{};
+    while (shared < left.size() && shared < right.size() && left[shared] == right[shared])
+        ++shared;
+    return right.substr(0, shared + 1);
+}
+
+//split a page too full for one more record (already in 'list' at 'added', with every record
+//of the page) into two halves by bytes, the second half going to a new page 'right'. A leaf's
+//halves are told apart by the shortest separator, a branch's middle key moves up to the parent.
+//A record added past the end is most likely the first of many in ascending order (an event
+//archived in name order), so the page is left full and the new one starts almost empty
+static void halve(Pager &pager, char *page, const vector<string> &list, size_t added, page_id &right, string &between)
+{
+    const bool leaf{static_cast<bool>(header(page).leaf)};
+    const page_id first{header(page).first};
+    size_t total{}, bytes{}, middle{};
+    for (const auto &record : list)
+        total += record.size() + 2;
+    while (middle < list.size() && bytes + list[middle].size() + 2 <= total / 2)
+        bytes += list[middle++].size() + 2;
+    if (added == list.size() - 1)
+        middle = list.size();
+    middle = std::clamp(middle, size_t{1}, list.size() - (leaf ? 1 : 2));
+
+    right = pager.allocate();
+    char *other{pager.write(right)};
+    if (leaf){
+        fill(page, true, 0, list, 0, middle);
+        fill(other, true, 0, list, middle, list.size());
+        between = string(separator(record_key(list[middle - 1], true), record_key(list[middle], true)));
+    }
+    else{
+        between = string(record_key(list[middle], false));
+        fill(other, false, u32(list[middle].data()), list, middle + 1, list.size());
+        fill(page, false, first, list, 0, middle);
+    }
+}
+
+/*
+ *********************************************************************
+ * Pager
+ * data members are:
+ *      int fd;
+ *      char *map;
+ *      page_id mapped;
+ *      Meta meta;
+ *      bool changed;
+ *      int capacity;
+ *      std::unordered_map<page_id, std::unique_ptr<Frame>> pool;
+ *      std::unordered_set<page_id> fresh;
+ *      std::vector<page_id> spare;
+ *      std::vector<page_id> freed;
+ *      std::vector<page_id> listing;
+ *********************************************************************
+ */
+
+//default constructor, nothing open
+Pager::Pager() : fd(-1), map(nullptr), mapped(0), meta{}, changed(false), capacity(0) {}
+
+//a failed last commit leaves the file at the commit before
+Pager::~Pager()
+{
+    try{
+        close();
+    }
+    catch (DISK_ERROR::write_exception &error){
+    }
+}
+
+//open the newest intact commit of 'filename', or start a new file with an empty tree
+void Pager::open(const string &filename, int pool)
+{
+    close();
+    fd = ::open(filename.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd < 0)
+        throw DISK_ERROR::open_exception();
+    capacity = std::max(pool, 16);
+
+    struct stat info;
+    fstat(fd, &info);
+    if (info.st_size == 0){
+        meta = Meta{MAGIC, 0, 0, 0, 2, 0, 0};
+        meta.checksum = checksum(meta);
+        Frame first{};
+        memcpy(first.bytes, &meta, sizeof(meta));
+        write_page(0, first.bytes);
+        write_page(1, first.bytes);
+        if (fdatasync(fd))
+            throw DISK_ERROR::write_exception();
+    }
+    else{
+        Meta one, two;
+        bool good_one{read_meta(0, one)}, good_two{read_meta(1, two)};
+        if (!good_one && !good_two){
+            ::close(fd);
+            fd = -1;
+            throw DISK_ERROR::corrupt_exception();
+        }
+        meta = good_one && (!good_two || one.commits >= two.commits) ? one : two;
+
+        //pages past the commit's are from a commit that never finished
+        const off_t size{static_cast<off_t>(meta.pages) * static_cast<off_t>(PAGE)};
+        if (info.st_size < size){
+            ::close(fd);
+            fd = -1;
+            throw DISK_ERROR::corrupt_exception();
+        }
+        if (info.st_size > size && ftruncate(fd, size))
+            throw DISK_ERROR::write_exception();
+    }
+    remap();
+    read_free_list();
+}
+
+//commit, unmap and close
+void Pager::close()
+{
+    if (fd < 0)
+        return;
+    commit();
+    if (map)
+        munmap(map, static_cast<size_t>(mapped) * PAGE);
+    ::close(fd);
+    fd = -1;
+    map = nullptr;
+    mapped = 0;
+    pool.clear();
+    fresh.clear();
+    spare.clear();
+    freed.clear();
+    listing.clear();
+}
+
+bool Pager::is_open() const
+{
+    return fd >= 0;
+}
+
+//the pool's copy of a changed page, the mapping's otherwise
+const char* Pager::read(page_id id) const
+{
+    auto found{pool.find(id)};
+    if (found != pool.end())
+        return found -> second -> bytes;
+    return map + static_cast<size_t>(id) * PAGE;
+}
+
+//pages written since the last commit are changed where they are,
+//any other is copied to a new page and let go
+char* Pager::write(page_id &id)
+{
+    changed = true;
+    if (fresh.count(id))
+        return frame(id).bytes;
+    page_id copy{allocate()};
+    memcpy(pool[copy] -> bytes, read(id), PAGE);
+    release(id);
+    id = copy;
+    return pool[copy] -> bytes;
+}
+
+//a free page if the last commit left one, else a page past the end
+page_id Pager::allocate()
+{
+    changed = true;
+    page_id id;
+    if (!spare.empty()){
+        id = spare.back();
+        spare.pop_back();
+    }
+    else
+        id = meta.pages++;
+    fresh.insert(id);
+    pool[id] = std::make_unique<Frame>();
+    return id;
+}
+
+//a page written since the last commit is free at once, one the last commit
+//reaches is free once the next commit is made
+void Pager::release(page_id id)
+{
+    changed = true;
+    if (fresh.erase(id)){
+        pool.erase(id);
+        spare.push_back(id);
+    }
+    else
+        freed.push_back(id);
+}
+
+page_id Pager::root() const
+{
+    return meta.root;
+}
+
+void Pager::set_root(page_id id)
+{
+    changed = true;
+    meta.root = id;
+}
+
+long Pager::entries() const
+{
+    return meta.entries;
+}
+
+void Pager::set_entries(long count)
+{
+    changed = true;
+    meta.entries = count;
+}
+
+//write the free list and every changed page and sync, then the meta page
+//the last commit's is not written over, and sync again
+void Pager::commit()
+{
+    if (fd < 0 || !changed)
+        return;
+
+    //the last commit's free list is only reachable from the last commit now
+    freed.insert(freed.end(), listing.begin(), listing.end());
+    vector<page_id> list{spare};
+    list.insert(list.end(), freed.begin(), freed.end());
+
+    //<uint32 NEXT><uint32 COUNT><PAGE>... on pages past the end, so no free page is used
+    const size_t per{(PAGE - 2 * sizeof(uint32_t)) / sizeof(page_id)};
+    vector<page_id> chain;
+    for (size_t i{}; i < list.size(); i += per)
+        chain.push_back(meta.pages++);
+    for (size_t n{}; n < chain.size(); ++n){
+        auto &page{pool[chain[n]]};
+        page = std::make_unique<Frame>();
+        uint32_t next{n + 1 < chain.size() ? chain[n + 1] : 0};
+        uint32_t count{static_cast<uint32_t>(std::min(per, list.size() - n * per))};
+        memcpy(page -> bytes, &next, sizeof(next));
+        memcpy(page -> bytes + sizeof(next), &count, sizeof(count));
+        memcpy(page -> bytes + 2 * sizeof(uint32_t), &list[n * per], count * sizeof(page_id));
+    }
+    flush();
+    if (fdatasync(fd))
+        throw DISK_ERROR::write_exception();
+
+    meta.free_list = chain.empty() ? 0 : chain[0];
+    ++meta.commits;
+    meta.checksum = checksum(meta);
+    Frame page{};
+    memcpy(page.bytes, &meta, sizeof(meta));
+    write_page(meta.commits % 2, page.bytes);
+    if (fdatasync(fd))
+        throw DISK_ERROR::write_exception();
+
+    spare = std::move(list);
+    freed.clear();
+    fresh.clear();
+    listing = std::move(chain);
+    changed = false;
+    remap();
+}
+
+//write the pool out once it is over capacity, the pages stay fresh
+//and are read back through the mapping
+void Pager::trim()
+{
+    if (static_cast<int>(pool.size()) <= capacity)
+        return;
+    flush();
+    remap();
+}
+
+long Pager::pages() const
+{
+    return meta.pages;
+}
+
+int Pager::pooled() const
+{
+    return static_cast<int>(pool.size());
+}
+
+//pages of the mapping the kernel has in memory
+long Pager::resident() const
+{
+    if (!map)
+        return 0;
+    const size_t system{static_cast<size_t>(sysconf(_SC_PAGESIZE))};
+    const size_t length{static_cast<size_t>(mapped) * PAGE};
+    vector<unsigned char> in((length + system - 1) / system);
+    if (mincore(map, length, in.data()))
+        return 0;
+    long count{};
+    for (unsigned char page : in)
+        count += page & 1;
+    return count * static_cast<long>(system) / static_cast<long>(PAGE);
+}
+
+//the pool's copy of a fresh page, read back from the mapping if it was written out
+Pager::Frame& Pager::frame(page_id id)
+{
+    auto &page{pool[id]};
+    if (!page){
+        page = std::make_unique<Frame>();
+        memcpy(page -> bytes, map + static_cast<size_t>(id) * PAGE, PAGE);
+    }
+    return *page;
+}
+
+//write every pooled page, in file order
+void Pager::flush()
+{
+    vector<page_id> ids;
+    ids.reserve(pool.size());
+    for (const auto &[id, page] : pool)
+        ids.push_back(id);
+    std::sort(ids.begin(), ids.end());
+    for (page_id id : ids)
+        write_page(id, pool[id] -> bytes);
+    pool.clear();
+}
+
+//map every page up to the end of the tree, pages allocated and freed again before
+//they were written leave the file short of it
+void Pager::remap()
+{
+    if (meta.pages == mapped)
+        return;
+    const off_t size{static_cast<off_t>(meta.pages) * static_cast<off_t>(PAGE)};
+    struct stat info;
+    if (fstat(fd, &info) || (info.st_size < size && ftruncate(fd, size)))
+        throw DISK_ERROR::write_exception();
+    if (map)
+        munmap(map, static_cast<size_t>(mapped) * PAGE);
+    void *mapping{mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0)};
+    if (mapping == MAP_FAILED){
+        map = nullptr;
+        mapped = 0;
+        throw DISK_ERROR::open_exception();
+    }
+    //lookups jump around the file, reading ahead would mostly read pages not wanted
+    madvise(mapping, size, MADV_RANDOM);
+    map = static_cast<char*>(mapping);
+    mapped = meta.pages;
+}
+
+//the commit's free pages, from its chain of free list pages
+void Pager::read_free_list()
+{
+    spare.clear();
+    listing.clear();
+    for (page_id id{meta.free_list}; id && id < meta.pages && listing.size() < meta.pages; ){
+        const char *page{read(id)};
+        listing.push_back(id);
+        uint32_t count{std::min<uint32_t>(u32(page + sizeof(uint32_t)), (PAGE - 8) / sizeof(page_id))};
+        for (uint32_t i{}; i < count; ++i)
+            spare.push_back(u32(page + 2 * sizeof(uint32_t) + i * sizeof(page_id)));
+        id = u32(page);
+    }
+}
+
+//meta page 'slot' if it is whole and checks out
+bool Pager::read_meta(int slot, Meta &out) const
+{
+    if (pread(fd, &out, sizeof(out), static_cast<off_t>(slot) * PAGE) != sizeof(out))
+        return false;
+    return out.magic == MAGIC && out.checksum == checksum(out) && out.pages >= 2 && out.root < out.pages;
+}
+
+//write one whole page at its place in the file
+void Pager::write_page(page_id id, const char *bytes)
+{
+    size_t written{};
+    while (written < PAGE){
+        ssize_t count{pwrite(fd, bytes + written, PAGE - written, static_cast<off_t>(id) * PAGE + written)};
+        if (count < 0)
+            throw DISK_ERROR::write_exception();
+        written += count;
+    }
+}
+
+//32 bit FNV-1a of everything before the checksum
+uint32_t Pager::checksum(const Meta &meta)
+{
+    const unsigned char *bytes{reinterpret_cast<const unsigned char*>(&meta)};
+    uint32_t hash{2166136261u};
+    for (size_t i{}; i < offsetof(Meta, checksum); ++i){
+        hash ^= bytes[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/*
+ *********************************************************************
+ * Disk_Index
+ * data members are:
+ *      Pager pager;
+ *********************************************************************
+ */
+
+void Disk_Index::open(const string &filename, int pool)
+{
+    pager.open(filename, pool);
+}
+
+void Disk_Index::close()
+{
+    pager.close();
+}
+
+bool Disk_Index::is_open() const
+{
+    return pager.is_open();
+}
+
+void Disk_Index::commit()
+{
+    pager.commit();
+}
+
+int Disk_Index::size() const
+{
+    return static_cast<int>(pager.entries());
+}
+
+//one page a level, a binary search on each
+bool Disk_Index::get(string_view key, string_view &value) const
+{
+    page_id id{pager.root()};
+    while (id){
+        const char *page{pager.read(id)};
+        if (header(page).leaf){
+            int i{lower(page, key)};
+            if (i == header(page).count || key_at(page, i) != key)
+                return false;
+            value = value_at(page, i);
+            return true;
+        }
+        id = child_at(page, below(page, key));
+    }
+    return false;
+}
+
+//a new root is made when the old one splits
+bool Disk_Index::put(string_view key, string_view value, bool replace)
+{
+    if (key.size() + value.size() > MAX_RECORD)
+        throw DISK_ERROR::record_exception();
+    string_view held;
+    const bool there{get(key, held)};
+    if (there && !replace)
+        return false;
+    if (there)
+        erase(key);
+
+    page_id root{pager.root()};
+    if (!root){
+        root = pager.allocate();
+        fill(pager.write(root), true, 0, {}, 0, 0);
+    }
+    Split split;
+    root = insert(root, key, value, split);
+    if (split.right){
+        page_id top{pager.allocate()};
+        char *page{pager.write(top)};
+        fill(page, false, root, {}, 0, 0);
+        place(page, 0, branch_record(split.right, split.separator));
+        root = top;
+    }
+    pager.set_root(root);
+    pager.set_entries(pager.entries() + 1);
+    pager.trim();
+    return !there;
+}
+
+//a root left with one page below it is dropped for that page
+bool Disk_Index::erase(string_view key)
+{
+    string_view held;
+    if (!get(key, held))
+        return false;
+    bool emptied{};
+    page_id root{remove(pager.root(), key, emptied)};
+    if (emptied)
+        root = 0;
+    while (root){
+        const char *page{pager.read(root)};
+        if (header(page).leaf || header(page).count)
+            break;
+        page_id only{header(page).first};
+        pager.release(root);
+        root = only;
+    }
+    pager.set_root(root);
+    pager.set_entries(pager.entries() - 1);
+    pager.trim();
+    return true;
+}
+
+void Disk_Index::scan(string_view low, const visitor &visit) const
+{
+    if (pager.root())
+        scan(pager.root(), low, visit);
+}
+
+int Disk_Index::height() const
+{
+    int levels{};
+    for (page_id id{pager.root()}; id; ++levels){
+        const char *page{pager.read(id)};
+        if (header(page).leaf)
+            id = 0;
+        else
+            id = header(page).first;
+    }
+    return levels;
+}
+
+const Pager& Disk_Index::pages() const
+{
+    return pager;
+}
+
+//insert below page 'id' and return where the page is now (a changed page is a copy)
+page_id Disk_Index::insert(page_id id, string_view key, string_view value, Split &split)
+{
+    char *page{pager.write(id)};
+    vector<string> list;
+    if (header(page).leaf){
+        int i{lower(page, key)};
+        string record{leaf_record(key, value)};
+        if (!place(page, i, record)){
+            records(page, list);
+            list.insert(list.begin() + i, record);
+            halve(pager, page, list, i, split.right, split.separator);
+        }
+        return id;
+    }
+
+    int c{below(page, key)};
+    Split under;
+    set_child(page, c, insert(child_at(page, c), key, value, under));
+    if (under.right){
+        string record{branch_record(under.right, under.separator)};
+        if (!place(page, c + 1, record)){
+            records(page, list);
+            list.insert(list.begin() + c + 1, record);
+            halve(pager, page, list, c + 1, split.right, split.separator);
+        }
+    }
+    return id;
+}
+
+//remove 'key' (which is there) below page 'id' and return where the page is now
+//a page left empty is freed and 'emptied' set, its parent drops the record for it
+page_id Disk_Index::remove(page_id id, string_view key, bool &emptied)
+{
+    char *page{pager.write(id)};
+    if (header(page).leaf){
+        drop(page, lower(page, key));
+        emptied = !header(page).count;
+    }
+    else{
+        int c{below(page, key)};
+        bool gone{};
+        page_id moved{remove(child_at(page, c), key, gone)};
+        emptied = false;
+        if (!gone)
+            set_child(page, c, moved);
+        else if (c >= 0)
+            drop(page, c);
+        else if (header(page).count){
+            //the second page becomes the first, its key is no longer needed
+            set_child(page, -1, child_at(page, 0));
+            drop(page, 0);
+        }
+        else
+            emptied = true;
+    }
+    if (emptied)
+        pager.release(id);
+    return id;
+}
+
+//visit from 'low' on below page 'id', false once visit has had enough
+bool Disk_Index::scan(page_id id, string_view low, const visitor &visit) const
+{
+    const char *page{pager.read(id)};
+    const int count{header(page).count};
+    if (header(page).leaf){
+        for (int i{lower(page, low)}; i < count; ++i)
+            if (!visit(key_at(page, i), value_at(page, i)))
+                return false;
+        return true;
+    }
+    for (int i{below(page, low)}; i < count; ++i)
+        if (!scan(child_at(page, i), low, visit))
+            return false;
+    return true;
+}
+
+/*
+ *********************************************************************
+ * DATA on disk
+ *********************************************************************
+ */
+
+void to_bytes(const string &text, string &out)
+{
+    out += text;
+}
+
+bool from_bytes(string_view bytes, string &text)
+{
+    text.assign(bytes.data(), bytes.size());
+    return true;
+}
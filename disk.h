@@ -0,0 +1,275 @@
+/*
+ *********************************************************************
+ * Ian Leuty
+ * inleuty@gmail.com
+ * 10/19/2026
+ *********************************************************************
+ * disk tree declaration
+ *********************************************************************
+ * An ordered index kept in a file, for archives of past events too
+ * big to hold as Nodes. Disk_Tree<DATA> has the lookups of a Red_Black
+ * keyed by string, reading only the pages a lookup or scan touches.
+ *
+ * The file is a B+ tree of PAGE byte pages. Leaves hold the keys and
+ * their DATA (as bytes, see to_bytes), branches hold separator keys
+ * (cut to the shortest prefix that still separates) and the pages
+ * below them. Pages are slotted: a sorted array of offsets at the
+ * front, records packed at the back.
+ *
+ * The file is mapped read only and pages are read straight from the
+ * mapping, so the kernel's page cache holds whatever part of the tree
+ * is in use. Changed pages live in a buffer pool and are written out
+ * when the pool fills and on commit.
+ *
+ * Writes are copy on write: a page reachable from the last commit is
+ * never written over, a change copies it (and the pages above it up
+ * to the root) to free pages. commit writes the new pages, syncs,
+ * then writes the new root into whichever of the two meta pages
+ * (pages 0 and 1) holds the older commit and syncs again. On open the
+ * newest meta page with a good checksum wins, so a crash at any point
+ * leaves the last commit as it was. Pages freed by a commit are kept
+ * in a list of free pages written with it and reused after it.
+ *
+ * Pages are not merged when removals leave them less than full, only
+ * freed once empty: an archive mostly grows.
+ *********************************************************************
+ */
+
+#ifndef DISK
+#define DISK
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "structures.h"
+
+//exceptions related to the disk tree
+struct DISK_ERROR
+{
+    struct open_exception{
+        std::string msg{"\nFailed to open the archive.\n"};
+    };
+
+    struct corrupt_exception{
+        std::string msg{"\nThe archive is not a tree file or is damaged.\n"};
+    };
+
+    struct record_exception{
+        std::string msg{"\nA key and its data are too large for one page.\n"};
+    };
+
+    struct write_exception{
+        std::string msg{"\nFailed to write to the archive.\n"};
+    };
+};
+
+//page numbers in the file, 0 (a meta page) stands for no page
+typedef uint32_t page_id;
+
+//the file, its mapping, the buffer pool of changed pages and the free pages
+class Pager
+{
+    public:
+        static const size_t PAGE{4096};
+
+        Pager();
+        ~Pager();
+        Pager(const Pager &) = delete;
+        Pager& operator=(const Pager &) = delete;
+
+        //open (or create) 'filename', 'pool' is how many changed pages are held
+        //before they are written out. throws open_exception or corrupt_exception
+        void open(const std::string &filename, int pool);
+
+        //commit and let the file go
+        void close();
+        bool is_open() const;
+
+        //a page to read, valid until the next change
+        const char* read(page_id id) const;
+
+        //a page to change: a page reachable from the last commit is copied first
+        //and 'id' is set to the copy. valid until the next change to a page
+        char* write(page_id &id);
+
+        //a new page of zeros, already changeable through write
+        page_id allocate();
+
+        //the page is no longer part of the tree
+        void release(page_id id);
+
+        page_id root() const;
+        void set_root(page_id id);
+        long entries() const;
+        void set_entries(long count);
+
+        //make every change so far durable, throws write_exception
+        void commit();
+
+        //write changed pages out if the pool holds more than it should
+        //called between changes, never while a page pointer is in use
+        void trim();
+
+        //pages in the file, pages in the pool, and pages of the mapping in memory
+        long pages() const;
+        int pooled() const;
+        long resident() const;
+
+    private:
+        struct Frame
+        {
+            alignas(16) char bytes[PAGE];
+        };
+
+        //one of the two pages every commit alternates between
+        struct Meta
+        {
+            uint64_t magic;
+            uint64_t commits;
+            int64_t entries;
+            page_id root;
+            page_id pages;
+            page_id free_list;
+            uint32_t checksum;
+        };
+
+        int fd;
+        char *map;
+        page_id mapped;             //pages the mapping covers
+        Meta meta;                  //the tree as of now, commits is the last commit's
+        bool changed;
+        int capacity;
+
+        std::unordered_map<page_id, std::unique_ptr<Frame>> pool;  //changed pages not yet written
+        std::unordered_set<page_id> fresh;                          //written since the last commit
+        std::vector<page_id> spare;                                 //free as of the last commit
+        std::vector<page_id> freed;                                 //reachable from the last commit only
+        std::vector<page_id> listing;                               //the last commit's free list
+
+        Frame& frame(page_id id);
+        void flush();
+        void remap();
+        void read_free_list();
+        bool read_meta(int slot, Meta &out) const;
+        void write_page(page_id id, const char *bytes);
+        static uint32_t checksum(const Meta &meta);
+};
+
+//the B+ tree over a Pager, keys and values are bytes
+class Disk_Index
+{
+    public:
+        //largest key plus value, so a split page always fits both halves
+        static const size_t MAX_RECORD{(Pager::PAGE - 16) / 4 - 8};
+
+        //see Pager::open
+        void open(const std::string &filename, int pool);
+        void close();
+        bool is_open() const;
+        void commit();
+
+        int size() const;
+
+        //the value at 'key', nothing if it is absent. the view lasts until the next change
+        bool get(std::string_view key, std::string_view &value) const;
+
+        //add 'key' or, when 'replace' is set, write over it
+        //false if 'key' was there (and was left alone unless 'replace')
+        bool put(std::string_view key, std::string_view value, bool replace);
+        bool erase(std::string_view key);
+
+        //visit(key, value) from the first key not less than 'low' on, until it returns false
+        typedef std::function<bool(std::string_view key, std::string_view value)> visitor;
+        void scan(std::string_view low, const visitor &visit) const;
+
+        //pages of the tree and of the file, see Pager
+        int height() const;
+        const Pager& pages() const;
+
+    private:
+        Pager pager;
+
+        //a page that split: its new right sibling and the key between them
+        struct Split
+        {
+            page_id right{};
+            std::string separator;
+        };
+
+        page_id insert(page_id id, std::string_view key, std::string_view value, Split &split);
+        page_id remove(page_id id, std::string_view key, bool &emptied);
+        bool scan(page_id id, std::string_view low, const visitor &visit) const;
+};
+
+//what a DATA is on disk, its bytes unless overloaded (like heap_usage, overloads
+//go beside the type for argument dependent lookup). from_bytes is false on bad bytes
+template<typename T>
+void to_bytes(const T &data, std::string &out);
+template<typename T>
+bool from_bytes(std::string_view bytes, T &data);
+
+void to_bytes(const std::string &text, std::string &out);
+bool from_bytes(std::string_view bytes, std::string &text);
+
+template<typename DATA>
+class Disk_Tree
+{
+    public:
+        Disk_Tree();
+
+        //open (or create) the tree in 'filename', see Pager::open
+        explicit Disk_Tree(const std::string &filename, int pool = POOL);
+        void open(const std::string &filename, int pool = POOL);
+
+        //commit and close, the destructor does the same
+        void close();
+        bool is_open() const;
+
+        //make every change so far durable, throws DISK_ERROR::write_exception
+        void commit();
+
+        //the Red_Black lookups, DATA are read back from the page into a copy
+        //insert throws TREE_ERROR::duplicate_name_exception, retrieve not_found_exception
+        //and both throw DISK_ERROR::record_exception for a record too large for a page
+        int size() const;
+        bool insert(const std::string &key, const DATA &data);
+        bool find(const std::string &key) const;
+        std::optional<DATA> lookup(const std::string &key) const;
+        DATA retrieve(const std::string &key) const;
+        bool remove(const std::string &key);
+
+        //insert, or write over what 'key' held. true if it was new
+        bool assign(const std::string &key, const DATA &data);
+
+        //as Red_Black's, reading the leaves in order from the first one needed
+        int fetch_first(int k, std::vector<std::string> &keys, std::vector<DATA> &data) const;
+        int fetch_range(const std::string &low, const std::string &high, int k,
+                        std::vector<std::string> &keys, std::vector<DATA> &data) const;
+        int prefix_search(const std::string &prefix, int k, std::vector<std::string> &keys, std::vector<DATA> &data) const;
+        template<typename VISIT> void for_each(VISIT &&visit) const;
+
+        //levels of pages, pages in the file, and how many of them are in memory
+        int height() const;
+        long pages() const;
+        long resident() const;
+
+        //changed pages held before they are written out (16 MB)
+        static const int POOL{4096};
+
+    private:
+        Disk_Index index;
+        std::string bytes;
+
+        void encode(const DATA &data);
+        static DATA decode(std::string_view value);
+};
+
+#include "disk.tpp"
+
+#endif
@@ -0,0 +1,227 @@
+/*
+ *********************************************************************
+ * Ian Leuty
+ * inleuty@gmail.com
+ * 10/19/2026
+ *********************************************************************
+ * disk tree template definition
+ *********************************************************************
+ */
+
+//a trivially copyable DATA is its own bytes
+template<typename T>
+void to_bytes(const T &data, std::string &out)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "this DATA needs a to_bytes overload");
+    out.append(reinterpret_cast<const char*>(&data), sizeof(data));
+}
+
+template<typename T>
+bool from_bytes(std::string_view bytes, T &data)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "this DATA needs a from_bytes overload");
+    if (bytes.size() != sizeof(data))
+        return false;
+    memcpy(&data, bytes.data(), sizeof(data));
+    return true;
+}
+
+/*
+ *********************************************************************
+ * disk tree template
+ * data members are:
+ *      Disk_Index index;
+ *      std::string bytes;
+ *********************************************************************
+ */
+
+//default constructor, open before use
+template<typename DATA>
+Disk_Tree<DATA>::Disk_Tree() {}
+
+template<typename DATA>
+Disk_Tree<DATA>::Disk_Tree(const std::string &filename, int pool)
+{
+    open(filename, pool);
+}
+
+template<typename DATA>
+void Disk_Tree<DATA>::open(const std::string &filename, int pool)
+{
+    index.open(filename, pool);
+}
+
+template<typename DATA>
+void Disk_Tree<DATA>::close()
+{
+    index.close();
+}
+
+template<typename DATA>
+bool Disk_Tree<DATA>::is_open() const
+{
+    return index.is_open();
+}
+
+template<typename DATA>
+void Disk_Tree<DATA>::commit()
+{
+    index.commit();
+}
+
+template<typename DATA>
+int Disk_Tree<DATA>::size() const
+{
+    return index.size();
+}
+
+//add 'key', throws if it is already there
+template<typename DATA>
+bool Disk_Tree<DATA>::insert(const std::string &key, const DATA &data)
+{
+    encode(data);
+    if (!index.put(key, bytes, false))
+        throw TREE_ERROR::duplicate_name_exception();
+    return true;
+}
+
+template<typename DATA>
+bool Disk_Tree<DATA>::find(const std::string &key) const
+{
+    std::string_view value;
+    return index.get(key, value);
+}
+
+//a copy of the DATA at 'key' or nothing
+template<typename DATA>
+std::optional<DATA> Disk_Tree<DATA>::lookup(const std::string &key) const
+{
+    std::string_view value;
+    if (!index.get(key, value))
+        return std::nullopt;
+    return decode(value);
+}
+
+//a copy of the DATA at 'key', throws if it is not there
+template<typename DATA>
+DATA Disk_Tree<DATA>::retrieve(const std::string &key) const
+{
+    std::string_view value;
+    if (!index.get(key, value))
+        throw TREE_ERROR::not_found_exception();
+    return decode(value);
+}
+
+template<typename DATA>
+bool Disk_Tree<DATA>::remove(const std::string &key)
+{
+    return index.erase(key);
+}
+
+template<typename DATA>
+bool Disk_Tree<DATA>::assign(const std::string &key, const DATA &data)
+{
+    encode(data);
+    return index.put(key, bytes, true);
+}
+
+//the first 'k' KEYs and DATA
+template<typename DATA>
+int Disk_Tree<DATA>::fetch_first(int k, std::vector<std::string> &keys, std::vector<DATA> &data) const
+{
+    keys.clear();
+    data.clear();
+    if (k <= 0)
+        return 0;
+    index.scan("", [&](std::string_view key, std::string_view value){
+        keys.emplace_back(key);
+        data.push_back(decode(value));
+        return static_cast<int>(keys.size()) < k;
+    });
+    return static_cast<int>(keys.size());
+}
+
+//at most 'k' KEYs and DATA in [low, high)
+template<typename DATA>
+int Disk_Tree<DATA>::fetch_range(const std::string &low, const std::string &high, int k,
+                                 std::vector<std::string> &keys, std::vector<DATA> &data) const
+{
+    keys.clear();
+    data.clear();
+    if (!(low < high) || k <= 0)
+        return 0;
+    const std::string_view end{high};
+    index.scan(low, [&](std::string_view key, std::string_view value){
+        if (!(key < end))
+            return false;
+        keys.emplace_back(key);
+        data.push_back(decode(value));
+        return static_cast<int>(keys.size()) < k;
+    });
+    return static_cast<int>(keys.size());
+}
+
+//at most 'k' KEYs and DATA that start with 'prefix'
+template<typename DATA>
+int Disk_Tree<DATA>::prefix_search(const std::string &prefix, int k, std::vector<std::string> &keys, std::vector<DATA> &data) const
+{
+    keys.clear();
+    data.clear();
+    if (k <= 0)
+        return 0;
+    index.scan(prefix, [&](std::string_view key, std::string_view value){
+        if (key.substr(0, prefix.size()) != prefix)
+            return false;
+        keys.emplace_back(key);
+        data.push_back(decode(value));
+        return static_cast<int>(keys.size()) < k;
+    });
+    return static_cast<int>(keys.size());
+}
+
+//visit(KEY, DATA) on every entry in sorted order, each read back into a copy
+//nothing may be changed from inside visit
+template<typename DATA>
+template<typename VISIT>
+void Disk_Tree<DATA>::for_each(VISIT &&visit) const
+{
+    index.scan("", [&visit](std::string_view key, std::string_view value){
+        visit(std::string(key), decode(value));
+        return true;
+    });
+}
+
+template<typename DATA>
+int Disk_Tree<DATA>::height() const
+{
+    return index.height();
+}
+
+template<typename DATA>
+long Disk_Tree<DATA>::pages() const
+{
+    return index.pages().pages();
+}
+
+template<typename DATA>
+long Disk_Tree<DATA>::resident() const
+{
+    return index.pages().resident();
+}
+
+//the bytes of 'data' into 'bytes', reused so a put allocates nothing once it is warm
+template<typename DATA>
+void Disk_Tree<DATA>::encode(const DATA &data)
+{
+    bytes.clear();
+    to_bytes(data, bytes);
+}
+
+template<typename DATA>
+DATA Disk_Tree<DATA>::decode(std::string_view value)
+{
+    DATA data{};
+    if (!from_bytes(value, data))
+        throw DISK_ERROR::corrupt_exception();
+    return data;
+}
@@ -0,0 +1,129 @@
+/*
+ *********************************************************************
+ * Ian Leuty
+ * inleuty@gmail.com
+ * 10/19/2026
+ *********************************************************************
+ * flat red black tree declaration
+ *********************************************************************
+ * The left leaning red black tree of structures.h for arithmetic KEYs
+ * (bib numbers, chip ids, timestamps), which compare in one
+ * instruction and own nothing.
+ *
+ * Nodes live in one array and name their children by 32 bit index
+ * instead of owning them through unique_ptrs, so an int to int node
+ * is 20 bytes instead of 32 (48 once malloc has rounded it up and
+ * added its header) and the tree is one allocation. Removed
+ * nodes are kept on a list of free slots and reused by the next
+ * insert.
+ *
+ * A lookup picks the child to go to by indexing the pair of children
+ * with the result of one compare, and remembers the last node it did
+ * not go right of with a conditional move: no branch on the keys, so
+ * no mispredicted branch per level. It walks to the bottom every time
+ * and checks the one candidate there.
+ *
+ * Copying the tree copies the array. For a trivially copyable node
+ * (arithmetic DATA too) that is one memcpy.
+ *
+ * Tree_For<KEY, DATA> is this tree for an arithmetic KEY and Red_Black
+ * for any other, for code that only needs what both offer.
+ *********************************************************************
+ */
+
+#ifndef FLAT
+#define FLAT
+
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include "structures.h"
+
+template<typename KEY, typename DATA>
+class Flat_Red_Black
+{
+    static_assert(std::is_arithmetic<KEY>::value, "Flat_Red_Black is for arithmetic KEYs, use Red_Black");
+
+    public:
+        Flat_Red_Black();
+        Flat_Red_Black(const Flat_Red_Black &source);
+        Flat_Red_Black(Flat_Red_Black &&source) noexcept;
+        Flat_Red_Black& operator=(const Flat_Red_Black &source);
+        Flat_Red_Black& operator=(Flat_Red_Black &&source) noexcept;
+
+        int size() const;
+        bool empty() const;
+
+        //room for 'count' entries in the array, so inserting that many never moves it
+        void reserve(int count);
+
+        //the Red_Black methods of the same names
+        //insert throws TREE_ERROR::duplicate_name_exception, retrieve not_found_exception
+        bool insert(const KEY &key, const DATA &data);
+        std::pair<DATA*, bool> try_insert(const KEY &key, const DATA &data);
+        bool find(const KEY &key) const;
+        DATA* find_ptr(const KEY &key);
+        const DATA* find_ptr(const KEY &key) const;
+        std::optional<DATA> lookup(const KEY &key) const;
+        DATA& retrieve(const KEY &key);
+        bool remove(const KEY &key);
+        int remove_all();
+
+        int fetch_keys(std::vector<KEY> &keys) const;
+        int fetch_range(const KEY &low, const KEY &high, int k, std::vector<KEY> &keys, std::vector<DATA> &data) const;
+        template<typename VISIT> void for_each(VISIT &&visit) const;
+
+        //the array of nodes, free slots included, and what the DATA own
+        void account(Memory &nodes, Memory &keys, Memory &data) const;
+        int height() const;
+
+    private:
+        //no child, and the end of the free list
+        static const uint32_t NIL{0xffffffff};
+
+        //children are [0] left and [1] right, a free slot links the next one through [0]
+        struct Flat_Node
+        {
+            KEY key;
+            DATA data;
+            uint32_t child[2];
+            Color color;
+        };
+
+        std::vector<Flat_Node> nodes;
+        uint32_t root;
+        uint32_t spare;             //first free slot
+        int count;
+
+        void make_copy(const Flat_Red_Black &source);
+        uint32_t locate(const KEY &key) const;
+        uint32_t allocate(const KEY &key, const DATA &data);
+        void release(uint32_t id);
+
+        uint32_t insert(uint32_t root, const KEY &key, const DATA &data, uint32_t &placed);
+        uint32_t remove(uint32_t root, const KEY &key);
+        uint32_t remove_min(uint32_t root, uint32_t &smallest);
+        int fetch_keys(uint32_t root, std::vector<KEY> &keys) const;
+        int fetch_range(uint32_t root, const KEY &low, const KEY &high, int k, std::vector<KEY> &keys, std::vector<DATA> &data) const;
+        template<typename VISIT> void for_each(uint32_t root, VISIT &visit) const;
+        int height(uint32_t root) const;
+
+        //insert and removal helpers, as Red_Black's
+        uint32_t rotate_left(uint32_t id);
+        uint32_t rotate_right(uint32_t id);
+        uint32_t red_left(uint32_t id);
+        uint32_t red_right(uint32_t id);
+        uint32_t fixup(uint32_t id);
+        void flip_colors(uint32_t id);
+        bool is_red(uint32_t id) const;
+        bool is_red(uint32_t id, int side) const;
+};
+
+//an ordered index of KEY to DATA, flat when KEY is arithmetic
+template<typename KEY, typename DATA>
+using Tree_For = typename std::conditional<std::is_arithmetic<KEY>::value,
+                                           Flat_Red_Black<KEY, DATA>, Red_Black<KEY, DATA>>::type;
+
+#include "flat.tpp"
+
+#endif
@@ -0,0 +1,509 @@
+/*
+ *********************************************************************
+ * Ian Leuty
+ * inleuty@gmail.com
+ * 10/19/2026
+ *********************************************************************
+ * flat red black tree template definition
+ *********************************************************************
+ */
+
+/*
+ *********************************************************************
+ * flat red black tree template
+ * data members are:
+ *      std::vector<Flat_Node> nodes;
+ *      uint32_t root;
+ *      uint32_t spare;
+ *      int count;
+ *********************************************************************
+ */
+
+//default constructor
+template<typename KEY, typename DATA>
+Flat_Red_Black<KEY, DATA>::Flat_Red_Black() : root(NIL), spare(NIL), count(0) {}
+
+//copy constructor
+template<typename KEY, typename DATA>
+Flat_Red_Black<KEY, DATA>::Flat_Red_Black(const Flat_Red_Black &source) : root(NIL), spare(NIL), count(0)
+{
+    make_copy(source);
+}
+
+//move constructor, takes the source's array
+template<typename KEY, typename DATA>
+Flat_Red_Black<KEY, DATA>::Flat_Red_Black(Flat_Red_Black &&source) noexcept :
+    nodes(std::move(source.nodes)), root(source.root), spare(source.spare), count(source.count)
+{
+    source.nodes.clear();
+    source.root = source.spare = NIL;
+    source.count = 0;
+}
+
+//overloaded assignment operator
+template<typename KEY, typename DATA>
+Flat_Red_Black<KEY, DATA>& Flat_Red_Black<KEY, DATA>::operator=(const Flat_Red_Black &source)
+{
+    if (this != &source)
+        make_copy(source);
+    return *this;
+}
+
+//move assignment operator
+template<typename KEY, typename DATA>
+Flat_Red_Black<KEY, DATA>& Flat_Red_Black<KEY, DATA>::operator=(Flat_Red_Black &&source) noexcept
+{
+    if (this == &source)
+        return *this;
+    nodes = std::move(source.nodes);
+    root = source.root;
+    spare = source.spare;
+    count = source.count;
+    source.nodes.clear();
+    source.root = source.spare = NIL;
+    source.count = 0;
+    return *this;
+}
+
+//copy function used by assignment operator and copy constructor
+//the children are indices, so the array is copied as it is, free slots and all:
+//one memcpy for a trivially copyable node instead of one allocation per node
+template<typename KEY, typename DATA>
+void Flat_Red_Black<KEY, DATA>::make_copy(const Flat_Red_Black &source)
+{
+    if constexpr (std::is_trivially_copyable<Flat_Node>::value){
+        nodes.clear();
+        nodes.resize(source.nodes.size());
+        if (!nodes.empty())
+            memcpy(nodes.data(), source.nodes.data(), nodes.size() * sizeof(Flat_Node));
+    }
+    else
+        nodes = source.nodes;
+    root = source.root;
+    spare = source.spare;
+    count = source.count;
+}
+
+template<typename KEY, typename DATA>
+int Flat_Red_Black<KEY, DATA>::size() const
+{
+    return count;
+}
+
+template<typename KEY, typename DATA>
+bool Flat_Red_Black<KEY, DATA>::empty() const
+{
+    return count == 0;
+}
+
+template<typename KEY, typename DATA>
+void Flat_Red_Black<KEY, DATA>::reserve(int count)
+{
+    nodes.reserve(count);
+}
+
+//insert wrapper, throws if key is already there
+template<typename KEY, typename DATA>
+bool Flat_Red_Black<KEY, DATA>::insert(const KEY &key, const DATA &data)
+{
+    if (!try_insert(key, data).second)
+        throw TREE_ERROR::duplicate_name_exception();
+    return true;
+}
+
+//the DATA at key and whether it was just inserted, an existing entry is left alone
+template<typename KEY, typename DATA>
+std::pair<DATA*, bool> Flat_Red_Black<KEY, DATA>::try_insert(const KEY &key, const DATA &data)
+{
+    const int before{count};
+    uint32_t placed{NIL};
+    root = insert(root, key, data, placed);
+    nodes[root].color = Color::BLACK;
+    return {&nodes[placed].data, count != before};
+}
+
+template<typename KEY, typename DATA>
+bool Flat_Red_Black<KEY, DATA>::find(const KEY &key) const
+{
+    return locate(key) != NIL;
+}
+
+template<typename KEY, typename DATA>
+DATA* Flat_Red_Black<KEY, DATA>::find_ptr(const KEY &key)
+{
+    const uint32_t id{locate(key)};
+    return id == NIL ? nullptr : &nodes[id].data;
+}
+
+template<typename KEY, typename DATA>
+const DATA* Flat_Red_Black<KEY, DATA>::find_ptr(const KEY &key) const
+{
+    const uint32_t id{locate(key)};
+    return id == NIL ? nullptr : &nodes[id].data;
+}
+
+template<typename KEY, typename DATA>
+std::optional<DATA> Flat_Red_Black<KEY, DATA>::lookup(const KEY &key) const
+{
+    const uint32_t id{locate(key)};
+    if (id == NIL)
+        return std::nullopt;
+    return nodes[id].data;
+}
+
+template<typename KEY, typename DATA>
+DATA& Flat_Red_Black<KEY, DATA>::retrieve(const KEY &key)
+{
+    const uint32_t id{locate(key)};
+    if (id == NIL)
+        throw TREE_ERROR::not_found_exception();
+    return nodes[id].data;
+}
+
+//the node holding 'key', NIL if it is not present
+//goes left at every key not less than 'key' and remembers the last of them, the
+//smallest key not less than 'key', so the only compare a branch depends on is the last
+template<typename KEY, typename DATA>
+uint32_t Flat_Red_Black<KEY, DATA>::locate(const KEY &key) const
+{
+    const Flat_Node *array{nodes.data()};
+    uint32_t at{root}, candidate{NIL};
+    while (at != NIL){
+        const Flat_Node &node{array[at]};
+        const bool right{node.key < key};
+        candidate = right ? candidate : at;
+        at = node.child[right];
+    }
+    if (candidate != NIL && key < array[candidate].key)
+        return NIL;
+    return candidate;
+}
+
+//a slot for a new red node, a free one if there is one
+template<typename KEY, typename DATA>
+uint32_t Flat_Red_Black<KEY, DATA>::allocate(const KEY &key, const DATA &data)
+{
+    ++count;
+    if (spare != NIL){
+        const uint32_t id{spare};
+        Flat_Node &node{nodes[id]};
+        spare = node.child[0];
+        node.key = key;
+        node.data = data;
+        node.child[0] = node.child[1] = NIL;
+        node.color = Color::RED;
+        return id;
+    }
+    if (nodes.size() >= NIL)
+        throw std::length_error("Flat_Red_Black is full");
+    nodes.push_back(Flat_Node{key, data, {NIL, NIL}, Color::RED});
+    return static_cast<uint32_t>(nodes.size() - 1);
+}
+
+//put a removed node on the free list, letting go of what its DATA owns
+template<typename KEY, typename DATA>
+void Flat_Red_Black<KEY, DATA>::release(uint32_t id)
+{
+    --count;
+    nodes[id].data = DATA{};
+    nodes[id].child[0] = spare;
+    spare = id;
+}
+
+//insert recursive, returns the subtree's new top
+//'placed' is set to the node holding key. an allocation can move the array,
+//so no reference to a node is held across the recursive call
+template<typename KEY, typename DATA>
+uint32_t Flat_Red_Black<KEY, DATA>::insert(uint32_t root, const KEY &key, const DATA &data, uint32_t &placed)
+{
+    //reached the insert point, a new red node
+    if (root == NIL)
+        return placed = allocate(key, data);
+
+    const int side{nodes[root].key < key};
+    if (side || key < nodes[root].key){
+        const uint32_t below{insert(nodes[root].child[side], key, data, placed)};
+        nodes[root].child[side] = below;
+    }
+    //already here, leave the existing data alone
+    else
+        placed = root;
+
+    //the same three fixes on the way back up as Red_Black's insert
+    return fixup(root);
+}
+
+//remove wrapper
+template<typename KEY, typename DATA>
+bool Flat_Red_Black<KEY, DATA>::remove(const KEY &key)
+{
+    //the removal below assumes the key is present
+    if (locate(key) == NIL)
+        return false;
+
+    //if both of root's children are black, make root red so there is a red to move down
+    if (!is_red(root, 0) && !is_red(root, 1))
+        nodes[root].color = Color::RED;
+    root = remove(root, key);
+    if (root != NIL)
+        nodes[root].color = Color::BLACK;
+    return true;
+}
+
+//remove recursive, as Red_Black's: the successor is spliced in where the node was
+template<typename KEY, typename DATA>
+uint32_t Flat_Red_Black<KEY, DATA>::remove(uint32_t root, const KEY &key)
+{
+    if (key < nodes[root].key){
+        if (nodes[root].child[0] == NIL)
+            return root;
+
+        //if left and left's left are black, move a red to the left
+        if (!is_red(root, 0) && !is_red(nodes[root].child[0], 0))
+            root = red_left(root);
+        const uint32_t left{remove(nodes[root].child[0], key)};
+        nodes[root].child[0] = left;
+    }
+
+    else{
+        if (is_red(root, 0))
+            root = rotate_right(root);
+
+        //a match with no right subtree
+        if (!(nodes[root].key < key) && nodes[root].child[1] == NIL){
+            release(root);
+            return NIL;
+        }
+
+        if (!is_red(root, 1) && !is_red(nodes[root].child[1], 0))
+            root = red_right(root);
+
+        if (!(nodes[root].key < key)){
+            uint32_t smallest{NIL};
+            const uint32_t right{remove_min(nodes[root].child[1], smallest)};
+            Flat_Node &successor{nodes[smallest]};
+            successor.child[0] = nodes[root].child[0];
+            successor.child[1] = right;
+            successor.color = nodes[root].color;
+            release(root);
+            root = smallest;
+        }
+        else{
+            const uint32_t right{remove(nodes[root].child[1], key)};
+            nodes[root].child[1] = right;
+        }
+    }
+
+    return fixup(root);
+}
+
+//detach the smallest node below 'root' into 'smallest'
+template<typename KEY, typename DATA>
+uint32_t Flat_Red_Black<KEY, DATA>::remove_min(uint32_t root, uint32_t &smallest)
+{
+    if (nodes[root].child[0] == NIL){
+        smallest = root;
+        return nodes[root].child[1];
+    }
+
+    if (!is_red(root, 0) && !is_red(nodes[root].child[0], 0))
+        root = red_left(root);
+    const uint32_t left{remove_min(nodes[root].child[0], smallest)};
+    nodes[root].child[0] = left;
+    return fixup(root);
+}
+
+//clear the tree, the array keeps its capacity
+template<typename KEY, typename DATA>
+int Flat_Red_Black<KEY, DATA>::remove_all()
+{
+    const int removed{count};
+    nodes.clear();
+    root = spare = NIL;
+    count = 0;
+    return removed;
+}
+
+template<typename KEY, typename DATA>
+int Flat_Red_Black<KEY, DATA>::fetch_keys(std::vector<KEY> &keys) const
+{
+    keys.clear();
+    keys.reserve(count);
+    return fetch_keys(root, keys);
+}
+
+template<typename KEY, typename DATA>
+int Flat_Red_Black<KEY, DATA>::fetch_keys(uint32_t root, std::vector<KEY> &keys) const
+{
+    if (root == NIL)
+        return 0;
+    int fetched{fetch_keys(nodes[root].child[0], keys)};
+    keys.push_back(nodes[root].key);
+    return fetched + 1 + fetch_keys(nodes[root].child[1], keys);
+}
+
+//at most 'k' KEYs and DATA in [low, high) in sorted order
+template<typename KEY, typename DATA>
+int Flat_Red_Black<KEY, DATA>::fetch_range(const KEY &low, const KEY &high, int k, std::vector<KEY> &keys, std::vector<DATA> &data) const
+{
+    keys.clear();
+    data.clear();
+    if (!(low < high) || k <= 0)
+        return 0;
+    return fetch_range(root, low, high, k, keys, data);
+}
+
+//recursive fetch_range, skips the subtrees entirely outside the range
+template<typename KEY, typename DATA>
+int Flat_Red_Black<KEY, DATA>::fetch_range(uint32_t root, const KEY &low, const KEY &high, int k,
+                                           std::vector<KEY> &keys, std::vector<DATA> &data) const
+{
+    if (root == NIL || static_cast<int>(keys.size()) >= k)
+        return 0;
+    const Flat_Node &node{nodes[root]};
+    int fetched{};
+    if (low < node.key)
+        fetched += fetch_range(node.child[0], low, high, k, keys, data);
+    if (static_cast<int>(keys.size()) < k && !(node.key < low) && node.key < high){
+        keys.push_back(node.key);
+        data.push_back(node.data);
+        ++fetched;
+    }
+    if (node.key < high)
+        fetched += fetch_range(node.child[1], low, high, k, keys, data);
+    return fetched;
+}
+
+//call visit(KEY, DATA) on every entry in sorted order
+template<typename KEY, typename DATA>
+template<typename VISIT>
+void Flat_Red_Black<KEY, DATA>::for_each(VISIT &&visit) const
+{
+    for_each(root, visit);
+}
+
+template<typename KEY, typename DATA>
+template<typename VISIT>
+void Flat_Red_Black<KEY, DATA>::for_each(uint32_t root, VISIT &visit) const
+{
+    if (root == NIL)
+        return;
+    for_each(nodes[root].child[0], visit);
+    visit(nodes[root].key, nodes[root].data);
+    for_each(nodes[root].child[1], visit);
+}
+
+//the array is one allocation, keys own nothing
+template<typename KEY, typename DATA>
+void Flat_Red_Black<KEY, DATA>::account(Memory &nodes, Memory &, Memory &data) const
+{
+    if (this -> nodes.capacity())
+        nodes.allocation(this -> nodes.capacity() * sizeof(Flat_Node), this -> nodes.data());
+    for_each([&data](const KEY &, const DATA &entry){
+        heap_usage(entry, data);
+    });
+}
+
+template<typename KEY, typename DATA>
+int Flat_Red_Black<KEY, DATA>::height() const
+{
+    return height(root);
+}
+
+template<typename KEY, typename DATA>
+int Flat_Red_Black<KEY, DATA>::height(uint32_t root) const
+{
+    if (root == NIL)
+        return 0;
+    return 1 + std::max(height(nodes[root].child[0]), height(nodes[root].child[1]));
+}
+
+//rotate 'id' and its right child one turn left, the right child comes up
+template<typename KEY, typename DATA>
+uint32_t Flat_Red_Black<KEY, DATA>::rotate_left(uint32_t id)
+{
+    Flat_Node &node{nodes[id]};
+    const uint32_t up{node.child[1]};
+    Flat_Node &temp{nodes[up]};
+    node.child[1] = temp.child[0];
+    temp.child[0] = id;
+    temp.color = node.color;
+    node.color = Color::RED;
+    return up;
+}
+
+//rotate 'id' and its left child one turn right, the left child comes up
+template<typename KEY, typename DATA>
+uint32_t Flat_Red_Black<KEY, DATA>::rotate_right(uint32_t id)
+{
+    Flat_Node &node{nodes[id]};
+    const uint32_t up{node.child[0]};
+    Flat_Node &temp{nodes[up]};
+    node.child[0] = temp.child[1];
+    temp.child[1] = id;
+    temp.color = node.color;
+    node.color = Color::RED;
+    return up;
+}
+
+//move the red pointer left (used on deletion)
+template<typename KEY, typename DATA>
+uint32_t Flat_Red_Black<KEY, DATA>::red_left(uint32_t id)
+{
+    flip_colors(id);
+    if (is_red(nodes[id].child[1], 0)){
+        nodes[id].child[1] = rotate_right(nodes[id].child[1]);
+        id = rotate_left(id);
+        flip_colors(id);
+    }
+    return id;
+}
+
+//move the red pointer right (used on deletion)
+template<typename KEY, typename DATA>
+uint32_t Flat_Red_Black<KEY, DATA>::red_right(uint32_t id)
+{
+    flip_colors(id);
+    if (is_red(nodes[id].child[0], 0)){
+        id = rotate_right(id);
+        flip_colors(id);
+    }
+    return id;
+}
+
+//restore the left leaning rules on the way back up from an insert or removal
+template<typename KEY, typename DATA>
+uint32_t Flat_Red_Black<KEY, DATA>::fixup(uint32_t id)
+{
+    if (is_red(id, 1) && !is_red(id, 0))
+        id = rotate_left(id);
+    if (is_red(id, 0) && is_red(nodes[id].child[0], 0))
+        id = rotate_right(id);
+    if (is_red(id, 0) && is_red(id, 1))
+        flip_colors(id);
+    return id;
+}
+
+//invert the colors of a node and its children
+template<typename KEY, typename DATA>
+void Flat_Red_Black<KEY, DATA>::flip_colors(uint32_t id)
+{
+    Flat_Node &node{nodes[id]};
+    node.color = node.color == Color::RED ? Color::BLACK : Color::RED;
+    for (uint32_t below : node.child)
+        if (below != NIL)
+            nodes[below].color = nodes[below].color == Color::RED ? Color::BLACK : Color::RED;
+}
+
+template<typename KEY, typename DATA>
+bool Flat_Red_Black<KEY, DATA>::is_red(uint32_t id) const
+{
+    return id != NIL && nodes[id].color == Color::RED;
+}
+
+//is the child on 'side' of 'id' red, false when there is no 'id'
+template<typename KEY, typename DATA>
+bool Flat_Red_Black<KEY, DATA>::is_red(uint32_t id, int side) const
+{
+    return id != NIL && is_red(nodes[id].child[side]);
+}
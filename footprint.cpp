@@ -0,0 +1,96 @@
+/*
+ *********************************************************************
+ * Ian Leuty
+ * inleuty@gmail.com
+ * 10/19/2026
+ *********************************************************************
+ * memory accounting definition
+ *********************************************************************
+ */
+
+#include <algorithm>
+#include <iomanip>
+#include <malloc.h>
+#include "footprint.h"
+
+using namespace std;
+
+//glibc chunk header and alignment
+static const size_t CHUNK_HEADER{sizeof(size_t)};
+static const size_t CHUNK_ALIGN{16};
+static const size_t CHUNK_MINIMUM{32};
+
+//capacity of a string that has not gone to the heap
+static const size_t SMALL_STRING{std::string().capacity()};
+
+/*
+ *********************************************************************
+ * Memory
+ * data members are:
+ *      long objects;
+ *      long requested;
+ *      long allocated;
+ *      long inline_strings;
+ *      long heap_strings;
+ *********************************************************************
+ */
+
+//count one block, a known block is measured rather than worked out
+void Memory::allocation(size_t bytes, const void *block)
+{
+    ++objects;
+    requested += bytes;
+    if (block)
+        allocated += malloc_usable_size(const_cast<void*>(block)) + CHUNK_HEADER;
+    else
+        allocated += max(CHUNK_MINIMUM, (bytes + CHUNK_HEADER + CHUNK_ALIGN - 1) & ~(CHUNK_ALIGN - 1));
+}
+
+//a string's own bytes are wherever it lives, only its heap buffer is counted here
+void Memory::string(const std::string &text)
+{
+    if (text.capacity() <= SMALL_STRING){
+        ++inline_strings;
+        return;
+    }
+    ++heap_strings;
+    allocation(text.capacity() + 1, text.data());
+}
+
+//bytes the allocator used beyond what was asked for
+long Memory::overhead() const
+{
+    return allocated - requested;
+}
+
+//add another part's usage
+Memory& Memory::operator+=(const Memory &other)
+{
+    objects += other.objects;
+    requested += other.requested;
+    allocated += other.allocated;
+    inline_strings += other.inline_strings;
+    heap_strings += other.heap_strings;
+    return *this;
+}
+
+//column headings for print_usage
+void print_usage_header(ostream &out, const std::string &per)
+{
+    out << left << setw(24) << "" << right << setw(12) << "blocks" << setw(14) << "requested"
+        << setw(14) << "allocated" << setw(12) << "overhead" << setw(12) << per << "\n";
+}
+
+//one row of a footprint report, the last column is allocated bytes per 'per'
+void print_usage(ostream &out, const std::string &label, const Memory &usage, long per)
+{
+    out << left << setw(24) << label << right << setw(12) << usage.objects << setw(14) << usage.requested
+        << setw(14) << usage.allocated << setw(12) << usage.overhead() << setw(12) << fixed << setprecision(1)
+        << (per ? static_cast<double>(usage.allocated) / per : 0.0) << defaultfloat << "\n";
+}
+
+//a string key or DATA owns its heap buffer
+void heap_usage(const std::string &text, Memory &usage)
+{
+    usage.string(text);
+}
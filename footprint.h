@@ -0,0 +1,59 @@
+/*
+ *********************************************************************
+ * Ian Leuty
+ * inleuty@gmail.com
+ * 10/19/2026
+ *********************************************************************
+ * memory accounting declaration
+ *********************************************************************
+ * Memory adds up what part of the registry costs: the bytes asked of
+ * the allocator, the bytes it really used (glibc rounds every block
+ * up to 16 and adds an 8 byte header, 32 bytes at least) and how many
+ * strings fit in their small string buffer versus the heap.
+ *
+ * heap_usage reports what a KEY or DATA owns beyond its own bytes
+ * (which are part of its Node). Types that own nothing need nothing,
+ * others add an overload that argument dependent lookup can find.
+ *********************************************************************
+ */
+
+#ifndef FOOTPRINT
+#define FOOTPRINT
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+
+//make_shared puts the object right after its control block:
+//a vtable pointer and the use and weak counts (libstdc++)
+const size_t SHARED_CONTROL{sizeof(void*) + 2 * sizeof(int)};
+
+struct Memory
+{
+    long objects{};
+    long requested{};
+    long allocated{};
+    long inline_strings{};
+    long heap_strings{};
+
+    //one block of 'bytes', measured with malloc_usable_size when the block is known
+    void allocation(size_t bytes, const void *block = nullptr);
+
+    //the heap buffer of 'text', if it outgrew its small string buffer
+    void string(const std::string &text);
+
+    long overhead() const;
+    Memory& operator+=(const Memory &other);
+};
+
+//"<label> <objects> <requested> <allocated> <overhead> <allocated / per>"
+void print_usage(std::ostream &out, const std::string &label, const Memory &usage, long per);
+void print_usage_header(std::ostream &out, const std::string &per);
+
+//heap owned by a KEY or DATA, nothing unless overloaded
+template<typename T>
+void heap_usage(const T &, Memory &) {}
+
+void heap_usage(const std::string &text, Memory &usage);
+
+#endif
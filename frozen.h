@@ -0,0 +1,104 @@
+/*
+ *********************************************************************
+ * Ian Leuty
+ * inleuty@gmail.com
+ * 10/19/2026
+ *********************************************************************
+ * frozen name index declaration
+ *********************************************************************
+ * A read-only copy of a Red_Black tree with string keys, for once
+ * registration closes and the names stop changing. It answers the
+ * same lookups (find, rank, ranges, prefixes) from three arrays.
+ *
+ * The names are front coded in one block of text, in sorted order and
+ * in buckets of BUCKET names. Every name is stored as the number of
+ * leading characters it shares with the name before it, the number
+ * that follow and those characters, the first of a bucket sharing
+ * nothing. A run of "Sarah Chen 1..." costs a few bytes a name.
+ *
+ * Above the text each bucket keeps where it starts and the first 8
+ * bytes of its first name as one big endian integer. A lookup binary
+ * searches those integers (comparing whole names only among buckets
+ * whose first 8 bytes tie), then reads one bucket front to back,
+ * comparing only the characters a name does not share with the one
+ * before it. The DATA are kept in an array in the same order.
+ *********************************************************************
+ */
+
+#ifndef FROZEN
+#define FROZEN
+
+#include <string_view>
+#include "structures.h"
+
+template<typename DATA>
+class Frozen
+{
+    public:
+        Frozen();
+
+        //copy every entry of 'source', which is left as it was
+        template<typename AUG> explicit Frozen(const Red_Black<std::string, DATA, AUG> &source);
+
+        int size() const;
+        bool empty() const;
+        void clear();
+
+        //the Red_Black lookups, reading instead of walking nodes
+        //retrieve throws TREE_ERROR::not_found_exception
+        bool find(const std::string &key) const;
+        const DATA* find_ptr(const std::string &key) const;
+        std::optional<DATA> lookup(const std::string &key) const;
+        const DATA& retrieve(const std::string &key) const;
+
+        //'rank' is the number of keys less than 'key', 'select' the DATA at a sorted position
+        int rank(const std::string &key) const;
+        const DATA& select(int index) const;
+        std::string key(int index) const;
+
+        //as Red_Black's, O(log n + k) with no tree to walk
+        int fetch_keys(std::vector<std::string> &keys) const;
+        int fetch_first(int k, std::vector<std::string> &keys, std::vector<DATA> &data) const;
+        int fetch_range(const std::string &low, const std::string &high, int k,
+                        std::vector<std::string> &keys, std::vector<DATA> &data) const;
+        int prefix_search(const std::string &prefix, int k, std::vector<std::string> &keys, std::vector<DATA> &data) const;
+
+        //how many keys start with 'prefix', O(log n)
+        int matches(const std::string &prefix) const;
+
+        //call visit(KEY, DATA) on every entry in sorted order
+        template<typename VISIT> void for_each(VISIT &&visit) const;
+
+        //the bucket index and DATA array, the text of the keys and what the DATA own
+        void account(Memory &index, Memory &keys, Memory &data) const;
+
+        static const int BUCKET{16};
+
+    private:
+        std::string text;
+        std::vector<uint32_t> offsets;      //where each bucket starts in 'text'
+        std::vector<uint64_t> heads;        //first 8 bytes of each bucket's first key
+        std::vector<DATA> entries;
+
+        void add(const std::string &key, const std::string &last);
+        std::string_view head(int bucket) const;
+        int bucket(const std::string &key) const;
+        int seek(const std::string &key, bool &found) const;
+        template<typename VISIT> void walk(int first, int last, VISIT &visit) const;
+
+        static uint64_t prefix(std::string_view key);
+        static void put(std::string &out, size_t value);
+        static size_t get(const char *&next);
+};
+
+//the frozen copy of 'source'
+template<typename DATA, typename AUG>
+Frozen<DATA> freeze(const Red_Black<std::string, DATA, AUG> &source);
+
+//the frozen copy of 'source', which is emptied once it is made
+template<typename DATA, typename AUG>
+Frozen<DATA> freeze(Red_Black<std::string, DATA, AUG> &&source);
+
+#include "frozen.tpp"
+
+#endif
@@ -0,0 +1,406 @@
+/*
+ *********************************************************************
+ * Ian Leuty
+ * inleuty@gmail.com
+ * 10/19/2026
+ *********************************************************************
+ * frozen name index template definition
+ *********************************************************************
+ */
+
+/*
+ *********************************************************************
+ * frozen template
+ * data members are:
+ *      std::string text;
+ *      std::vector<uint32_t> offsets;
+ *      std::vector<uint64_t> heads;
+ *      std::vector<DATA> entries;
+ *********************************************************************
+ */
+
+//empty, for before registration closes
+template<typename DATA>
+Frozen<DATA>::Frozen() {}
+
+//front code every key of 'source' in sorted order and copy its DATA beside them
+template<typename DATA>
+template<typename AUG>
+Frozen<DATA>::Frozen(const Red_Black<std::string, DATA, AUG> &source)
+{
+    entries.reserve(source.size());
+    offsets.reserve(source.size() / BUCKET + 1);
+    heads.reserve(source.size() / BUCKET + 1);
+    std::string last;
+    source.for_each([this, &last](const std::string &key, const DATA &data){
+        add(key, last);
+        entries.push_back(data);
+        last = key;
+    });
+    text.shrink_to_fit();
+}
+
+template<typename DATA>
+int Frozen<DATA>::size() const
+{
+    return static_cast<int>(entries.size());
+}
+
+template<typename DATA>
+bool Frozen<DATA>::empty() const
+{
+    return entries.empty();
+}
+
+//let everything go, as if never frozen
+template<typename DATA>
+void Frozen<DATA>::clear()
+{
+    std::string().swap(text);
+    std::vector<uint32_t>().swap(offsets);
+    std::vector<uint64_t>().swap(heads);
+    std::vector<DATA>().swap(entries);
+}
+
+template<typename DATA>
+bool Frozen<DATA>::find(const std::string &key) const
+{
+    bool found;
+    seek(key, found);
+    return found;
+}
+
+//the DATA at 'key' or nullptr
+template<typename DATA>
+const DATA* Frozen<DATA>::find_ptr(const std::string &key) const
+{
+    bool found;
+    int index{seek(key, found)};
+    return found ? &entries[index] : nullptr;
+}
+
+//a copy of the DATA at 'key' or nothing
+template<typename DATA>
+std::optional<DATA> Frozen<DATA>::lookup(const std::string &key) const
+{
+    if (const DATA *data = find_ptr(key))
+        return *data;
+    return std::nullopt;
+}
+
+//the DATA at 'key', throws if it is not there
+template<typename DATA>
+const DATA& Frozen<DATA>::retrieve(const std::string &key) const
+{
+    if (const DATA *data = find_ptr(key))
+        return *data;
+    throw TREE_ERROR::not_found_exception();
+}
+
+//number of keys less than 'key'
+template<typename DATA>
+int Frozen<DATA>::rank(const std::string &key) const
+{
+    bool found;
+    return seek(key, found);
+}
+
+//DATA at a 0 based sorted position, throws past the end
+template<typename DATA>
+const DATA& Frozen<DATA>::select(int index) const
+{
+    if (index < 0 || index >= size())
+        throw TREE_ERROR::not_found_exception();
+    return entries[index];
+}
+
+//the key at a 0 based sorted position, decoded from the start of its bucket
+template<typename DATA>
+std::string Frozen<DATA>::key(int index) const
+{
+    if (index < 0 || index >= size())
+        throw TREE_ERROR::not_found_exception();
+    std::string found;
+    auto keep = [&found](const std::string &key, const DATA &){
+        found = key;
+        return false;
+    };
+    walk(index, index + 1, keep);
+    return found;
+}
+
+//every key in sorted order
+template<typename DATA>
+int Frozen<DATA>::fetch_keys(std::vector<std::string> &keys) const
+{
+    keys.clear();
+    keys.reserve(size());
+    auto keep = [&keys](const std::string &key, const DATA &){
+        keys.push_back(key);
+        return true;
+    };
+    walk(0, size(), keep);
+    return size();
+}
+
+//the first 'k' KEYs and DATA
+template<typename DATA>
+int Frozen<DATA>::fetch_first(int k, std::vector<std::string> &keys, std::vector<DATA> &data) const
+{
+    keys.clear();
+    data.clear();
+    auto keep = [&keys, &data](const std::string &key, const DATA &entry){
+        keys.push_back(key);
+        data.push_back(entry);
+        return true;
+    };
+    walk(0, std::min(k, size()), keep);
+    return static_cast<int>(keys.size());
+}
+
+//at most 'k' KEYs and DATA in [low, high)
+template<typename DATA>
+int Frozen<DATA>::fetch_range(const std::string &low, const std::string &high, int k,
+                              std::vector<std::string> &keys, std::vector<DATA> &data) const
+{
+    keys.clear();
+    data.clear();
+    if (!(low < high) || k <= 0)
+        return 0;
+    auto keep = [&](const std::string &key, const DATA &entry){
+        if (!(key < high))
+            return false;
+        keys.push_back(key);
+        data.push_back(entry);
+        return static_cast<int>(keys.size()) < k;
+    };
+    walk(rank(low), size(), keep);
+    return static_cast<int>(keys.size());
+}
+
+//at most 'k' KEYs and DATA that start with 'prefix'
+template<typename DATA>
+int Frozen<DATA>::prefix_search(const std::string &prefix, int k, std::vector<std::string> &keys, std::vector<DATA> &data) const
+{
+    keys.clear();
+    data.clear();
+    if (k <= 0)
+        return 0;
+    auto keep = [&](const std::string &key, const DATA &entry){
+        if (key.compare(0, prefix.size(), prefix) != 0)
+            return false;
+        keys.push_back(key);
+        data.push_back(entry);
+        return static_cast<int>(keys.size()) < k;
+    };
+    walk(rank(prefix), size(), keep);
+    return static_cast<int>(keys.size());
+}
+
+//keys starting with 'prefix' are the ones from its rank up to the rank of the
+//smallest string past them: the prefix with its last character not 0xff raised by one
+template<typename DATA>
+int Frozen<DATA>::matches(const std::string &prefix) const
+{
+    std::string past{prefix};
+    while (!past.empty() && static_cast<unsigned char>(past.back()) == 0xff)
+        past.pop_back();
+    if (past.empty())
+        return size() - rank(prefix);
+    ++past.back();
+    return rank(past) - rank(prefix);
+}
+
+//visit every entry, in sorted order
+template<typename DATA>
+template<typename VISIT>
+void Frozen<DATA>::for_each(VISIT &&visit) const
+{
+    auto every = [&visit](const std::string &key, const DATA &data){
+        visit(key, data);
+        return true;
+    };
+    walk(0, size(), every);
+}
+
+//add up the arrays, the text and what the DATA own
+template<typename DATA>
+void Frozen<DATA>::account(Memory &index, Memory &keys, Memory &data) const
+{
+    if (offsets.capacity())
+        index.allocation(offsets.capacity() * sizeof(uint32_t), offsets.data());
+    if (heads.capacity())
+        index.allocation(heads.capacity() * sizeof(uint64_t), heads.data());
+    if (entries.capacity())
+        index.allocation(entries.capacity() * sizeof(DATA), entries.data());
+    if (text.capacity())
+        keys.allocation(text.capacity() + 1, text.data());
+    for (const auto &entry : entries)
+        heap_usage(entry, data);
+}
+
+//append 'key', which follows 'last', starting a new bucket every BUCKET keys
+template<typename DATA>
+void Frozen<DATA>::add(const std::string &key, const std::string &last)
+{
+    size_t shared{};
+    if (entries.size() % BUCKET == 0){
+        offsets.push_back(static_cast<uint32_t>(text.size()));
+        heads.push_back(prefix(key));
+    }
+    else
+        while (shared < key.size() && shared < last.size() && key[shared] == last[shared])
+            ++shared;
+    put(text, shared);
+    put(text, key.size() - shared);
+    text.append(key, shared, std::string::npos);
+}
+
+//the first key of a bucket, stored whole
+template<typename DATA>
+std::string_view Frozen<DATA>::head(int bucket) const
+{
+    const char *next{text.data() + offsets[bucket]};
+    get(next);
+    size_t length{get(next)};
+    return std::string_view(next, length);
+}
+
+//the last bucket whose first key is not greater than 'key', -1 if there is none
+//buckets whose first 8 bytes are less or greater than the key's are passed over on the
+//integers alone, the whole first keys are only read for the ones that tie
+template<typename DATA>
+int Frozen<DATA>::bucket(const std::string &key) const
+{
+    const uint64_t first{prefix(key)};
+    int low = std::lower_bound(heads.begin(), heads.end(), first) - heads.begin();
+    int high = std::upper_bound(heads.begin() + low, heads.end(), first) - heads.begin();
+    const std::string_view wanted{key};
+    while (low < high){
+        int middle{low + (high - low) / 2};
+        if (wanted < head(middle))
+            high = middle;
+        else
+            low = middle + 1;
+    }
+    return low - 1;
+}
+
+//rank of the first key not less than 'key', 'found' if it is 'key'
+//every key read so far is less than 'key' and 'match' is how many characters the last
+//one shares with it. The next key shares 'shared' with the last one: more than 'match'
+//and it is less too, fewer and it is greater, the same and only its own characters
+//need comparing
+template<typename DATA>
+int Frozen<DATA>::seek(const std::string &key, bool &found) const
+{
+    found = false;
+    int first{bucket(key)};
+    if (first < 0)
+        return 0;
+    const char *next{text.data() + offsets[first]};
+    const int last{std::min(size(), (first + 1) * BUCKET)};
+    const size_t wanted{key.size()};
+    size_t match{};
+    for (int index{first * BUCKET}; index < last; ++index){
+        size_t shared{get(next)};
+        size_t length{get(next)};
+        const char *suffix{next};
+        next += length;
+        if (shared > match)
+            continue;
+        if (shared < match)
+            return index;
+        size_t same{};
+        while (same < length && match + same < wanted && suffix[same] == key[match + same])
+            ++same;
+        match += same;
+        if (same == length){
+            if (match == wanted){
+                found = true;
+                return index;
+            }
+            continue;
+        }
+        if (match == wanted || static_cast<unsigned char>(suffix[same]) > static_cast<unsigned char>(key[match]))
+            return index;
+    }
+    return last;
+}
+
+//decode the keys from the start of the bucket holding 'first' and call
+//visit(key, data) on those in [first, last) until it returns false
+template<typename DATA>
+template<typename VISIT>
+void Frozen<DATA>::walk(int first, int last, VISIT &visit) const
+{
+    if (first >= last)
+        return;
+    const char *next{text.data() + offsets[first / BUCKET]};
+    std::string key;
+    for (int index{first / BUCKET * BUCKET}; index < last; ++index){
+        size_t shared{get(next)};
+        size_t length{get(next)};
+        key.resize(shared);
+        key.append(next, length);
+        next += length;
+        if (index >= first && !visit(key, entries[index]))
+            return;
+    }
+}
+
+//the first 8 bytes of 'key' as a big endian integer, zero filled, so the
+//integers are in the same order as the keys (ties aside)
+template<typename DATA>
+uint64_t Frozen<DATA>::prefix(std::string_view key)
+{
+    uint64_t value{};
+    for (size_t i{}; i < sizeof(value); ++i)
+        value = value << 8 | (i < key.size() ? static_cast<unsigned char>(key[i]) : 0);
+    return value;
+}
+
+//7 bits a byte, low bits first, the high bit set on all but the last byte
+template<typename DATA>
+void Frozen<DATA>::put(std::string &out, size_t value)
+{
+    while (value >= 0x80){
+        out.push_back(static_cast<char>((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+template<typename DATA>
+size_t Frozen<DATA>::get(const char *&next)
+{
+    size_t value{};
+    int shift{};
+    unsigned char byte;
+    do{
+        byte = static_cast<unsigned char>(*next++);
+        value |= static_cast<size_t>(byte & 0x7f) << shift;
+        shift += 7;
+    } while (byte & 0x80);
+    return value;
+}
+
+/*
+ *********************************************************************
+ * freeze
+ *********************************************************************
+ */
+
+template<typename DATA, typename AUG>
+Frozen<DATA> freeze(const Red_Black<std::string, DATA, AUG> &source)
+{
+    return Frozen<DATA>(source);
+}
+
+template<typename DATA, typename AUG>
+Frozen<DATA> freeze(Red_Black<std::string, DATA, AUG> &&source)
+{
+    Frozen<DATA> frozen(source);
+    source.remove_all();
+    return frozen;
+}
@@ -0,0 +1,283 @@
+/*
+ *********************************************************************
+ * Ian Leuty
+ * inleuty@gmail.com
+ * 10/19/2026
+ *********************************************************************
+ * fuzzy name index definition
+ *********************************************************************
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include "fuzzy.h"
+
+using std::string, std::string_view, std::vector, std::pair, std::min;
+
+//pads the front and back of a name's trigrams
+static const uint32_t PAD{1};
+
+//lowercase ASCII, names match whatever their case
+static inline uint8_t fold(char c)
+{
+    return c >= 'A' && c <= 'Z' ? static_cast<uint8_t>(c | 0x20) : static_cast<uint8_t>(c);
+}
+
+/*
+ *********************************************************************
+ * Fuzzy_Index
+ * data members are:
+ *      std::string text;
+ *      std::vector<Span> spans;
+ *      int live;
+ *      std::unordered_map<uint32_t, std::vector<uint32_t>> postings;
+ *********************************************************************
+ */
+
+//constructor
+Fuzzy_Index::Fuzzy_Index() : live(0) {}
+
+//append the name to the text and put it on the list of each of its trigrams
+void Fuzzy_Index::insert(const string &name)
+{
+    if (name.empty())
+        return;
+    spans.push_back(Span{static_cast<uint32_t>(text.size()), static_cast<uint32_t>(name.size())});
+    text += name;
+    ++live;
+    add(static_cast<uint32_t>(spans.size() - 1));
+}
+
+//leave a hole where the name was, rebuilding once there are more holes than names
+bool Fuzzy_Index::remove(const string &name)
+{
+    if (name.empty())
+        return false;
+
+    //the name is on the list of every one of its trigrams, the shortest is quickest to search
+    vector<uint32_t> held;
+    grams(name, held);
+    const vector<uint32_t> *shortest{};
+    for (uint32_t gram : held){
+        auto list{postings.find(gram)};
+        if (list == postings.end())
+            return false;
+        if (!shortest || list -> second.size() < shortest -> size())
+            shortest = &list -> second;
+    }
+
+    for (uint32_t id : *shortest){
+        if (this -> name(id) == name){
+            spans[id].length = 0;
+            --live;
+            if (static_cast<int>(spans.size()) - live > live)
+                rebuild();
+            return true;
+        }
+    }
+    return false;
+}
+
+//forget every name
+void Fuzzy_Index::clear()
+{
+    text.clear();
+    spans.clear();
+    postings.clear();
+    live = 0;
+}
+
+//names indexed
+int Fuzzy_Index::size() const
+{
+    return live;
+}
+
+//merge the posting lists of the query's trigrams, skipping past names on too few of them,
+//and keep the names within 'distance' edits
+int Fuzzy_Index::search(const string &name, int k, vector<string> &names, vector<int> &distances, int distance) const
+{
+    names.clear();
+    distances.clear();
+    vector<uint32_t> wanted;
+    grams(name, wanted);
+    distance = min(distance, (static_cast<int>(wanted.size()) - 1) / 3);
+    if (k <= 0 || distance < 0 || name.empty())
+        return 0;
+
+    vector<const vector<uint32_t>*> lists;
+    for (uint32_t gram : wanted){
+        auto list{postings.find(gram)};
+        if (list != postings.end())
+            lists.push_back(&list -> second);
+    }
+    //a name within 'distance' edits is on all but 3 * distance of the query's lists
+    const size_t needed{wanted.size() - 3 * distance};
+    if (lists.size() < needed)
+        return 0;
+
+    //the span each list is at, END once it runs out. ids only grow, so every list is sorted
+    const uint32_t END{UINT32_MAX};
+    vector<uint32_t> heads(lists.size()), order(lists.size());
+    vector<size_t> at(lists.size());
+    //gallop forward, the next span wanted is rarely far along any list
+    auto advance = [&](size_t list, uint32_t to){
+        const auto &ids{*lists[list]};
+        size_t low{at[list]}, step{1};
+        while (low + step < ids.size() && ids[low + step] < to){
+            low += step;
+            step *= 2;
+        }
+        at[list] = std::lower_bound(ids.begin() + low, ids.begin() + min(low + step + 1, ids.size()), to) - ids.begin();
+        heads[list] = at[list] < ids.size() ? ids[at[list]] : END;
+    };
+    for (size_t list{}; list < lists.size(); ++list){
+        at[list] = 0;
+        heads[list] = lists[list] -> front();
+    }
+
+    vector<pair<int, string_view>> found;
+    for (;;){
+        //no span before the 'needed'th smallest head is on enough lists
+        order = heads;
+        std::nth_element(order.begin(), order.begin() + (needed - 1), order.end());
+        const uint32_t next{order[needed - 1]};
+        if (next == END)
+            break;
+        const uint32_t first{*std::min_element(order.begin(), order.begin() + needed)};
+        if (first != next){
+            for (size_t list{}; list < lists.size(); ++list)
+                if (heads[list] < next)
+                    advance(list, next);
+            continue;
+        }
+
+        //at least 'needed' lists are at the same span
+        string_view held{this -> name(next)};
+        int edits{edit_distance(name, held, distance)};
+        if (!held.empty() && edits <= distance)
+            found.emplace_back(edits, held);
+        for (size_t list{}; list < lists.size(); ++list)
+            if (heads[list] == next)
+                advance(list, next + 1);
+    }
+
+    const size_t kept{min(found.size(), static_cast<size_t>(k))};
+    std::partial_sort(found.begin(), found.begin() + kept, found.end());
+    for (size_t i{}; i < kept; ++i){
+        names.emplace_back(found[i].second);
+        distances.push_back(found[i].first);
+    }
+    return static_cast<int>(kept);
+}
+
+//two rows of the usual Levenshtein table, ignoring case
+//only cells within 'limit' of the diagonal can stay under it, so only they are filled in
+//(the rest count as too far), and once a whole row is past 'limit' no later row comes back
+int Fuzzy_Index::edit_distance(string_view a, string_view b, int limit)
+{
+    const int m{static_cast<int>(a.size())};
+    const int n{static_cast<int>(b.size())};
+    if (std::abs(m - n) > limit)
+        return limit + 1;
+    const int far{limit + 1};
+
+    //names fit on the stack, anything longer goes on the heap
+    int small[2][64];
+    vector<int> large;
+    int *row{small[0]}, *next{small[1]};
+    if (n + 2 > 64){
+        large.resize(2 * (n + 2));
+        row = large.data();
+        next = row + n + 2;
+    }
+
+    for (int j{}; j <= n + 1; ++j)
+        row[j] = j <= limit ? j : far;
+    for (int i{1}; i <= m; ++i){
+        const int low{std::max(1, i - limit)};
+        const int high{min(n, i + limit)};
+        next[low - 1] = low == 1 ? i : far;
+        int best{next[low - 1]};
+        const uint8_t letter{fold(a[i - 1])};
+        for (int j{low}; j <= high; ++j){
+            const int replace{row[j - 1] + (letter != fold(b[j - 1]))};
+            next[j] = min(min(row[j], next[j - 1]) + 1, replace);
+            best = min(best, next[j]);
+        }
+        next[high + 1] = far;
+        if (best > limit)
+            return far;
+        std::swap(row, next);
+    }
+    return min(row[n], far);
+}
+
+//the text, the spans and every posting list with its map node, plus the bucket array
+void Fuzzy_Index::account(Memory &usage) const
+{
+    if (text.capacity())
+        usage.allocation(text.capacity() + 1, text.data());
+    if (spans.capacity())
+        usage.allocation(spans.capacity() * sizeof(Span), spans.data());
+    for (const auto &[gram, list] : postings){
+        usage.allocation(sizeof(void*) + sizeof(std::pair<const uint32_t, vector<uint32_t>>) + sizeof(size_t));
+        if (list.capacity())
+            usage.allocation(list.capacity() * sizeof(uint32_t), list.data());
+    }
+    usage.allocation(postings.bucket_count() * sizeof(void*));
+}
+
+//a name's bytes, empty once it has been removed
+string_view Fuzzy_Index::name(uint32_t id) const
+{
+    return string_view(text.data() + spans[id].offset, spans[id].length);
+}
+
+//the distinct trigrams of a lowercased, padded name, each packed into 24 bits
+void Fuzzy_Index::grams(string_view name, vector<uint32_t> &out) const
+{
+    out.clear();
+    uint32_t window{PAD << 8 | PAD};
+    for (char c : name){
+        window = (window << 8 | fold(c)) & 0xFFFFFF;
+        out.push_back(window);
+    }
+    for (int i{}; i < 2; ++i){
+        window = (window << 8 | PAD) & 0xFFFFFF;
+        out.push_back(window);
+    }
+    std::sort(out.begin(), out.end());
+    out.erase(std::unique(out.begin(), out.end()), out.end());
+}
+
+//put span 'id' on the list of each of its trigrams
+void Fuzzy_Index::add(uint32_t id)
+{
+    vector<uint32_t> held;
+    grams(name(id), held);
+    for (uint32_t gram : held)
+        postings[gram].push_back(id);
+}
+
+//close the holes and index what is left again
+void Fuzzy_Index::rebuild()
+{
+    string kept;
+    kept.reserve(text.size());
+    vector<Span> moved;
+    moved.reserve(live);
+    for (const auto &span : spans){
+        if (!span.length)
+            continue;
+        moved.push_back(Span{static_cast<uint32_t>(kept.size()), span.length});
+        kept.append(text, span.offset, span.length);
+    }
+    text.swap(kept);
+    spans.swap(moved);
+
+    postings.clear();
+    for (uint32_t id{}; id < spans.size(); ++id)
+        add(id);
+}
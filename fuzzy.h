@@ -0,0 +1,83 @@
+/*
+ *********************************************************************
+ * Ian Leuty
+ * inleuty@gmail.com
+ * 10/19/2026
+ *********************************************************************
+ * fuzzy name index declaration
+ *********************************************************************
+ * Finds registered names within a few edits (insertions, deletions,
+ * substitutions) of a mistyped one without scanning every name.
+ *
+ * Each name is cut into trigrams, lowercased and padded so its first
+ * and last letters get their own ("\1\1a", "\1ab", ..., "z\1\1"), and
+ * every distinct trigram keeps a posting list of the names that have
+ * it. One edit breaks at most 3 of a name's trigrams, so a name within
+ * d edits of the query is on all but 3d of the query's posting lists.
+ * A search walks all of those lists together in id order, galloping
+ * each one forward past ids that fewer than (trigrams - 3d) lists can
+ * still hold, and checks only the names that reach that count with an
+ * edit distance that gives up past d.
+ *
+ * Names are kept in one block of text. A removed name leaves a hole
+ * that searches skip; once holes outnumber names the index is rebuilt.
+ *********************************************************************
+ */
+
+#ifndef FUZZY
+#define FUZZY
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "footprint.h"
+
+class Fuzzy_Index
+{
+    public:
+        Fuzzy_Index();
+
+        //index a name, the caller keeps names unique (the registry does)
+        void insert(const std::string &name);
+        bool remove(const std::string &name);
+        void clear();
+        int size() const;
+
+        //at most 'k' names within 'distance' edits of 'name', nearest first (ties by name)
+        //case is ignored. short names are searched with a smaller distance, since a
+        //name of n letters only has n + 2 trigrams to go on
+        int search(const std::string &name, int k, std::vector<std::string> &names,
+                   std::vector<int> &distances, int distance = MAX_DISTANCE) const;
+
+        //edits between 'a' and 'b' ignoring case, or limit + 1 if that is more than 'limit'
+        static int edit_distance(std::string_view a, std::string_view b, int limit);
+
+        //the text, spans and posting lists
+        void account(Memory &usage) const;
+
+        static const int MAX_DISTANCE{2};
+
+    private:
+        //where a name is in 'text', length 0 once removed
+        struct Span
+        {
+            uint32_t offset;
+            uint32_t length;
+        };
+
+        std::string text;
+        std::vector<Span> spans;
+        int live;
+
+        //trigram -> the spans holding it, in insertion order
+        std::unordered_map<uint32_t, std::vector<uint32_t>> postings;
+
+        std::string_view name(uint32_t id) const;
+        void grams(std::string_view name, std::vector<uint32_t> &out) const;
+        void add(uint32_t id);
+        void rebuild();
+};
+
+#endif
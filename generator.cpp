@@ -0,0 +1,262 @@
+/*
+ *********************************************************************
+ * Ian Leuty
+ * inleuty@gmail.com
+ * 10/19/2026
+ *********************************************************************
+ * synthetic roster generator definition
+ *********************************************************************
+ */
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <condition_variable>
+#include <mutex>
+#include <numeric>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include "generator.h"
+
+using std::string;
+
+//rows built per block, each block is one write
+static const long BLOCK_ROWS{1 << 15};
+
+//names are built from consonant-vowel syllables, listed in sorting order
+static const char CONSONANTS[]{"bdfgklmnprstvz"};
+static const char VOWELS[]{"aeiou"};
+static const int SYLLABLES{(sizeof(CONSONANTS) - 1) * (sizeof(VOWELS) - 1)};
+static const int LONGEST_NAME{60};
+
+static const char *TOPICS[]{"Art", "Book Recommendations", "Climate Change", "Cooking Recipes", "Fitness Tips",
+    "Food Critics", "Garden Care", "Local Politics", "Movie Reviews", "Music", "Pet Stories", "Photography",
+    "Sports", "Technology Trends", "Travel Stories"};
+static const char *BIKES[]{"BMC Teammachine", "Bianchi Oltre", "Cannondale SuperSix", "Canyon Aeroad", "Cervelo S5",
+    "Giant TCR", "Pinarello Dogma", "Scott Addict", "Specialized Tarmac", "Trek Madone"};
+
+//append an integer
+static void append(string &out, long number)
+{
+    char digits[24];
+    auto done{std::to_chars(digits, digits + sizeof(digits), number)};
+    out.append(digits, done.ptr);
+}
+
+//append tenths as a number with one decimal place
+static void append_tenths(string &out, long tenths)
+{
+    append(out, tenths / 10);
+    out.push_back('.');
+    out.push_back(static_cast<char>('0' + tenths % 10));
+}
+
+//uniform [0, 1) from a hash
+static double unit(uint64_t bits)
+{
+    return (bits >> 11) * (1.0 / (1ull << 53));
+}
+
+/*
+ *********************************************************************
+ * Roster_Generator
+ * data members are:
+ *      Roster_Options options;
+ *      int width;
+ *      uint64_t multiplier;
+ *      uint64_t offset;
+ *      int total_weight;
+ *********************************************************************
+ */
+
+//constructor, sizes the name code and picks the permutation
+Roster_Generator::Roster_Generator(const Roster_Options &options) : options(options), width(2),
+    multiplier(1), offset(0), total_weight(0)
+{
+    if (this -> options.count < 0)
+        this -> options.count = 0;
+    for (int &weight : this -> options.mix){
+        weight = std::max(weight, 0);
+        total_weight += weight;
+    }
+    if (!total_weight){
+        std::fill(std::begin(this -> options.mix), std::end(this -> options.mix), 1);
+        total_weight = 3;
+    }
+
+    //enough syllables that every index has its own code
+    for (double codes{SYLLABLES * SYLLABLES}; codes < this -> options.count; codes *= SYLLABLES)
+        ++width;
+
+    //a multiplier coprime with count makes p -> (a * p + b) % count a permutation
+    const uint64_t count(std::max(this -> options.count, 1l));
+    multiplier = hash(0, 0) % count | 1;
+    while (std::gcd(multiplier, count) != 1)
+        multiplier = (multiplier + 2) % count;
+    offset = hash(0, 1) % count;
+}
+
+//write every row, blocks are built in parallel and written in order
+long Roster_Generator::write(const string &filename) const
+{
+    int fd{filename == "-" ? STDOUT_FILENO : ::open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644)};
+    if (fd < 0)
+        throw GENERATOR_ERROR::no_file_exception();
+
+    const long blocks{(options.count + BLOCK_ROWS - 1) / BLOCK_ROWS};
+    int threads{options.threads > 0 ? options.threads : static_cast<int>(std::thread::hardware_concurrency())};
+    threads = static_cast<int>(std::max(1l, std::min<long>(std::max(threads, 1), blocks)));
+
+    std::mutex lock;
+    std::condition_variable turn_changed;
+    long turn{};
+    long written{};
+    bool failed{false};
+
+    auto worker{[&](int first){
+        string block;
+        for (long b{first}; b < blocks; b += threads){
+            block.clear();
+            const long end{std::min(options.count, (b + 1) * BLOCK_ROWS)};
+            for (long position{b * BLOCK_ROWS}; position < end; ++position)
+                row(position, block);
+
+            std::unique_lock<std::mutex> held(lock);
+            turn_changed.wait(held, [&]{ return turn == b; });
+            for (size_t sent{}; !failed && sent < block.size();){
+                ssize_t count{::write(fd, block.data() + sent, block.size() - sent)};
+                if (count < 0 && errno == EINTR)
+                    continue;
+                if (count <= 0)
+                    failed = true;
+                else
+                    sent += count;
+            }
+            written += block.size();
+            ++turn;
+            turn_changed.notify_all();
+        }
+    }};
+
+    std::vector<std::thread> pool;
+    for (int t{}; t < threads; ++t)
+        pool.emplace_back(worker, t);
+    for (auto &thread : pool)
+        thread.join();
+
+    if (fd != STDOUT_FILENO && ::close(fd) != 0)
+        failed = true;
+    if (failed)
+        throw GENERATOR_ERROR::no_file_exception();
+    return written;
+}
+
+//<TYPE>,<NAME>,<FIELDS>
+void Roster_Generator::row(long position, string &out) const
+{
+    long index{index_at(position)};
+
+    //a duplicate repeats the name of one of the 1024 rows before it
+    if (position > 0 && unit(hash(position, 2)) < options.duplicates)
+        index = index_at(position - 1 - static_cast<long>(hash(position, 3) % std::min(position, 1024l)));
+
+    int pick(hash(position, 4) % total_weight);
+    int type{};
+    while (pick >= options.mix[type])
+        pick -= options.mix[type++];
+
+    uint64_t fields{hash(position, 5)};
+    out.push_back(static_cast<char>('1' + type));
+    out.push_back(',');
+    name(index, out);
+    out.push_back(',');
+    switch (type){
+        case 0:
+            append_tenths(out, 30 + fields % 40);
+            out.push_back(',');
+            out.append(TOPICS[(fields >> 16) % std::size(TOPICS)]);
+            break;
+        case 1:
+            append_tenths(out, 200 + fields % 150);
+            out.push_back(',');
+            out.append(BIKES[(fields >> 16) % std::size(BIKES)]);
+            break;
+        default:
+            append_tenths(out, 80 + fields % 70);
+            out.push_back(',');
+            append(out, 90 + (fields >> 16) % 90);
+            out.push_back(',');
+            //unique like the name, a duplicate wears the bib of the row it repeats
+            append(out, index + 1);
+            break;
+    }
+    out.push_back('\n');
+}
+
+//"<First> <Last>", the syllable code of 'index' split over two words and padded
+//the code is fixed width and its syllables sort in order, so names sort as their indexes do
+void Roster_Generator::name(long index, string &out) const
+{
+    const size_t start{out.size()};
+    const int first_word{(width + 1) / 2};
+
+    long code{index};
+    out.append(2 * width + 1, ' ');
+    for (int syllable{width - 1}; syllable >= 0; --syllable){
+        size_t at{start + 2 * syllable + (syllable >= first_word)};
+        int digit(code % SYLLABLES);
+        code /= SYLLABLES;
+        out[at] = CONSONANTS[digit / (sizeof(VOWELS) - 1)];
+        out[at + 1] = VOWELS[digit % (sizeof(VOWELS) - 1)];
+    }
+    out[start] = static_cast<char>(toupper(out[start]));
+    out[start + 2 * first_word + 1] = static_cast<char>(toupper(out[start + 2 * first_word + 1]));
+
+    //Box-Muller for a normally distributed length
+    double z{std::sqrt(-2 * std::log(1 - unit(hash(index, 6)))) * std::cos(2 * M_PI * unit(hash(index, 7)))};
+    long length{std::lround(options.name_length + options.name_spread * z)};
+    length = std::clamp<long>(length, 2 * width + 1, LONGEST_NAME);
+
+    uint64_t padding{hash(index, 8)};
+    while (static_cast<long>(out.size() - start) + 1 < length){
+        int digit(padding % SYLLABLES);
+        padding = padding / SYLLABLES ? padding / SYLLABLES : hash(padding, 9);
+        out.push_back(CONSONANTS[digit / (sizeof(VOWELS) - 1)]);
+        out.push_back(VOWELS[digit % (sizeof(VOWELS) - 1)]);
+    }
+    if (static_cast<long>(out.size() - start) < length)
+        out.push_back(VOWELS[padding % (sizeof(VOWELS) - 1)]);
+}
+
+//index of the contestant at 'position' in the file
+long Roster_Generator::index_at(long position) const
+{
+    switch (options.order){
+        case Order::SORTED:
+            return position;
+        case Order::REVERSE:
+            return options.count - 1 - position;
+        case Order::RANDOM:
+            return static_cast<long>((static_cast<unsigned __int128>(multiplier) * position + offset) % options.count);
+        case Order::NEARLY: {
+                //both rows of a pair agree on whether they swap, so it stays a permutation
+                long partner{position ^ 1};
+                if (partner < options.count && unit(hash(position >> 1, 10)) < options.disorder)
+                    return partner;
+                return position;
+            }
+    }
+    return position;
+}
+
+//splitmix64 of a value, one independent stream per use
+uint64_t Roster_Generator::hash(uint64_t value, uint64_t stream) const
+{
+    uint64_t bits{value * 0x9e3779b97f4a7c15ull + (stream + 1) * 0xbf58476d1ce4e5b9ull + options.seed};
+    bits = (bits ^ (bits >> 30)) * 0xbf58476d1ce4e5b9ull;
+    bits = (bits ^ (bits >> 27)) * 0x94d049bb133111ebull;
+    return bits ^ (bits >> 31);
+}
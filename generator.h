@@ -0,0 +1,96 @@
+/*
+ *********************************************************************
+ * Ian Leuty
+ * inleuty@gmail.com
+ * 10/19/2026
+ *********************************************************************
+ * synthetic roster generator declaration
+ *********************************************************************
+ * Writes roster files in the roster.in format at any size:
+ *      1,<NAME>,<KM/HR>,<TOPIC>
+ *      2,<NAME>,<KM/HR>,<BIKE>
+ *      3,<NAME>,<KM/HR>,<PREVIOUS BEST>,<BIB>
+ *
+ * Every row is a pure function of its position and the seed, so the
+ * rows are built on every thread in blocks and written in order, and
+ * the same options always give the same file.
+ *
+ * Names are unique up to the duplicate rate, and so are bibs: a bib
+ * is its name's index + 1, so a registry never has to redraw one.
+ * Each name starts with a fixed width syllable code of its index (so
+ * names sort the way their indexes do) and is padded to a length drawn
+ * from a normal distribution. Order maps a row's position to the index
+ * it holds:
+ *      SORTED      position i holds index i
+ *      REVERSE     index count - 1 - i
+ *      RANDOM      an affine permutation of the indexes
+ *      NEARLY      sorted, with 'disorder' of the neighbouring pairs swapped
+ *********************************************************************
+ */
+
+#ifndef GENERATOR
+#define GENERATOR
+
+#include <cstdint>
+#include <string>
+
+//exceptions related to the generator
+struct GENERATOR_ERROR
+{
+    struct no_file_exception{
+        std::string msg{"\nFailed to write the roster.\n"};
+    };
+};
+
+//order of the rows in a generated roster
+enum class Order : char{SORTED, REVERSE, RANDOM, NEARLY};
+
+//what to generate
+struct Roster_Options
+{
+    long count{100000};
+
+    //relative weights of walking, cycling and half marathon rows
+    int mix[3]{1, 1, 1};
+
+    //fraction of rows that repeat a recent name (like the doubled Kevin Murphy)
+    double duplicates{0};
+
+    //name length in characters, mean and standard deviation
+    int name_length{16};
+    int name_spread{4};
+
+    Order order{Order::RANDOM};
+    double disorder{0.01};
+
+    int threads{0};
+    uint64_t seed{1};
+};
+
+class Roster_Generator
+{
+    public:
+        Roster_Generator(const Roster_Options &options);
+
+        //write every row to 'filename' ("-" for stdout)
+        //returns the bytes written, throws no_file_exception
+        long write(const std::string &filename) const;
+
+        //append the row at 'position' (with its newline) to 'out'
+        void row(long position, std::string &out) const;
+
+        //the name of the contestant with sorted index 'index'
+        void name(long index, std::string &out) const;
+
+    private:
+        Roster_Options options;
+        int width;
+        uint64_t multiplier;
+        uint64_t offset;
+        int total_weight;
+
+        long index_at(long position) const;
+        uint64_t hash(uint64_t value, uint64_t stream) const;
+};
+
+#endif
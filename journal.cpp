@@ -0,0 +1,410 @@
+/*
+ *********************************************************************
+ * Ian Leuty
+ * inleuty@gmail.com
+ * 10/19/2026
+ *********************************************************************
+ * journal definition
+ *********************************************************************
+ */
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdio>
+#include "journal.h"
+
+using std::string, std::shared_ptr, std::make_shared;
+
+//record types
+static const char PUT{'P'}, ERASE{'E'}, CLEAR{'C'}, RACE{'R'};
+
+//contestant types, same numbers as a roster
+static const char WALKING{1}, CYCLING{2}, RUNNING{3};
+
+//length and checksum in front of every record
+static const size_t HEADER{2 * sizeof(uint32_t)};
+
+/*
+ *********************************************************************
+ * Appender
+ * data members are:
+ *      std::string *out;
+ *********************************************************************
+ */
+
+//default constructor, nowhere to write until target is called
+Appender::Appender() : out(nullptr) {}
+
+//the string written to from now on
+void Appender::target(string &out)
+{
+    this -> out = &out;
+}
+
+//one character
+Appender::int_type Appender::overflow(int_type c)
+{
+    if (c != traits_type::eof())
+        out -> push_back(traits_type::to_char_type(c));
+    return c;
+}
+
+//a run of characters
+std::streamsize Appender::xsputn(const char *bytes, std::streamsize count)
+{
+    out -> append(bytes, count);
+    return count;
+}
+
+/*
+ *********************************************************************
+ * Journal
+ * data members are:
+ *      int fd;
+ *      std::string filename;
+ *      off_t durable;
+ *      bool torn;
+ *      std::string pending;
+ *      int buffered;
+ *      std::chrono::steady_clock::time_point oldest;
+ *      int logged;
+ *      int group;
+ *      std::chrono::milliseconds window;
+ *      Appender appender;
+ *      std::ostream stream;
+ *********************************************************************
+ */
+
+//default constructor, closed until open is called
+Journal::Journal() : fd(-1), durable(0), torn(false), buffered(0), logged(0), group(1024), window(10), stream(&appender) {}
+
+//anything still buffered is made durable
+Journal::~Journal()
+{
+    close();
+}
+
+//replay the snapshot and the journal, cut off a torn tail and open for appending
+int Journal::open(const string &filename, registry &tree, bool &walking, bool &cycling, bool &running)
+{
+    close();
+    this -> filename = filename;
+
+    size_t valid{};
+    int replayed{replay(filename + ".snapshot", tree, walking, cycling, running, valid)};
+    logged = replay(filename, tree, walking, cycling, running, valid);
+    replayed += logged;
+
+    fd = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+    if (fd < 0)
+        throw JOURNAL_ERROR::open_exception();
+
+    //a crash mid write leaves a partial record at the end
+    if (ftruncate(fd, valid) != 0)
+        throw JOURNAL_ERROR::open_exception();
+    durable = valid;
+    torn = false;
+    return replayed;
+}
+
+//sync and close
+void Journal::close()
+{
+    if (fd < 0)
+        return;
+    sync();
+    ::close(fd);
+    fd = -1;
+}
+
+//true once open has succeeded
+bool Journal::is_open() const
+{
+    return fd >= 0;
+}
+
+//log the full state of a contestant under their name
+void Journal::put(const shared_ptr<Contestant> &contestant)
+{
+    if (fd >= 0 && encode(contestant, pending))
+        queued();
+}
+
+//log a removal
+void Journal::erase(const string &name)
+{
+    if (fd < 0)
+        return;
+    std::ostringstream payload;
+    write_key(payload, name);
+    append(ERASE, payload.str());
+}
+
+//log that the whole registry was emptied
+void Journal::clear()
+{
+    if (fd < 0)
+        return;
+    append(CLEAR, "");
+}
+
+//log which races have started
+void Journal::race(bool walking, bool cycling, bool running)
+{
+    if (fd < 0)
+        return;
+    string payload{walking, cycling, running};
+    append(RACE, payload);
+}
+
+//group commit
+bool Journal::commit()
+{
+    if (!buffered)
+        return true;
+    if (buffered < group && std::chrono::steady_clock::now() - oldest < window)
+        return true;
+    return sync();
+}
+
+//write everything buffered in one call and make it durable
+//on failure the records stay buffered and whatever part of them reached the file is
+//cut off (now, or before the next try), so a later record never follows a torn one
+bool Journal::sync()
+{
+    if (fd < 0 || !buffered)
+        return true;
+    if (torn){
+        if (ftruncate(fd, durable) != 0)
+            return false;
+        torn = false;
+    }
+
+    if (!write_all(fd, pending) || fdatasync(fd) != 0){
+        torn = ftruncate(fd, durable) != 0;
+        return false;
+    }
+    durable += pending.size();
+    pending.clear();
+    buffered = 0;
+    return true;
+}
+
+//write a fresh snapshot of 'tree' and empty the journal
+//the snapshot is complete on disk (renamed into place) before the journal is cut,
+//a crash in between only means some records are replayed over a snapshot that has them
+bool Journal::compact(registry &tree, bool walking, bool cycling, bool running)
+{
+    if (fd < 0)
+        return false;
+
+    //anything buffered goes out first, if compaction fails it is still in the journal
+    if (!sync())
+        return false;
+
+    string temporary{filename + ".snapshot.new"};
+    int out{::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644)};
+    if (out < 0)
+        return false;
+
+    std::vector<shared_ptr<Contestant>> contestants;
+    tree.fetch_data(contestants);
+
+    //same records as the journal, one put per contestant then the race flags
+    string bytes;
+    for (const auto &contestant : contestants)
+        encode(contestant, bytes);
+    frame(bytes, RACE, string{walking, cycling, running});
+
+    bool written{write_all(out, bytes) && fsync(out) == 0};
+    ::close(out);
+    if (!written || rename(temporary.c_str(), (filename + ".snapshot").c_str()) != 0)
+        return false;
+
+    //make the rename itself durable
+    string directory{filename.find('/') == string::npos ? "." : filename.substr(0, filename.rfind('/') + 1)};
+    int dir{::open(directory.c_str(), O_RDONLY)};
+    if (dir >= 0){
+        fsync(dir);
+        ::close(dir);
+    }
+
+    if (ftruncate(fd, 0) != 0 || fdatasync(fd) != 0)
+        return false;
+    durable = 0;
+    logged = 0;
+    return true;
+}
+
+//tune group commit
+void Journal::set_group(int records, int window)
+{
+    group = records < 1 ? 1 : records;
+    this -> window = std::chrono::milliseconds(window < 0 ? 0 : window);
+}
+
+//records since the last compaction
+int Journal::size() const
+{
+    return logged;
+}
+
+//frame a record and buffer it for the next group commit
+void Journal::append(char type, const string &payload)
+{
+    frame(pending, type, payload);
+    queued();
+}
+
+//count the record just added to 'pending'
+void Journal::queued()
+{
+    if (!buffered)
+        oldest = std::chrono::steady_clock::now();
+    ++buffered;
+    ++logged;
+}
+
+//apply every intact record of 'file' to 'tree'
+//'valid' is set to the offset just past the last intact record
+int Journal::replay(const string &file, registry &tree, bool &walking, bool &cycling, bool &running, size_t &valid)
+{
+    valid = 0;
+    std::ifstream in(file, std::ios::binary);
+    if (!in)
+        return 0;
+    string bytes{std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+
+    //a snapshot is written in name order, so each contestant is hinted just past the last
+    int replayed{};
+    int hint{};
+    while (valid + HEADER <= bytes.size()){
+        uint32_t length{}, sum{};
+        memcpy(&length, &bytes[valid], sizeof(length));
+        memcpy(&sum, &bytes[valid + sizeof(length)], sizeof(sum));
+        if (length == 0 || valid + HEADER + length > bytes.size()
+        || checksum(&bytes[valid + HEADER], length) != sum)
+            break;
+
+        const char type{bytes[valid + HEADER]};
+        std::istringstream payload(bytes.substr(valid + HEADER + 1, length - 1));
+
+        if (type == PUT){
+            shared_ptr<Contestant> contestant;
+            switch (payload.get()){
+                case WALKING:
+                    contestant = make_shared<Walking_Contestant>();
+                    break;
+                case CYCLING:
+                    contestant = make_shared<Bicycle_Contestant>();
+                    break;
+                case RUNNING:
+                    contestant = make_shared<Half_Marathon_Contestant>();
+                    break;
+                default:
+                    break;
+            }
+            if (!contestant || !contestant -> read_state(payload))
+                break;
+            auto [held, inserted]{tree.insert_hint(hint, contestant -> get_name(), contestant)};
+            if (!inserted){
+                *held = contestant;
+                tree.update(contestant -> get_name());
+            }
+        }
+        else if (type == ERASE){
+            string name;
+            read_key(payload, name);
+            tree.remove(name);
+        }
+        else if (type == CLEAR)
+            tree.remove_all();
+        else if (type == RACE && length == 4){
+            walking = bytes[valid + HEADER + 1];
+            cycling = bytes[valid + HEADER + 2];
+            running = bytes[valid + HEADER + 3];
+        }
+        else
+            break;
+
+        valid += HEADER + length;
+        ++replayed;
+    }
+    return replayed;
+}
+
+//append a put record for 'contestant' to 'out'
+//the contestant type (found with RTTI) followed by its state, written in place
+bool Journal::encode(const shared_ptr<Contestant> &contestant, string &out)
+{
+    char type{};
+    if (dynamic_cast<Walking_Contestant*>(contestant.get()))
+        type = WALKING;
+    else if (dynamic_cast<Bicycle_Contestant*>(contestant.get()))
+        type = CYCLING;
+    else if (dynamic_cast<Half_Marathon_Contestant*>(contestant.get()))
+        type = RUNNING;
+    else
+        return false;
+
+    size_t start{begin(out, PUT)};
+    out.push_back(type);
+    appender.target(out);
+    contestant -> write_state(stream);
+    finish(out, start);
+    return true;
+}
+
+//append a whole record to 'out'
+void Journal::frame(string &out, char type, const string &payload)
+{
+    size_t start{begin(out, type)};
+    out += payload;
+    finish(out, start);
+}
+
+//<LENGTH><CHECKSUM><TYPE><PAYLOAD>, length and checksum cover type and payload
+//room is left for the header, returns where the record starts
+size_t Journal::begin(string &out, char type)
+{
+    size_t start{out.size()};
+    out.append(HEADER, '\0');
+    out.push_back(type);
+    return start;
+}
+
+//fill in the header of the record at 'start' once its payload is written
+void Journal::finish(string &out, size_t start)
+{
+    uint32_t length{static_cast<uint32_t>(out.size() - start - HEADER)};
+    uint32_t sum{checksum(&out[start + HEADER], length)};
+    memcpy(&out[start], &length, sizeof(length));
+    memcpy(&out[start + sizeof(length)], &sum, sizeof(sum));
+}
+
+//write until everything is written or an error, retrying short and interrupted writes
+bool Journal::write_all(int fd, const string &bytes)
+{
+    size_t written{};
+    while (written < bytes.size()){
+        ssize_t count{::write(fd, bytes.data() + written, bytes.size() - written)};
+        if (count < 0 && errno == EINTR)
+            continue;
+        if (count <= 0)
+            return false;
+        written += count;
+    }
+    return true;
+}
+
+//32 bit FNV-1a
+uint32_t Journal::checksum(const char *bytes, size_t length)
+{
+    uint32_t hash{2166136261u};
+    for (size_t i{}; i < length; ++i){
+        hash ^= static_cast<unsigned char>(bytes[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
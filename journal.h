@@ -0,0 +1,138 @@
+/*
+ *********************************************************************
+ * Ian Leuty
+ * inleuty@gmail.com
+ * 10/19/2026
+ *********************************************************************
+ * journal declaration
+ *********************************************************************
+ * Append only binary journal of every change to the registry.
+ *
+ * Each record is the full state of one contestant (or a removal, a
+ * clear, or the race flags), so replaying a record twice is harmless:
+ *      <LENGTH><CHECKSUM><TYPE><PAYLOAD>
+ *
+ * Group commit: records are buffered and written with one write and
+ * one fdatasync once 'group' records are waiting or the oldest has
+ * waited 'window' milliseconds. sync forces it. A failed write keeps
+ * the records buffered for the next try and cuts the file back to the
+ * end of the last durable record, so nothing is appended after a torn
+ * one.
+ *
+ * Recovery loads <file>.snapshot then replays <file>, stopping at the
+ * first torn or corrupt record (which is cut off). compact writes the
+ * whole registry to a new snapshot and empties the journal, so
+ * recovery never replays more than one snapshot plus the records
+ * logged since.
+ *********************************************************************
+ */
+
+#ifndef JOURNAL
+#define JOURNAL
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <streambuf>
+#include <memory>
+#include <string>
+#include <sys/types.h>
+#include "structures.h"
+#include "core.h"
+#include "stats.h"
+
+//exceptions related to the journal
+struct JOURNAL_ERROR
+{
+    struct open_exception{
+        std::string msg{"\nFailed to open the journal.\n"};
+    };
+
+    struct write_exception{
+        std::string msg{"\nFailed to write the journal, changes are held until it can be.\n"};
+    };
+};
+
+//output stream buffer that appends to a string
+//lets write_state serialize straight into the pending records
+class Appender : public std::streambuf
+{
+    public:
+        Appender();
+        void target(std::string &out);
+
+    protected:
+        int_type overflow(int_type c);
+        std::streamsize xsputn(const char *bytes, std::streamsize count);
+
+    private:
+        std::string *out;
+};
+
+class Journal
+{
+    public:
+        typedef Red_Black<std::string, std::shared_ptr<Contestant>, Field_Stats> registry;
+
+        Journal();
+        ~Journal();
+
+        //recover into 'tree' and the race flags, then open for appending
+        //returns the number of records replayed
+        int open(const std::string &filename, registry &tree, bool &walking, bool &cycling, bool &running);
+        void close();
+        bool is_open() const;
+
+        //record a change, does nothing if the journal is not open
+        void put(const std::shared_ptr<Contestant> &contestant);
+        void erase(const std::string &name);
+        void clear();
+        void race(bool walking, bool cycling, bool running);
+
+        //write and fdatasync the buffered records if the group is full
+        //or the window has passed, sync does it regardless
+        //false if they could not be written, they stay buffered
+        bool commit();
+        bool sync();
+
+        //replace the snapshot with 'tree' and empty the journal
+        bool compact(registry &tree, bool walking, bool cycling, bool running);
+
+        //records per group and the longest a record waits (milliseconds)
+        void set_group(int records, int window);
+
+        //records in the journal since the last compaction
+        int size() const;
+
+    private:
+        int fd;
+        std::string filename;
+        off_t durable;              //end of the last record synced
+        bool torn;                  //a failed write may have left bytes past 'durable'
+
+        //records waiting for the next group commit
+        std::string pending;
+        int buffered;
+        std::chrono::steady_clock::time_point oldest;
+
+        int logged;
+        int group;
+        std::chrono::milliseconds window;
+
+        //serializes contestants, kept to avoid building a stream per record
+        Appender appender;
+        std::ostream stream;
+
+        void append(char type, const std::string &payload);
+        void queued();
+        int replay(const std::string &file, registry &tree, bool &walking, bool &cycling, bool &running, size_t &valid);
+
+        bool encode(const std::shared_ptr<Contestant> &contestant, std::string &out);
+        static void frame(std::string &out, char type, const std::string &payload);
+        static size_t begin(std::string &out, char type);
+        static void finish(std::string &out, size_t start);
+        static bool write_all(int fd, const std::string &bytes);
+        static uint32_t checksum(const char *bytes, size_t length);
+};
+
+#endif
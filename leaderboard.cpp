@@ -0,0 +1,157 @@
+/*
+ *********************************************************************
+ * Ian Leuty
+ * inleuty@gmail.com
+ * 10/19/2026
+ *********************************************************************
+ * leaderboard definition
+ *********************************************************************
+ */
+
+#include "leaderboard.h"
+
+using std::string, std::vector, std::shared_ptr;
+
+/*
+ *********************************************************************
+ * Standing
+ *********************************************************************
+ */
+
+//earlier finish first, then by name
+bool Standing::operator<(const Standing &other) const
+{
+    if (finish != other.finish)
+        return finish < other.finish;
+    return name < other.name;
+}
+
+bool Standing::operator>(const Standing &other) const
+{
+    return other < *this;
+}
+
+bool Standing::operator==(const Standing &other) const
+{
+    return finish == other.finish && name == other.name;
+}
+
+//used when the standings tree is displayed
+std::ostream& operator<<(std::ostream &out, const Standing &standing)
+{
+    return out << standing.name << " (" << standing.finish << " min)";
+}
+
+//the name's heap buffer, if it has one
+void heap_usage(const Standing &standing, Memory &usage)
+{
+    usage.string(standing.name);
+}
+
+/*
+ *********************************************************************
+ * Leaderboard
+ * data members are:
+ *      Red_Black<Standing, std::shared_ptr<Contestant>> standings;
+ *      Red_Black<std::string, float> placed;
+ *********************************************************************
+ */
+
+//default constructor
+Leaderboard::Leaderboard() {}
+
+//take the contestant off the board at their old place
+//and put them back at their new one
+//someone already on the board keeps their entry in 'placed', only the time changes
+bool Leaderboard::update(const string &name, const shared_ptr<Contestant> &contestant)
+{
+    float finish{projected_finish(contestant)};
+    float *placed_at{placed.find_ptr(name)};
+    if (placed_at){
+        standings.remove(Standing{*placed_at, name});
+        if (finish < 0){
+            placed.remove(name);
+            return false;
+        }
+        *placed_at = finish;
+    }
+    else if (finish < 0)
+        return false;
+    else
+        placed.insert(name, finish);
+
+    standings.insert(Standing{finish, name}, contestant);
+    return true;
+}
+
+//take a contestant off the board
+bool Leaderboard::remove(const string &name)
+{
+    const float *finish{placed.find_ptr(name)};
+    if (!finish)
+        return false;
+    standings.remove(Standing{*finish, name});
+    return placed.remove(name);
+}
+
+//clear the board
+int Leaderboard::remove_all()
+{
+    placed.remove_all();
+    return standings.remove_all();
+}
+
+//leading k contestants
+int Leaderboard::top(int k, vector<Standing> &leaders, vector<shared_ptr<Contestant>> &contestants) const
+{
+    return standings.fetch_first(k, leaders, contestants);
+}
+
+//visit the whole board, leader first
+void Leaderboard::for_each(const std::function<void(const Standing&, const shared_ptr<Contestant>&)> &visit) const
+{
+    standings.for_each(visit);
+}
+
+//place on the board, rank counts everyone projected ahead
+int Leaderboard::position(const string &name) const
+{
+    const float *finish{placed.find_ptr(name)};
+    if (!finish)
+        return 0;
+    return standings.rank(Standing{*finish, name}) + 1;
+}
+
+//number of contestants on the board
+int Leaderboard::size() const
+{
+    return standings.size();
+}
+
+//nodes and keys of both trees, the shared contestants are left out
+void Leaderboard::account(Memory &nodes, Memory &keys) const
+{
+    Memory shared;
+    standings.account(nodes, keys, shared);
+    placed.account(nodes, keys, shared);
+}
+
+//minutes until predict_completion reaches 100%
+//only contestants who are checked in, racing or finished can be projected
+//a finisher's time is final, a split replaces the estimate with their actual pace
+float Leaderboard::projected_finish(const shared_ptr<Contestant> &contestant)
+{
+    if (contestant -> is_status(Status::FINISHED))
+        return static_cast<float>(contestant -> get_elapsed());
+
+    if (!contestant -> is_status(Status::CHECKED_IN) && !contestant -> is_racing())
+        return -1;
+
+    float rate{}, span{};
+    contestant -> gather(rate, span);
+    if (contestant -> get_covered() > 0 && span > 0)
+        return contestant -> get_elapsed() * span / contestant -> get_covered();
+    if (rate <= 0 || span <= 0)
+        return -1;
+    return 60 * span / rate;
+}
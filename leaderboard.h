@@ -0,0 +1,77 @@
+/*
+ *********************************************************************
+ * Ian Leuty
+ * inleuty@gmail.com
+ * 10/19/2026
+ *********************************************************************
+ * leaderboard declaration
+ *********************************************************************
+ * Standings ordered by projected finish time.
+ *
+ * A second Red_Black keyed by (projected finish, name) holds every
+ * contestant who is checked in, racing or finished. It is updated one
+ * contestant at a time as they change, so top-k and "position of
+ * runner X" never need a full re-sort:
+ *      top(k)          O(log n + k)
+ *      position(name)  O(log n)
+ *********************************************************************
+ */
+
+#ifndef LEADERBOARD
+#define LEADERBOARD
+
+#include <functional>
+#include "structures.h"
+#include "core.h"
+
+//key of the standings tree
+//ordered by projected finish (minutes), ties broken by name
+struct Standing
+{
+    float finish;
+    std::string name;
+
+    bool operator<(const Standing &other) const;
+    bool operator>(const Standing &other) const;
+    bool operator==(const Standing &other) const;
+};
+std::ostream& operator<<(std::ostream &out, const Standing &standing);
+
+//a standing owns its name's heap buffer
+void heap_usage(const Standing &standing, Memory &usage);
+
+class Leaderboard
+{
+    public:
+        Leaderboard();
+
+        //re-place a contestant after their state changed
+        //contestants who cannot be projected are taken off the board
+        bool update(const std::string &name, const std::shared_ptr<Contestant> &contestant);
+        bool remove(const std::string &name);
+        int remove_all();
+
+        //the leading 'k' contestants, fastest projected finish first
+        int top(int k, std::vector<Standing> &standings, std::vector<std::shared_ptr<Contestant>> &contestants) const;
+
+        //every contestant on the board in order, nothing is copied
+        void for_each(const std::function<void(const Standing&, const std::shared_ptr<Contestant>&)> &visit) const;
+
+        //1 based place on the board, 0 if not on the board
+        int position(const std::string &name) const;
+        int size() const;
+
+        //memory of both trees, the contestants are counted by the registry
+        void account(Memory &nodes, Memory &keys) const;
+
+        //projected finish in minutes, negative if it cannot be projected
+        static float projected_finish(const std::shared_ptr<Contestant> &contestant);
+
+    private:
+        Red_Black<Standing, std::shared_ptr<Contestant>> standings;
+
+        //where each name currently sits in 'standings'
+        Red_Black<std::string, float> placed;
+};
+
+#endif
@@ -8,7 +8,10 @@
  *********************************************************************
  */
 
+#include <csignal>
 #include "application.h"
+#include "script.h"
+#include "server.h"
 using namespace std;
 
 /*
@@ -23,7 +26,18 @@ using namespace std;
  *       void find_contestant();
  *       void hydrate_runner();
  *       void unregister();
+ *       void purge();
  *       void estimate_completion();
+ *       void estimate_field();
+ *       void view_leaderboard();
+ *       void find_bib();
+ *       void correct_name();
+ *       void ingest();
+ *       void footprint();
+ *       void field_stats();
+ *       void close_registration();
+ *       void archive();
+ *       void search_archive();
  *       void check_in();
  *       void start_race();
  *       void disqualify();
@@ -32,21 +46,135 @@ using namespace std;
  *       void animate();
  *       void animate_load();
  *       void animate_removal();
+ *       void animate_saved();
+ *       void open_journal(const std::string &filename);
+ *       void open_snapshot(const std::string &name);
+ *       bool checkpoint();
+ *       void compact_if_due();
  *
  *       const int read_int();
  *       bool again();
+ *
+ * a "Script" is a "Menu" that runs commands from a file instead:
+ *       int run(const std::string &script);
+ *       void report(std::ostream &out);
+ *
+ * a "Server" is a "Menu" that answers queries over sockets:
+ *       void listen(const std::string &address);
+ *       void serve();
+ *       void stop();
  *********************************************************************
  */
 
-int main(void)
+//the running server, stopped by SIGINT or SIGTERM
+static Server *serving{nullptr};
+static void shutdown(int)
+{
+    if (serving)
+        serving -> stop();
+}
+
+//options:
+//      -j <file>   recover from and log every change to a journal
+//      -b <file>   run a command script without prompts and report latency
+//      -s <addr>   serve queries on a socket (host:port or a path), repeatable
+//      -p <file>   keep the cold profile strings in a file instead of memory
+//      -m <name>   publish a read only snapshot to shared memory /name for local readers
+int main(int argc, char *argv[])
 {
     int choice{};
+    int option{};
+    string journal_file;
+    string script_file;
+    string profile_file;
+    string snapshot_name;
+    vector<string> addresses;
+
+    while ((option = getopt(argc, argv, "b:j:m:p:s:")) != -1){
+        switch (option){
+            case 's':
+                addresses.push_back(optarg);
+                break;
+            case 'b':
+                script_file = optarg;
+                break;
+            case 'j':
+                journal_file = optarg;
+                break;
+            case 'p':
+                profile_file = optarg;
+                break;
+            case 'm':
+                snapshot_name = optarg;
+                break;
+            default:
+                cerr << "usage: " << argv[0] << " [-b script] [-j journal] [-m snapshot] [-p profiles] [-s address]..." << endl;
+                return 1;
+        }
+    }
+
+    //before anything is loaded, so every profile string is written straight to the file
+    if (profile_file != ""){
+        try{
+            Profile_Store::shared().page_to(profile_file);
+        }
+        catch (PROFILE_ERROR::page_exception &error){
+            cerr << error.msg;
+            return 1;
+        }
+    }
 
     srand(time(0));
 
+    if (script_file != ""){
+        Script batch;
+        if (journal_file != "")
+            batch.open_journal(journal_file);
+        if (snapshot_name != "")
+            batch.open_snapshot(snapshot_name);
+        try{
+            batch.run(script_file);
+        }
+        catch (SCRIPT_ERROR::no_script_exception &error){
+            cerr << error.msg;
+            return 1;
+        }
+        batch.report(cout);
+        return 0;
+    }
+
+    if (!addresses.empty()){
+        Server server;
+        if (journal_file != "")
+            server.open_journal(journal_file);
+        if (snapshot_name != "")
+            server.open_snapshot(snapshot_name);
+        try{
+            for (const auto &address : addresses)
+                server.listen(address);
+        }
+        catch (SERVER_ERROR::listen_exception &error){
+            cerr << error.msg;
+            return 1;
+        }
+
+        serving = &server;
+        signal(SIGINT, shutdown);
+        signal(SIGTERM, shutdown);
+        cout << "\nServing " << addresses.size() << " address(es), Ctrl-C to stop." << endl;
+        server.serve();
+        serving = nullptr;
+        cout << "\nAnswered " << server.requests() << " requests." << endl;
+        return 0;
+    }
+
     Menu run;
 
     run.splash();
+    if (journal_file != "")
+        run.open_journal(journal_file);
+    if (snapshot_name != "")
+        run.open_snapshot(snapshot_name);
 
     do{
         cout << "\n\nPlease select an action."
@@ -64,7 +192,18 @@ int main(void)
              << "\n10. Disqualify a contestant."
              << "\n11. Display a graphical representation of the underlying Red Black Tree."
              << "\n12. Test assignment operator."
-             << "\n13. View animated tree insertion. (WARNING: takes ~2 minutes with 100 items.)"
+             << "\n13. View animated tree insertion or removal."
+             << "\n14. Estimate progress for the whole field."
+             << "\n15. View the leaderboard."
+             << "\n16. Find a half marathoner by bib number."
+             << "\n17. Correct a contestant's name."
+             << "\n18. Ingest timing events from a file, pipe or socket."
+             << "\n19. Report the registry's memory footprint."
+             << "\n20. View statistics for a range of contestants."
+             << "\n21. Remove disqualified contestants and no-shows."
+             << "\n22. Close registration (freeze the roster for faster lookups)."
+             << "\n23. Archive this event's contestants."
+             << "\n24. Look up contestants from past events."
 
              << "\n>";
 
@@ -110,9 +249,44 @@ int main(void)
             case 13:
                 run.animate();
                 break;
+            case 14:
+                run.estimate_field();
+                break;
+            case 15:
+                run.view_leaderboard();
+                break;
+            case 16:
+                run.find_bib();
+                break;
+            case 17:
+                run.correct_name();
+                break;
+            case 18:
+                run.ingest();
+                break;
+            case 19:
+                run.footprint();
+                break;
+            case 20:
+                run.field_stats();
+                break;
+            case 21:
+                run.purge();
+                break;
+            case 22:
+                run.close_registration();
+                break;
+            case 23:
+                run.archive();
+                break;
+            case 24:
+                run.search_archive();
+                break;
             default:
                 break;
         }
+        run.checkpoint();
+        run.compact_if_due();
     } while (choice);
 
 
@@ -0,0 +1,320 @@
+/*
+ *********************************************************************
+ * Ian Leuty
+ * inleuty@gmail.com
+ * 10/19/2026
+ *********************************************************************
+ * timing event pipeline definition
+ *********************************************************************
+ */
+
+#include <charconv>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <cerrno>
+#include "pipeline.h"
+
+using std::string, std::string_view, std::shared_ptr, std::make_shared, std::move;
+
+//bytes asked of the source per read
+static const size_t CHUNK_SIZE{1 << 16};
+
+/*
+ *********************************************************************
+ * Pipeline
+ * a pipeline runs once, its rings are closed when the source ends
+ * data members are:
+ *      int batch_size;
+ *      Ring<std::shared_ptr<const Chunk>> chunks;
+ *      Ring<Batch> parsed;
+ *      Ring<Batch> sorted;
+ *      std::atomic<long> received;
+ *      std::atomic<long> rejected;
+ *      std::atomic<long> batched;
+ *********************************************************************
+ */
+
+//constructor, 'queue_size' slots between each pair of stages
+Pipeline::Pipeline(int queue_size, int batch_size) : batch_size(batch_size), chunks(queue_size),
+    parsed(queue_size), sorted(queue_size), received(0), rejected(0), batched(0) {}
+
+//start the reader, parser and batcher and apply batches on this thread
+long Pipeline::run(const string &source, const applier &apply)
+{
+    int fd{open(source)};
+    std::thread read_stage(&Pipeline::reader, this, fd);
+    std::thread parse_stage(&Pipeline::parser, this);
+    std::thread batch_stage(&Pipeline::batcher, this);
+
+    long applied{};
+    Batch batch;
+    std::vector<Run> runs;
+    while (sorted.pop(batch)){
+        const auto &events{batch.events};
+        //each run of one name is handed over together, the whole batch at once
+        runs.clear();
+        for (size_t i{}; i < events.size();){
+            size_t next{i + 1};
+            while (next < events.size() && events[next].name == events[i].name)
+                ++next;
+            runs.push_back(Run{events[i].name, &events[i], static_cast<int>(next - i)});
+            i = next;
+        }
+        applied += apply(runs);
+    }
+
+    read_stage.join();
+    parse_stage.join();
+    batch_stage.join();
+    if (fd != STDIN_FILENO)
+        ::close(fd);
+    return applied;
+}
+
+//apply one event to a contestant, 'changed' compares its state before and after
+bool Pipeline::apply(Contestant &contestant, const Timing_Event &event, bool &changed)
+{
+    const Status status{contestant.get_status()};
+    const float covered{contestant.get_covered()};
+    const int elapsed{contestant.get_elapsed()};
+    const bool accepted{accept(contestant, event)};
+    changed = contestant.get_status() != status || contestant.get_covered() != covered
+           || contestant.get_elapsed() != elapsed;
+    return accepted;
+}
+
+//repeated readings (a second check in or start) are ignored rather than
+//letting them reset or disqualify someone who is already racing
+bool Pipeline::accept(Contestant &contestant, const Timing_Event &event)
+{
+    const bool racing{contestant.is_racing()};
+    const char *first{event.details.data()};
+    const char *last{first + event.details.size()};
+
+    switch (event.kind){
+        case Timing::CHECK_IN: {
+                if (!contestant.is_status(Status::REGISTERED) && !contestant.is_status(Status::PRE_REGISTERED))
+                    return false;
+                View_Buffer buffer(event.details);
+                std::istream in(&buffer);
+                return contestant.check_in(in);
+            }
+
+        case Timing::START:
+            if (racing || !contestant.is_status(Status::CHECKED_IN))
+                return false;
+            return contestant.start();
+
+        case Timing::SPLIT: {
+                float km{};
+                int minutes{};
+                auto parsed{std::from_chars(first, last, km)};
+                if (parsed.ec != std::errc() || parsed.ptr == last || *parsed.ptr != ',')
+                    return false;
+                if (std::from_chars(parsed.ptr + 1, last, minutes).ec != std::errc())
+                    return false;
+                return contestant.split(km, minutes);
+            }
+
+        case Timing::FINISH: {
+                int minutes{};
+                if (std::from_chars(first, last, minutes).ec != std::errc())
+                    return false;
+                return contestant.finish(minutes);
+            }
+    }
+    return false;
+}
+
+//events parsed so far
+long Pipeline::events_read() const
+{
+    return received;
+}
+
+//lines that were not events
+long Pipeline::events_rejected() const
+{
+    return rejected;
+}
+
+//batches handed to the applier
+long Pipeline::batches() const
+{
+    return batched;
+}
+
+//reader stage
+//every chunk ends on a line boundary, a partial last line is carried to the next chunk
+void Pipeline::reader(int fd)
+{
+    std::vector<char> carry;
+    bool ended{false};
+    while (!ended){
+        auto chunk{make_shared<Chunk>()};
+        auto &bytes{chunk -> bytes};
+        bytes.swap(carry);
+
+        const size_t used{bytes.size()};
+        bytes.resize(used + CHUNK_SIZE);
+        ssize_t count{::read(fd, bytes.data() + used, CHUNK_SIZE)};
+        while (count < 0 && errno == EINTR)
+            count = ::read(fd, bytes.data() + used, CHUNK_SIZE);
+        ended = count <= 0;
+        bytes.resize(used + (count > 0 ? count : 0));
+
+        if (!ended){
+            auto newline{std::find(bytes.rbegin(), bytes.rend(), '\n')};
+            //no whole line yet, keep reading onto the end of this one
+            if (newline == bytes.rend()){
+                carry.swap(bytes);
+                continue;
+            }
+            carry.assign(newline.base(), bytes.end());
+            bytes.erase(newline.base(), bytes.end());
+        }
+        if (!bytes.empty())
+            chunks.push(move(chunk));
+    }
+    chunks.close();
+}
+
+//parser stage
+//splits chunks into lines and lines into events, the fields are views into the chunk
+void Pipeline::parser()
+{
+    shared_ptr<const Chunk> chunk;
+    while (chunks.pop(chunk)){
+        Batch batch;
+        string_view text(chunk -> bytes.data(), chunk -> bytes.size());
+        long bad{};
+
+        size_t start{};
+        while (start < text.size()){
+            size_t end{text.find('\n', start)};
+            if (end == string_view::npos)
+                end = text.size();
+            string_view line{text.substr(start, end - start)};
+            start = end + 1;
+
+            if (!line.empty() && line.back() == '\r')
+                line.remove_suffix(1);
+            if (line.empty())
+                continue;
+
+            Timing_Event event;
+            if (parse(line, event))
+                batch.events.push_back(event);
+            else
+                ++bad;
+        }
+        received += batch.events.size();
+        rejected += bad;
+
+        batch.chunks.push_back(move(chunk));
+        parsed.push(move(batch));
+    }
+    parsed.close();
+}
+
+//batcher stage
+//merges parsed chunks until the batch is full or nothing else is waiting,
+//then orders it by name (stable, so each name's events stay in order)
+void Pipeline::batcher()
+{
+    Batch batch, next;
+    while (parsed.pop(next)){
+        do{
+            batch.events.insert(batch.events.end(), next.events.begin(), next.events.end());
+            for (auto &chunk : next.chunks)
+                batch.chunks.push_back(move(chunk));
+        } while (static_cast<int>(batch.events.size()) < batch_size && parsed.try_pop(next));
+
+        if (batch.events.empty()){
+            batch = Batch();
+            continue;
+        }
+        std::stable_sort(batch.events.begin(), batch.events.end(),
+            [](const Timing_Event &first, const Timing_Event &second){ return first.name < second.name; });
+        ++batched;
+        sorted.push(move(batch));
+        batch = Batch();
+    }
+    sorted.close();
+}
+
+//<KIND>,<NAME>[,<DETAILS>]
+bool Pipeline::parse(string_view line, Timing_Event &event) const
+{
+    if (line.size() < 3 || line[1] != ',')
+        return false;
+
+    switch (line[0]){
+        case 'C':
+            event.kind = Timing::CHECK_IN;
+            break;
+        case 'S':
+            event.kind = Timing::START;
+            break;
+        case 'P':
+            event.kind = Timing::SPLIT;
+            break;
+        case 'F':
+            event.kind = Timing::FINISH;
+            break;
+        default:
+            return false;
+    }
+
+    line.remove_prefix(2);
+    size_t comma{line.find(',')};
+    event.name = line.substr(0, comma);
+    event.details = comma == string_view::npos ? string_view() : line.substr(comma + 1);
+    return !event.name.empty();
+}
+
+//"-" is stdin, a socket is connected to, anything else (file or named pipe) is opened
+int Pipeline::open(const string &source)
+{
+    if (source == "-")
+        return STDIN_FILENO;
+
+    struct stat info{};
+    if (stat(source.c_str(), &info) == 0 && S_ISSOCK(info.st_mode)){
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        if (source.size() >= sizeof(address.sun_path))
+            throw PIPELINE_ERROR::no_source_exception();
+        strcpy(address.sun_path, source.c_str());
+
+        int fd{socket(AF_UNIX, SOCK_STREAM, 0)};
+        if (fd < 0)
+            throw PIPELINE_ERROR::no_source_exception();
+        if (connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0){
+            ::close(fd);
+            throw PIPELINE_ERROR::no_source_exception();
+        }
+        return fd;
+    }
+
+    int fd{::open(source.c_str(), O_RDONLY)};
+    if (fd < 0)
+        throw PIPELINE_ERROR::no_source_exception();
+    return fd;
+}
+
+/*
+ *********************************************************************
+ * View_Buffer
+ *********************************************************************
+ */
+
+//read area is the view itself, the characters are never written
+View_Buffer::View_Buffer(string_view view)
+{
+    char *first{const_cast<char*>(view.data())};
+    setg(first, first, first + view.size());
+}
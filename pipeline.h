@@ -0,0 +1,134 @@
+/*
+ *********************************************************************
+ * Ian Leuty
+ * inleuty@gmail.com
+ * 10/19/2026
+ *********************************************************************
+ * timing event pipeline declaration
+ *********************************************************************
+ * Applies a stream of timing events to the registry.
+ *
+ *      reader  -> parser -> batcher -> applier
+ *
+ * The reader pulls chunks of whole lines from a file, a pipe ("-" for
+ * stdin) or a Unix socket. The parser splits them into events whose
+ * fields point into the chunk (nothing is copied). The batcher sorts
+ * each batch by name so the applier looks every contestant up once per
+ * batch, the whole batch together. Stages run on their own threads,
+ * joined by bounded Rings, and the applier runs on the caller's thread
+ * so only it touches the tree.
+ *
+ * One event per line:
+ *      C,<NAME>,<CHECK IN DETAILS>     check in (see check_in(istream))
+ *      S,<NAME>                        start
+ *      P,<NAME>,<KM>,<MINUTES>         split
+ *      F,<NAME>,<MINUTES>              finish
+ *********************************************************************
+ */
+
+#ifndef PIPELINE
+#define PIPELINE
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "queue.h"
+#include "core.h"
+
+//exceptions related to the pipeline
+struct PIPELINE_ERROR
+{
+    struct no_source_exception{
+        std::string msg{"\nFailed to open the event source.\n"};
+    };
+};
+
+//kinds of timing events
+enum class Timing : char{CHECK_IN, START, SPLIT, FINISH};
+
+//one event, the views point into the chunk it was read from
+struct Timing_Event
+{
+    Timing kind;
+    std::string_view name;
+    std::string_view details;
+};
+
+//whole lines read from the source
+struct Chunk
+{
+    std::vector<char> bytes;
+};
+
+//events grouped by name (in arrival order for each name)
+//the chunks are held until the events that point into them are applied
+struct Batch
+{
+    std::vector<std::shared_ptr<const Chunk>> chunks;
+    std::vector<Timing_Event> events;
+};
+
+//one name's events within a batch, in arrival order
+struct Run
+{
+    std::string_view name;
+    const Timing_Event *events;
+    int count;
+};
+
+class Pipeline
+{
+    public:
+        //called once per batch with the run of every name in it, in name order,
+        //so the applier can look the whole batch up at once
+        //returns how many events were applied
+        typedef std::function<long(const std::vector<Run> &runs)> applier;
+
+        Pipeline(int queue_size = 64, int batch_size = 4096);
+
+        //run every stage until the source is exhausted
+        //returns the number of events applied
+        long run(const std::string &source, const applier &apply);
+
+        //apply one event to a contestant, true if it was accepted
+        //'changed' is whether the contestant's state changed, which a rejected
+        //event can do too (a cyclist checking in without a waiver is disqualified)
+        static bool apply(Contestant &contestant, const Timing_Event &event, bool &changed);
+
+        long events_read() const;
+        long events_rejected() const;
+        long batches() const;
+
+    private:
+        int batch_size;
+
+        Ring<std::shared_ptr<const Chunk>> chunks;
+        Ring<Batch> parsed;
+        Ring<Batch> sorted;
+
+        std::atomic<long> received;
+        std::atomic<long> rejected;
+        std::atomic<long> batched;
+
+        //stages
+        void reader(int fd);
+        void parser();
+        void batcher();
+
+        bool parse(std::string_view line, Timing_Event &event) const;
+        static int open(const std::string &source);
+        static bool accept(Contestant &contestant, const Timing_Event &event);
+};
+
+//input stream buffer over characters that are not owned
+//lets check_in read its details straight out of a chunk
+class View_Buffer : public std::streambuf
+{
+    public:
+        View_Buffer(std::string_view view);
+};
+
+#endif
@@ -0,0 +1,278 @@
+/*
+ *********************************************************************
+ * Ian Leuty
+ * inleuty@gmail.com
+ * 10/19/2026
+ *********************************************************************
+ * cold profile store definition
+ *********************************************************************
+ */
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include "profile.h"
+
+using std::string;
+
+/*
+ *********************************************************************
+ * Profile_Store
+ * data members are:
+ *      std::vector<std::string> texts;
+ *      std::vector<Span> spans;
+ *      int fd;
+ *      uint64_t end;
+ *      std::vector<uint32_t> references;
+ *      std::vector<uint32_t> unused;
+ *      uint64_t dead;
+ *      std::unordered_multimap<uint64_t, uint32_t> index;
+ *      std::mutex lock;
+ *********************************************************************
+ */
+
+//constructor, id 0 is the empty text
+Profile_Store::Profile_Store() : texts(1), fd(-1), end(0), references(1), dead(0) {}
+
+//destructor, the page file is only scratch space
+Profile_Store::~Profile_Store()
+{
+    if (fd >= 0)
+        ::close(fd);
+}
+
+//the store every contestant uses
+Profile_Store& Profile_Store::shared()
+{
+    static Profile_Store store;
+    return store;
+}
+
+//intern 'text'
+uint32_t Profile_Store::put(const string &text)
+{
+    if (text.empty())
+        return 0;
+    std::lock_guard<std::mutex> held(lock);
+    return intern(text);
+}
+
+//take the new text before releasing the old one, so setting the same text keeps its id
+void Profile_Store::set(uint32_t &id, const string &text)
+{
+    uint32_t previous{id};
+    id = put(text);
+    release(previous);
+}
+
+//drop a reference, freeing the id with the last one
+void Profile_Store::release(uint32_t id)
+{
+    if (!id)
+        return;
+    std::lock_guard<std::mutex> held(lock);
+    if (id >= references.size() || !references[id] || --references[id])
+        return;
+    forget(id);
+}
+
+//find or add 'text' and take a reference to it, the lock is held
+uint32_t Profile_Store::intern(const string &text)
+{
+    const uint64_t key{hash(text)};
+    auto [first, last]{index.equal_range(key)};
+    for (auto match{first}; match != last; ++match)
+        if (read(match -> second) == text){
+            ++references[match -> second];
+            return match -> second;
+        }
+
+    //a freed id is reused before the store grows
+    uint32_t id{};
+    if (!unused.empty()){
+        id = unused.back();
+        unused.pop_back();
+    }
+    else{
+        id = references.size();
+        references.push_back(0);
+        if (fd < 0)
+            texts.emplace_back();
+        else
+            spans.push_back(Span{0, 0});
+    }
+
+    if (fd < 0)
+        texts[id] = text;
+    else{
+        ssize_t written{pwrite(fd, text.data(), text.size(), end)};
+        if (written != static_cast<ssize_t>(text.size())){
+            unused.push_back(id);
+            throw PROFILE_ERROR::page_exception();
+        }
+        spans[id] = Span{end, static_cast<uint32_t>(text.size())};
+        end += text.size();
+    }
+    references[id] = 1;
+    index.emplace(key, id);
+    return id;
+}
+
+//the last reference to 'id' is gone, the lock is held
+void Profile_Store::forget(uint32_t id)
+{
+    auto [first, last]{index.equal_range(hash(read(id)))};
+    for (auto match{first}; match != last; ++match)
+        if (match -> second == id){
+            index.erase(match);
+            break;
+        }
+
+    if (fd < 0)
+        string().swap(texts[id]);
+    else{
+        dead += spans[id].length;
+        spans[id] = Span{0, 0};
+        if (dead >= PACK_AFTER && dead * 2 >= end)
+            pack();
+    }
+    unused.push_back(id);
+}
+
+//move the live texts down over the dead ones and cut the file, the lock is held
+//in file order each text only moves over dead bytes or its own, so a failed write
+//leaves every span right (its text is still where it was)
+bool Profile_Store::pack()
+{
+    std::vector<uint32_t> live;
+    for (uint32_t id{1}; id < spans.size(); ++id)
+        if (spans[id].length)
+            live.push_back(id);
+    std::sort(live.begin(), live.end(), [this](uint32_t a, uint32_t b){
+        return spans[a].offset < spans[b].offset;
+    });
+
+    uint64_t offset{};
+    for (uint32_t id : live){
+        if (spans[id].offset != offset){
+            const string text{read(id)};
+            if (text.size() != spans[id].length
+                || pwrite(fd, text.data(), text.size(), offset) != static_cast<ssize_t>(text.size()))
+                return false;
+            spans[id].offset = offset;
+        }
+        offset += spans[id].length;
+    }
+
+    if (ftruncate(fd, offset) != 0)
+        return false;
+    dead = 0;
+    end = offset;
+    return true;
+}
+
+//the text with 'id', "" for an unknown id
+string Profile_Store::get(uint32_t id) const
+{
+    if (!id)
+        return "";
+    std::lock_guard<std::mutex> held(lock);
+    return read(id);
+}
+
+//write every text to the file, then drop them from memory
+void Profile_Store::page_to(const string &filename)
+{
+    std::lock_guard<std::mutex> held(lock);
+    if (fd >= 0)
+        return;
+
+    int file{::open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0600)};
+    if (file < 0)
+        throw PROFILE_ERROR::page_exception();
+
+    std::vector<Span> paged(texts.size(), Span{0, 0});
+    uint64_t offset{};
+    for (size_t id{1}; id < texts.size(); ++id){
+        const string &text{texts[id]};
+        if (pwrite(file, text.data(), text.size(), offset) != static_cast<ssize_t>(text.size())){
+            ::close(file);
+            throw PROFILE_ERROR::page_exception();
+        }
+        paged[id] = Span{offset, static_cast<uint32_t>(text.size())};
+        offset += text.size();
+    }
+
+    fd = file;
+    end = offset;
+    spans.swap(paged);
+    std::vector<string>().swap(texts);
+}
+
+//true once the texts live in a file
+bool Profile_Store::is_paged() const
+{
+    std::lock_guard<std::mutex> held(lock);
+    return fd >= 0;
+}
+
+//number of texts still referenced, "" included
+int Profile_Store::size() const
+{
+    std::lock_guard<std::mutex> held(lock);
+    return references.size() - unused.size();
+}
+
+//the texts (or their spans once paged) and the intern index
+void Profile_Store::account(Memory &usage) const
+{
+    std::lock_guard<std::mutex> held(lock);
+    if (texts.capacity())
+        usage.allocation(texts.capacity() * sizeof(string), texts.data());
+    for (const auto &text : texts)
+        usage.string(text);
+    if (spans.capacity())
+        usage.allocation(spans.capacity() * sizeof(Span), spans.data());
+    if (references.capacity())
+        usage.allocation(references.capacity() * sizeof(uint32_t), references.data());
+    if (unused.capacity())
+        usage.allocation(unused.capacity() * sizeof(uint32_t), unused.data());
+
+    //each entry is a node holding a next pointer and the pair, plus the bucket array
+    for (size_t i{}; i < index.size(); ++i)
+        usage.allocation(sizeof(void*) + sizeof(std::pair<const uint64_t, uint32_t>));
+    usage.allocation(index.bucket_count() * sizeof(void*));
+}
+
+//text 'id' from memory or the page file, the lock is held
+string Profile_Store::read(uint32_t id) const
+{
+    if (fd < 0)
+        return id < texts.size() ? texts[id] : "";
+    if (id >= spans.size())
+        return "";
+
+    string text(spans[id].length, '\0');
+    size_t done{};
+    while (done < text.size()){
+        ssize_t count{pread(fd, &text[done], text.size() - done, spans[id].offset + done)};
+        if (count < 0 && errno == EINTR)
+            continue;
+        if (count <= 0)
+            return "";
+        done += count;
+    }
+    return text;
+}
+
+//FNV-1a
+uint64_t Profile_Store::hash(const string &text)
+{
+    uint64_t bits{1469598103934665603ull};
+    for (unsigned char c : text){
+        bits ^= c;
+        bits *= 1099511628211ull;
+    }
+    return bits;
+}
@@ -0,0 +1,113 @@
+/*
+ *********************************************************************
+ * Ian Leuty
+ * inleuty@gmail.com
+ * 10/19/2026
+ *********************************************************************
+ * cold profile store declaration
+ *********************************************************************
+ * Keeps the rarely read strings of a contestant (conversation topic,
+ * bike, emergency contact) out of the contestant, which holds a 4
+ * byte id instead. Whole field sweeps (starting a race, projecting
+ * the field) then only touch the small hot part of each contestant.
+ *
+ * Texts are interned, so the handful of topics and bikes a big event
+ * repeats are stored once. page_to moves every text to a local file
+ * and keeps only its offset and length in memory; later texts are
+ * appended to the file and read back with pread when displayed.
+ *
+ * Texts are never changed, a new value is a new id. Id 0 is "".
+ * Each id counts the contestants holding it (put and set take a
+ * reference, release gives it back) and the last release frees it for
+ * the next new text, so a long running event with people coming and
+ * going keeps only the texts of those still registered. Once freed
+ * texts are half of the page file the live ones are packed to its
+ * front.
+ *********************************************************************
+ */
+
+#ifndef PROFILE
+#define PROFILE
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "footprint.h"
+
+//exceptions related to the profile store
+struct PROFILE_ERROR
+{
+    struct page_exception{
+        std::string msg{"\nFailed to page profiles to the file.\n"};
+    };
+};
+
+class Profile_Store
+{
+    public:
+        Profile_Store();
+        ~Profile_Store();
+        Profile_Store(const Profile_Store &source) = delete;
+        Profile_Store& operator=(const Profile_Store &source) = delete;
+
+        //the store every contestant uses
+        static Profile_Store& shared();
+
+        //id of 'text', the same text always gets the same id
+        //every put is a reference to the id, give it back with release
+        uint32_t put(const std::string &text);
+        std::string get(uint32_t id) const;
+
+        //point 'id' at 'text', releasing what it held
+        void set(uint32_t &id, const std::string &text);
+
+        //give back a reference, the text goes with the last one
+        //never throws (contestant destructors call it)
+        void release(uint32_t id);
+
+        //move every text to 'filename' and keep only where each one is
+        //throws page_exception
+        void page_to(const std::string &filename);
+        bool is_paged() const;
+
+        int size() const;
+
+        //memory held for the texts and their index
+        void account(Memory &usage) const;
+
+    private:
+        struct Span
+        {
+            uint64_t offset;
+            uint32_t length;
+        };
+
+        //in memory until paged, then on file
+        std::vector<std::string> texts;
+        std::vector<Span> spans;
+        int fd;
+        uint64_t end;
+
+        //references to each id, freed ids waiting for a new text, bytes of the file they left
+        std::vector<uint32_t> references;
+        std::vector<uint32_t> unused;
+        uint64_t dead;
+
+        //the file is packed once this many bytes (and half of it) are dead
+        static const uint64_t PACK_AFTER{1 << 20};
+
+        //hash of a text to the ids that have that hash
+        std::unordered_multimap<uint64_t, uint32_t> index;
+
+        mutable std::mutex lock;
+
+        std::string read(uint32_t id) const;
+        uint32_t intern(const std::string &text);
+        void forget(uint32_t id);
+        bool pack();
+        static uint64_t hash(const std::string &text);
+};
+
+#endif
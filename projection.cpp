@@ -0,0 +1,74 @@
+/*
+ *********************************************************************
+ * Ian Leuty
+ * inleuty@gmail.com
+ * 10/19/2026
+ *********************************************************************
+ * projection engine definition
+ *********************************************************************
+ */
+
+#include "projection.h"
+
+//8 floats per lane group
+//gcc lowers this to whatever the target has (2 x SSE, 1 x AVX, NEON...)
+typedef float lanes __attribute__((vector_size(32)));
+static const int WIDTH{sizeof(lanes) / sizeof(float)};
+
+//default constructor
+Projection::Projection() {}
+
+//pull rate and span out of every contestant into the contiguous arrays
+//this is the only place the virtual call is made
+int Projection::gather(const std::vector<std::shared_ptr<Contestant>> &field)
+{
+    const int count{static_cast<int>(field.size())};
+    rates.resize(count);
+    spans.resize(count);
+    contestants = field;
+    for (int i{}; i < count; ++i)
+        field[i] -> gather(rates[i], spans[i]);
+    return count;
+}
+
+//vector wrapper
+int Projection::project(int time, std::vector<float> &completion) const
+{
+    completion.resize(rates.size());
+    return project(time, completion.data());
+}
+
+//project every contestant WIDTH at a time
+//the operations (and their order) are the same as predict_completion's
+//so the results are identical, the tail is finished one at a time
+int Projection::project(int time, float *completion) const
+{
+    const int count{size()};
+    const float hours{static_cast<float>(time) / 60};
+    const lanes hours_wide = lanes{} + hours;
+    const lanes percent = lanes{} + 100.0f;
+
+    int i{};
+    for (; i + WIDTH <= count; i += WIDTH){
+        lanes rate, span;
+        memcpy(&rate, &rates[i], sizeof(lanes));
+        memcpy(&span, &spans[i], sizeof(lanes));
+        lanes result = ((hours_wide * rate) / span) * percent;
+        memcpy(&completion[i], &result, sizeof(lanes));
+    }
+    for (; i < count; ++i)
+        completion[i] = ((hours * rates[i]) / spans[i]) * 100;
+    return count;
+}
+
+//number of contestants gathered
+int Projection::size() const
+{
+    return static_cast<int>(rates.size());
+}
+
+//the contestant whose completion is at 'index'
+const std::shared_ptr<Contestant>& Projection::contestant(int index) const
+{
+    return contestants[index];
+}
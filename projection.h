@@ -0,0 +1,52 @@
+/*
+ *********************************************************************
+ * Ian Leuty
+ * inleuty@gmail.com
+ * 10/19/2026
+ *********************************************************************
+ * projection engine declaration
+ *********************************************************************
+ * Projects race completion for an entire field at once.
+ *
+ * predict_completion is a virtual call per contestant. For a whole
+ * field the terms of that call are gathered once into contiguous
+ * arrays (structure of arrays) and every projection after that is a
+ * vectorized sweep:
+ *
+ *      completion = ((hours * rate) / span) * 100
+ *
+ * rate and span come from each contestant's gather override, so the
+ * sweep matches predict_completion bit for bit.
+ *********************************************************************
+ */
+
+#ifndef PROJECTION
+#define PROJECTION
+
+#include <memory>
+#include <vector>
+#include "core.h"
+
+class Projection
+{
+    public:
+        Projection();
+
+        //(re)gather the field, returns the number of contestants gathered
+        int gather(const std::vector<std::shared_ptr<Contestant>> &field);
+
+        //completion percentage for every gathered contestant
+        //after 'time' minutes, in the order they were gathered
+        int project(int time, std::vector<float> &completion) const;
+        int project(int time, float *completion) const;
+
+        int size() const;
+        const std::shared_ptr<Contestant>& contestant(int index) const;
+
+    private:
+        std::vector<float> rates;
+        std::vector<float> spans;
+        std::vector<std::shared_ptr<Contestant>> contestants;
+};
+
+#endif
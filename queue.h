@@ -0,0 +1,72 @@
+/*
+ *********************************************************************
+ * Ian Leuty
+ * inleuty@gmail.com
+ * 10/19/2026
+ *********************************************************************
+ * bounded queue declaration
+ *********************************************************************
+ * Single producer, single consumer ring buffer.
+ *
+ * Lock free: the producer only writes 'tail' and the consumer only
+ * writes 'head', each on its own cache line. A full ring makes the
+ * producer wait (backpressure), an empty one makes the consumer wait
+ * until something is pushed or the producer closes the ring.
+ *
+ * A wait spins briefly, yields a few times, then sleeps on a condition
+ * variable, so a pipeline reading an idle pipe or socket uses no CPU.
+ * The other side only takes the lock to wake it when 'sleepers' says
+ * someone is asleep.
+ *********************************************************************
+ */
+
+#ifndef QUEUE
+#define QUEUE
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+template<typename T>
+class Ring
+{
+    public:
+        //capacity is rounded up to a power of 2
+        Ring(int capacity);
+
+        //producer side
+        void push(T item);
+        bool try_push(T &item);
+        void close();
+
+        //consumer side, pop returns false once the ring is closed and drained
+        bool pop(T &item);
+        bool try_pop(T &item);
+
+        int capacity() const;
+
+    private:
+        std::vector<T> slots;
+        size_t mask;
+
+        alignas(64) std::atomic<size_t> head;
+        alignas(64) std::atomic<size_t> tail;
+        alignas(64) std::atomic<bool> closed;
+        std::atomic<int> sleepers;
+
+        std::mutex lock;
+        std::condition_variable woken;
+
+        //tries before yielding and before sleeping
+        static const int SPINS{64};
+        static const int YIELDS{16};
+
+        template<typename READY> void wait(int &spins, READY ready);
+        void wake();
+};
+
+#include "queue.tpp"
+
+#endif
@@ -0,0 +1,140 @@
+/*
+ *********************************************************************
+ * Ian Leuty
+ * inleuty@gmail.com
+ * 10/19/2026
+ *********************************************************************
+ * bounded queue template definition
+ *********************************************************************
+ */
+
+/*
+ *********************************************************************
+ * ring template
+ * data members are:
+ *      std::vector<T> slots;
+ *      size_t mask;
+ *      std::atomic<size_t> head;
+ *      std::atomic<size_t> tail;
+ *      std::atomic<bool> closed;
+ *      std::atomic<int> sleepers;
+ *      std::mutex lock;
+ *      std::condition_variable woken;
+ *********************************************************************
+ */
+
+//constructor, head and tail only ever count up, masking finds the slot
+template<typename T>
+Ring<T>::Ring(int capacity) : head(0), tail(0), closed(false), sleepers(0)
+{
+    size_t size{1};
+    while (size < static_cast<size_t>(capacity))
+        size <<= 1;
+    slots.resize(size);
+    mask = size - 1;
+}
+
+//push, waiting while the ring is full
+template<typename T>
+void Ring<T>::push(T item)
+{
+    int spins{};
+    while (!try_push(item))
+        wait(spins, [this]{
+            return tail.load(std::memory_order_relaxed) - head.load(std::memory_order_acquire) <= mask;
+        });
+}
+
+//push if there is room, 'item' is left alone otherwise
+template<typename T>
+bool Ring<T>::try_push(T &item)
+{
+    const size_t at{tail.load(std::memory_order_relaxed)};
+    if (at - head.load(std::memory_order_acquire) > mask)
+        return false;
+    slots[at & mask] = std::move(item);
+    tail.store(at + 1, std::memory_order_release);
+    wake();
+    return true;
+}
+
+//no more pushes, the consumer drains what is left
+template<typename T>
+void Ring<T>::close()
+{
+    closed.store(true, std::memory_order_release);
+    wake();
+}
+
+//pop, waiting while the ring is empty
+template<typename T>
+bool Ring<T>::pop(T &item)
+{
+    int spins{};
+    while (!try_pop(item)){
+        //closed is checked before trying again so a last push is not missed
+        if (closed.load(std::memory_order_acquire))
+            return try_pop(item);
+        wait(spins, [this]{
+            return head.load(std::memory_order_relaxed) != tail.load(std::memory_order_acquire)
+                || closed.load(std::memory_order_acquire);
+        });
+    }
+    return true;
+}
+
+//pop if there is anything
+template<typename T>
+bool Ring<T>::try_pop(T &item)
+{
+    const size_t at{head.load(std::memory_order_relaxed)};
+    if (at == tail.load(std::memory_order_acquire))
+        return false;
+    item = std::move(slots[at & mask]);
+    head.store(at + 1, std::memory_order_release);
+    wake();
+    return true;
+}
+
+//number of slots
+template<typename T>
+int Ring<T>::capacity() const
+{
+    return static_cast<int>(slots.size());
+}
+
+//spin briefly, give up the core a few times, then sleep until 'ready' (what the
+//caller is waiting for) is true. 'sleepers' is raised before 'ready' is checked
+//and the other side changes head, tail or closed before reading it, with a full
+//fence between on both sides, so either the sleeper sees the change or it is woken
+template<typename T>
+template<typename READY>
+void Ring<T>::wait(int &spins, READY ready)
+{
+    if (++spins < SPINS)
+        return;
+    if (spins < SPINS + YIELDS){
+        std::this_thread::yield();
+        return;
+    }
+
+    sleepers.fetch_add(1);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    {
+        std::unique_lock<std::mutex> held(lock);
+        woken.wait(held, ready);
+    }
+    sleepers.fetch_sub(1);
+    spins = 0;
+}
+
+//wake whoever is asleep on the ring after head, tail or closed changed
+template<typename T>
+void Ring<T>::wake()
+{
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!sleepers.load(std::memory_order_relaxed))
+        return;
+    std::lock_guard<std::mutex> held(lock);
+    woken.notify_all();
+}
@@ -0,0 +1,248 @@
+/*
+ *********************************************************************
+ * Ian Leuty
+ * inleuty@gmail.com
+ * 10/19/2026
+ *********************************************************************
+ * script (batch mode) definition
+ *********************************************************************
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+#include "script.h"
+
+using namespace std;
+
+/*
+ *********************************************************************
+ * Script
+ * data members are:
+ *      Red_Black<std::string, std::vector<double>> latencies;
+ *      int commands;
+ *      int failed;
+ *      double elapsed;
+ *********************************************************************
+ */
+
+//default constructor
+Script::Script() : commands(0), failed(0), elapsed(0) {}
+
+//open the script and run it
+int Script::run(const string &script)
+{
+    if (script == "-")
+        return run(cin);
+
+    ifstream in(script);
+    if (!in)
+        throw SCRIPT_ERROR::no_script_exception();
+    return run(in);
+}
+
+//run and time every command, the journal is checkpointed (and compacted if due) at the end
+int Script::run(istream &in)
+{
+    int failures{};
+    string line;
+    auto began{chrono::steady_clock::now()};
+    while (getline(in, line)){
+        if (!line.empty() && line.back() == '\r')
+            line.pop_back();
+        if (line.empty() || line[0] == '#')
+            continue;
+
+        size_t comma{line.find(',')};
+        string command{line.substr(0, comma)};
+        istringstream arguments(comma == string::npos ? "" : line.substr(comma + 1));
+
+        auto start{chrono::steady_clock::now()};
+        bool succeeded{execute(command, arguments)};
+        chrono::duration<double, micro> taken{chrono::steady_clock::now() - start};
+
+        latencies[command].push_back(taken.count());
+        ++commands;
+        if (!succeeded)
+            ++failures;
+    }
+    checkpoint();
+    compact_if_due();
+    elapsed += chrono::duration<double>(chrono::steady_clock::now() - began).count();
+    failed += failures;
+    return failures;
+}
+
+//latency per command and overall throughput
+void Script::report(ostream &out)
+{
+    vector<string> names;
+    latencies.fetch_keys(names);
+
+    out << "\n" << left << setw(12) << "command" << right << setw(10) << "runs"
+        << setw(12) << "mean us" << setw(12) << "p50 us" << setw(12) << "p99 us" << setw(12) << "max us" << "\n";
+    for (const auto &name : names){
+        vector<double> samples{*latencies.find_ptr(name)};
+        sort(samples.begin(), samples.end());
+        double total{};
+        for (double sample : samples)
+            total += sample;
+        const size_t count{samples.size()};
+        out << left << setw(12) << name << right << setw(10) << count << fixed << setprecision(2)
+            << setw(12) << total / count
+            << setw(12) << samples[count / 2]
+            << setw(12) << samples[min(count - 1, count * 99 / 100)]
+            << setw(12) << samples.back() << "\n";
+    }
+    out << defaultfloat << "\n" << commands << " commands (" << failed << " failed) in " << elapsed << " seconds, "
+        << commands / max(elapsed, 1e-9) << " commands/s." << endl;
+}
+
+//run one command, false if it failed or a query found nothing
+bool Script::execute(const string &command, istream &arguments)
+{
+    string name;
+
+    if (command == "load"){
+        getline(arguments, name);
+        try{
+            return load(name) > 0;
+        }
+        catch (APPLICATION_ERROR::no_file_exception &error){
+            return false;
+        }
+    }
+
+    if (command == "register"){
+        int type{};
+        arguments >> type;
+        arguments.ignore(100, ',');
+        getline(arguments, name, ',');
+        return admit(type, name, arguments);
+    }
+
+    if (command == "checkin")
+        return apply(Timing::CHECK_IN, arguments);
+    if (command == "split")
+        return apply(Timing::SPLIT, arguments);
+    if (command == "finish")
+        return apply(Timing::FINISH, arguments);
+
+    if (command == "start"){
+        int race{};
+        arguments >> race;
+        return start(race);
+    }
+
+    if (command == "disqualify"){
+        getline(arguments, name);
+        auto contestant{tree.find_ptr(name)};
+        if (!contestant || !(*contestant) -> disqualify())
+            return false;
+        refresh(name);
+        return true;
+    }
+
+    if (command == "remove"){
+        getline(arguments, name);
+        withdraw(name);
+        return tree.remove(name);
+    }
+
+    if (command == "purge"){
+        int no_shows{};
+        arguments >> no_shows;
+        return purge(no_shows != 0) > 0;
+    }
+
+    if (command == "find"){
+        getline(arguments, name);
+        return (roster.empty() ? tree.find_ptr(name) : roster.find_ptr(name)) != nullptr;
+    }
+
+    if (command == "archive"){
+        string event;
+        getline(arguments, name, ',');
+        getline(arguments, event);
+        try{
+            return archive(name, event) > 0;
+        }
+        catch (DISK_ERROR::open_exception &error){
+            return false;
+        }
+        catch (DISK_ERROR::corrupt_exception &error){
+            return false;
+        }
+        catch (DISK_ERROR::record_exception &error){
+            return false;
+        }
+        catch (DISK_ERROR::write_exception &error){
+            return false;
+        }
+    }
+
+    if (command == "close"){
+        roster = freeze(tree);
+        return !roster.empty();
+    }
+
+    if (command == "position"){
+        getline(arguments, name);
+        return leaderboard.position(name) > 0;
+    }
+
+    if (command == "top"){
+        int k{};
+        arguments >> k;
+        vector<Standing> leaders;
+        vector<shared_ptr<Contestant>> contestants;
+        return leaderboard.top(k, leaders, contestants) > 0;
+    }
+
+    if (command == "stats"){
+        string high;
+        getline(arguments, name, ',');
+        getline(arguments, high);
+        return tree.aggregate(name, high).contestants > 0;
+    }
+
+    if (command == "bib"){
+        int number{};
+        arguments >> number;
+        return bibs.find_ptr(number) != nullptr;
+    }
+
+    if (command == "events"){
+        getline(arguments, name);
+        Pipeline pipeline;
+        long unknown{};
+        try{
+            return ingest(pipeline, name, unknown) > 0;
+        }
+        catch (PIPELINE_ERROR::no_source_exception &error){
+            return false;
+        }
+    }
+
+    return false;
+}
+
+//<NAME>,<DETAILS> applied the same way the ingest pipeline applies it
+bool Script::apply(Timing kind, istream &arguments)
+{
+    string name, details;
+    getline(arguments, name, ',');
+    getline(arguments, details);
+
+    auto contestant{tree.find_ptr(name)};
+    if (!contestant)
+        return false;
+
+    //a rejected event can still have changed the contestant (disqualified at check in)
+    bool changed{};
+    const bool accepted{Pipeline::apply(**contestant, Timing_Event{kind, name, details}, changed)};
+    if (changed)
+        refresh(name);
+    return accepted;
+}
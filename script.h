@@ -0,0 +1,74 @@
+/*
+ *********************************************************************
+ * Ian Leuty
+ * inleuty@gmail.com
+ * 10/19/2026
+ *********************************************************************
+ * script (batch mode) declaration
+ *********************************************************************
+ * Runs a command script against the registry without prompts, so an
+ * event day can be replayed or a load test run from a file:
+ *
+ *      program3 -b <script> [-j <journal>]
+ *
+ * One command per line, fields separated by commas, # for comments:
+ *      load,<ROSTER FILE>
+ *      register,<TYPE>,<NAME>,<ROSTER FIELDS>
+ *      checkin,<NAME>,<CHECK IN DETAILS>
+ *      start,<1|2|3>
+ *      split,<NAME>,<KM>,<MINUTES>
+ *      finish,<NAME>,<MINUTES>
+ *      disqualify,<NAME>
+ *      remove,<NAME>
+ *      purge,<0|1>              (1 to remove no-shows as well)
+ *      close                    (close registration, see Menu::close_registration)
+ *      archive,<FILE>,<EVENT>   (see Menu::archive)
+ *      find,<NAME>
+ *      position,<NAME>
+ *      top,<K>
+ *      bib,<NUMBER>
+ *      stats,<FROM NAME>,<TO NAME>
+ *      events,<EVENT FILE, PIPE OR SOCKET>
+ *
+ * Every command is timed, report prints the latency of each command
+ * (mean, 50th and 99th percentile, max) and the total throughput.
+ *********************************************************************
+ */
+
+#ifndef SCRIPT
+#define SCRIPT
+
+#include "application.h"
+
+//exceptions related to scripts
+struct SCRIPT_ERROR
+{
+    struct no_script_exception{
+        std::string msg{"\nFailed to open the script.\n"};
+    };
+};
+
+class Script : public Menu
+{
+    public:
+        Script();
+
+        //run every command in 'script' ("-" for stdin)
+        //returns the number of commands that failed
+        int run(const std::string &script);
+        void report(std::ostream &out);
+
+    private:
+        //microseconds taken by every run of each command
+        Red_Black<std::string, std::vector<double>> latencies;
+
+        int commands;
+        int failed;
+        double elapsed;
+
+        int run(std::istream &in);
+        bool execute(const std::string &command, std::istream &arguments);
+        bool apply(Timing kind, std::istream &arguments);
+};
+
+#endif
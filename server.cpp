@@ -0,0 +1,627 @@
+/*
+ *********************************************************************
+ * Ian Leuty
+ * inleuty@gmail.com
+ * 10/19/2026
+ *********************************************************************
+ * query server definition
+ *********************************************************************
+ */
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+#include "server.h"
+
+using namespace std;
+
+//most events taken from epoll per wake
+static const int WAKE_EVENTS{64};
+
+//bytes asked of a connection per read
+static const size_t READ_SIZE{1 << 16};
+
+//the loop wakes at least this often (milliseconds) to let the journal's group commit go out
+static const int IDLE_WAKE{10};
+
+//a server that never goes idle still checkpoints (and republishes its snapshot) this often
+//compaction waits for an idle wake
+static const auto BUSY_CHECKPOINT{std::chrono::milliseconds(250)};
+
+/*
+ *********************************************************************
+ * Protocol
+ *********************************************************************
+ */
+
+//start a frame, the length is filled in by finish
+size_t Protocol::begin(string &out, char code)
+{
+    size_t start{out.size()};
+    out.append(sizeof(uint32_t), '\0');
+    out.push_back(code);
+    return start;
+}
+
+//write the length of the frame started at 'start'
+void Protocol::finish(string &out, size_t start)
+{
+    uint32_t length(out.size() - start - sizeof(uint32_t));
+    memcpy(&out[start], &length, sizeof(length));
+}
+
+//<uint16 LENGTH><BYTES>, anything past 65535 bytes is cut off
+void Protocol::put(string &out, const string &text)
+{
+    uint16_t length(min<size_t>(text.size(), UINT16_MAX));
+    put(out, length);
+    out.append(text, 0, length);
+}
+
+void Protocol::put(string &out, uint16_t number)
+{
+    out.append(reinterpret_cast<const char*>(&number), sizeof(number));
+}
+
+void Protocol::put(string &out, float number)
+{
+    out.append(reinterpret_cast<const char*>(&number), sizeof(number));
+}
+
+//the get functions advance 'next' and are false if the field runs past 'end'
+bool Protocol::get(const char *&next, const char *end, string &text)
+{
+    uint16_t length{};
+    if (!get(next, end, length) || end - next < length)
+        return false;
+    text.assign(next, length);
+    next += length;
+    return true;
+}
+
+bool Protocol::get(const char *&next, const char *end, uint16_t &number)
+{
+    if (end - next < static_cast<long>(sizeof(number)))
+        return false;
+    memcpy(&number, next, sizeof(number));
+    next += sizeof(number);
+    return true;
+}
+
+bool Protocol::get(const char *&next, const char *end, float &number)
+{
+    if (end - next < static_cast<long>(sizeof(number)))
+        return false;
+    memcpy(&number, next, sizeof(number));
+    next += sizeof(number);
+    return true;
+}
+
+//length of the whole frame at the front of 'bytes', 0 until it has all arrived
+size_t Protocol::framed(const char *bytes, size_t count)
+{
+    uint32_t length{};
+    if (count < sizeof(length))
+        return 0;
+    memcpy(&length, bytes, sizeof(length));
+    if (length > MAX_FRAME)
+        return MAX_FRAME + 1;
+    if (count < sizeof(length) + length)
+        return 0;
+    return sizeof(length) + length;
+}
+
+//fill in a socket address, false if 'address' cannot be used
+//'tcp' is set for host:port
+static bool resolve(const string &address, sockaddr_storage &storage, socklen_t &size, bool &tcp, bool listening)
+{
+    memset(&storage, 0, sizeof(storage));
+    size_t colon{address.rfind(':')};
+    tcp = address.find('/') == string::npos && colon != string::npos;
+
+    if (!tcp){
+        auto *local{reinterpret_cast<sockaddr_un*>(&storage)};
+        if (address.empty() || address.size() >= sizeof(local -> sun_path))
+            return false;
+        local -> sun_family = AF_UNIX;
+        strcpy(local -> sun_path, address.c_str());
+        size = sizeof(sockaddr_un);
+        return true;
+    }
+
+    string host{address.substr(0, colon)};
+    int port{atoi(address.c_str() + colon + 1)};
+    if (port <= 0 || port > 65535)
+        return false;
+
+    auto *inet{reinterpret_cast<sockaddr_in*>(&storage)};
+    inet -> sin_family = AF_INET;
+    inet -> sin_port = htons(port);
+    size = sizeof(sockaddr_in);
+    if (host.empty())
+        inet -> sin_addr.s_addr = htonl(listening ? INADDR_ANY : INADDR_LOOPBACK);
+    else if (host == "localhost")
+        inet -> sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    else if (inet_pton(AF_INET, host.c_str(), &inet -> sin_addr) != 1)
+        return false;
+    return true;
+}
+
+//listening socket on 'address', a stale Unix socket file is replaced
+int Protocol::listen(const string &address)
+{
+    sockaddr_storage storage;
+    socklen_t size{};
+    bool tcp{};
+    if (!resolve(address, storage, size, tcp, true))
+        return -1;
+
+    int fd{socket(storage.ss_family, SOCK_STREAM | SOCK_CLOEXEC, 0)};
+    if (fd < 0)
+        return -1;
+
+    int yes{1};
+    struct stat info{};
+    if (tcp)
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes));
+    else if (stat(address.c_str(), &info) == 0 && S_ISSOCK(info.st_mode))
+        unlink(address.c_str());
+
+    if (bind(fd, reinterpret_cast<sockaddr*>(&storage), size) != 0 || ::listen(fd, SOMAXCONN) != 0){
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+//blocking connection to 'address', Nagle is off so pipelined requests go out at once
+int Protocol::connect(const string &address)
+{
+    sockaddr_storage storage;
+    socklen_t size{};
+    bool tcp{};
+    if (!resolve(address, storage, size, tcp, false))
+        return -1;
+
+    int fd{socket(storage.ss_family, SOCK_STREAM | SOCK_CLOEXEC, 0)};
+    if (fd < 0)
+        return -1;
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&storage), size) != 0){
+        ::close(fd);
+        return -1;
+    }
+    int yes{1};
+    if (tcp)
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &yes, sizeof(yes));
+    return fd;
+}
+
+/*
+ *********************************************************************
+ * Server
+ * the loop and every request run on the thread that calls serve
+ * data members are:
+ *      int poller;
+ *      int waker;
+ *      std::vector<int> listeners;
+ *      Red_Black<int, Connection> clients;
+ *      std::vector<int> holding;
+ *      std::atomic<bool> running;
+ *      std::atomic<long> served;
+ *********************************************************************
+ */
+
+//constructor, the waker is an eventfd that stop uses to end epoll_wait
+Server::Server() : poller(epoll_create1(EPOLL_CLOEXEC)), waker(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)),
+    running(false), served(0)
+{
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = waker;
+    epoll_ctl(poller, EPOLL_CTL_ADD, waker, &event);
+}
+
+//destructor
+Server::~Server()
+{
+    vector<int> open;
+    clients.fetch_keys(open);
+    for (int fd : open)
+        ::close(fd);
+    for (int fd : listeners)
+        ::close(fd);
+    ::close(waker);
+    ::close(poller);
+}
+
+//add a listening address
+void Server::listen(const string &address)
+{
+    int fd{Protocol::listen(address)};
+    if (fd < 0)
+        throw SERVER_ERROR::listen_exception();
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = fd;
+    epoll_ctl(poller, EPOLL_CTL_ADD, fd, &event);
+    listeners.push_back(fd);
+}
+
+//event loop
+//each wake reads what every ready connection sent, runs all of the
+//whole requests in it and answers each connection with one send
+void Server::serve()
+{
+    epoll_event events[WAKE_EVENTS];
+    auto checkpointed{chrono::steady_clock::now()};
+    running = true;
+    while (running){
+        int ready{epoll_wait(poller, events, WAKE_EVENTS, IDLE_WAKE)};
+        if (ready < 0 && errno != EINTR)
+            break;
+        if (ready <= 0 || chrono::steady_clock::now() - checkpointed >= BUSY_CHECKPOINT){
+            if (checkpoint())
+                release();
+            checkpointed = chrono::steady_clock::now();
+        }
+        //nothing is waiting, so the O(n) compactions cannot stall a client
+        if (!ready)
+            compact_if_due();
+        if (ready <= 0)
+            continue;
+
+        for (int i{}; i < ready; ++i){
+            int fd{events[i].data.fd};
+            if (fd == waker){
+                uint64_t count{};
+                while (read(waker, &count, sizeof(count)) > 0);
+                continue;
+            }
+            if (find(listeners.begin(), listeners.end(), fd) != listeners.end()){
+                accept(fd);
+                continue;
+            }
+
+            Connection *client{clients.find_ptr(fd)};
+            if (!client)
+                continue;
+
+            //a peer that only shut down its side (EOF) still gets every response,
+            //one that hung up or failed cannot read them
+            bool open{true};
+            if (!client -> closing && (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)))
+                open = receive(fd, *client);
+            if (!pump(fd, *client) || !open || (events[i].events & (EPOLLHUP | EPOLLERR)))
+                drop(fd);
+        }
+
+        //one sync for every change this wake acknowledges
+        if (!holding.empty() && sync_journal())
+            release();
+    }
+    if (checkpoint())
+        release();
+}
+
+//end serve, only touches an atomic and an eventfd
+void Server::stop()
+{
+    running = false;
+    uint64_t one{1};
+    ssize_t written{write(waker, &one, sizeof(one))};
+    (void) written;
+}
+
+//requests answered so far
+long Server::requests() const
+{
+    return served;
+}
+
+//clients connected now
+int Server::connections() const
+{
+    return clients.size();
+}
+
+//accept every connection that is waiting
+void Server::accept(int listener)
+{
+    int fd{};
+    while ((fd = accept4(listener, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC)) >= 0){
+        int yes{1};
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &yes, sizeof(yes));
+
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.fd = fd;
+        epoll_ctl(poller, EPOLL_CTL_ADD, fd, &event);
+        clients[fd] = Connection();
+        clients[fd].watching = EPOLLIN;
+    }
+}
+
+//read until the socket is drained or IN_LIMIT is buffered, false if the read failed
+//what is left is read on the next wake (epoll keeps reporting it)
+//at EOF the connection is closing: it is not read again and goes once it is answered (see pump)
+bool Server::receive(int fd, Connection &client)
+{
+    while (client.in.size() < IN_LIMIT){
+        size_t used{client.in.size()};
+        client.in.resize(used + READ_SIZE);
+        ssize_t count{read(fd, &client.in[used], READ_SIZE)};
+        client.in.resize(used + (count > 0 ? count : 0));
+        if (count > 0)
+            continue;
+        if (count < 0 && errno == EINTR)
+            continue;
+        if (!count)
+            client.closing = true;
+        return !count || errno == EAGAIN || errno == EWOULDBLOCK;
+    }
+    return true;
+}
+
+//run what has arrived and send the responses, again while sending made room for
+//requests that were waiting on OUT_LIMIT. false if the connection has to go: it failed,
+//or it is closing and every request it sent has been answered and sent
+bool Server::pump(int fd, Connection &client)
+{
+    while (true){
+        if (!run(fd, client) || !transmit(fd, client))
+            return false;
+        if (backlog(client) >= OUT_LIMIT || !Protocol::framed(client.in.data(), client.in.size()))
+            break;
+    }
+    if (client.closing && !backlog(client) && !Protocol::framed(client.in.data(), client.in.size()))
+        return false;
+    watch(fd, client);
+    return true;
+}
+
+//run every request that has fully arrived, until the responses waiting reach OUT_LIMIT
+//with a journal open a register or remove is answered into 'held', and so is everything
+//after it until the journal has synced. false on a frame too long to accept
+bool Server::run(int fd, Connection &client)
+{
+    size_t used{};
+    bool fits{true};
+    while (backlog(client) < OUT_LIMIT){
+        size_t length{Protocol::framed(client.in.data() + used, client.in.size() - used)};
+        if (length > Protocol::MAX_FRAME){
+            fits = false;
+            break;
+        }
+        if (!length)
+            break;
+
+        const char *request{client.in.data() + used + sizeof(uint32_t)};
+        const size_t size{length - sizeof(uint32_t)};
+        const bool changes{size && (request[0] == Protocol::REGISTER || request[0] == Protocol::REMOVE)};
+        if (journal.is_open() && (changes || !client.held.empty())){
+            if (client.held.empty())
+                holding.push_back(fd);
+            handle(request, size, client.held);
+        }
+        else
+            handle(request, size, client.out);
+        used += length;
+    }
+    client.in.erase(0, used);
+    return fits;
+}
+
+//responses not yet sent, held ones included
+size_t Server::backlog(const Connection &client)
+{
+    return client.out.size() - client.sent + client.held.size();
+}
+
+//the journal has synced, send every held response
+void Server::release()
+{
+    vector<int> synced;
+    synced.swap(holding);
+    for (int fd : synced){
+        Connection *client{clients.find_ptr(fd)};
+        if (!client || client -> held.empty())
+            continue;
+        client -> out += client -> held;
+        client -> held.clear();
+        if (!pump(fd, *client))
+            drop(fd);
+    }
+}
+
+//send what is waiting, false if the connection failed
+//if the socket is full the rest goes out when epoll says it is writable (see watch)
+bool Server::transmit(int fd, Connection &client)
+{
+    while (client.sent < client.out.size()){
+        ssize_t count{send(fd, client.out.data() + client.sent, client.out.size() - client.sent, MSG_NOSIGNAL)};
+        if (count < 0 && errno == EINTR)
+            continue;
+        if (count < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+            break;
+        if (count < 0)
+            return false;
+        client.sent += count;
+    }
+
+    if (client.sent == client.out.size()){
+        client.out.clear();
+        client.sent = 0;
+    }
+    return true;
+}
+
+//ask epoll for what the connection can use now: writable while responses are waiting
+//to go out, readable while they are under OUT_LIMIT and the peer has not shut down
+void Server::watch(int fd, Connection &client)
+{
+    uint32_t wanted{(!client.closing && backlog(client) < OUT_LIMIT ? EPOLLIN : 0u)
+                    | (client.sent < client.out.size() ? EPOLLOUT : 0u)};
+    if (wanted == client.watching)
+        return;
+    epoll_event event{};
+    event.events = wanted;
+    event.data.fd = fd;
+    epoll_ctl(poller, EPOLL_CTL_MOD, fd, &event);
+    client.watching = wanted;
+}
+
+//close a connection, anything not yet sent is lost
+void Server::drop(int fd)
+{
+    epoll_ctl(poller, EPOLL_CTL_DEL, fd, nullptr);
+    ::close(fd);
+    clients.remove(fd);
+}
+
+//run one request and append its response to 'out'
+void Server::handle(const char *request, size_t length, string &out)
+{
+    using namespace Protocol;
+
+    const char *next{request + 1};
+    const char *end{request + length};
+    size_t start{begin(out, OK)};
+    char status{OK};
+    string name;
+
+    switch (length ? request[0] : 0){
+        case FIND:
+            if (!get(next, end, name))
+                status = MALFORMED;
+            else if (!(roster.empty() ? tree.find(name) : roster.find(name)))
+                status = MISSING;
+            break;
+
+        case LOOKUP: {
+                if (!get(next, end, name)){
+                    status = MALFORMED;
+                    break;
+                }
+                const shared_ptr<Contestant> *contestant{roster.empty() ? tree.find_ptr(name) : roster.find_ptr(name)};
+                if (!contestant){
+                    status = MISSING;
+                    break;
+                }
+                ostringstream display;
+                (*contestant) -> display(display);
+                put(out, display.str());
+                put(out, Leaderboard::projected_finish(*contestant));
+            }
+            break;
+
+        case RANGE: {
+                string high;
+                uint16_t limit{};
+                if (!get(next, end, name) || !get(next, end, high) || !get(next, end, limit)){
+                    status = MALFORMED;
+                    break;
+                }
+                vector<string> names;
+                vector<shared_ptr<Contestant>> contestants;
+                int found{roster.empty() ? tree.fetch_range(name, high, limit, names, contestants)
+                                         : roster.fetch_range(name, high, limit, names, contestants)};
+                put(out, static_cast<uint16_t>(found));
+                for (const auto &found : names)
+                    put(out, found);
+            }
+            break;
+
+        case PREFIX: {
+                uint16_t limit{};
+                if (!get(next, end, name) || !get(next, end, limit)){
+                    status = MALFORMED;
+                    break;
+                }
+                vector<string> names;
+                vector<shared_ptr<Contestant>> contestants;
+                int found{roster.empty() ? tree.prefix_search(name, limit, names, contestants)
+                                         : roster.prefix_search(name, limit, names, contestants)};
+                put(out, static_cast<uint16_t>(found));
+                for (const auto &found : names)
+                    put(out, found);
+            }
+            break;
+
+        case REGISTER: {
+                if (next == end){
+                    status = MALFORMED;
+                    break;
+                }
+                int type{*next++};
+                string row;
+                if (!get(next, end, row)){
+                    status = MALFORMED;
+                    break;
+                }
+                istringstream fields(row);
+                getline(fields, name, ',');
+                if (tree.find(name))
+                    status = EXISTS;
+                else if (!admit(type, name, fields))
+                    status = MALFORMED;
+            }
+            break;
+
+        case REMOVE:
+            if (!get(next, end, name))
+                status = MALFORMED;
+            else if (!tree.find(name))
+                status = MISSING;
+            else{
+                withdraw(name);
+                tree.remove(name);
+            }
+            break;
+
+        case STANDINGS: {
+                uint16_t k{};
+                if (!get(next, end, k)){
+                    status = MALFORMED;
+                    break;
+                }
+                vector<Standing> leaders;
+                vector<shared_ptr<Contestant>> contestants;
+                put(out, static_cast<uint16_t>(leaderboard.top(k, leaders, contestants)));
+                for (const auto &leader : leaders){
+                    put(out, leader.name);
+                    put(out, leader.finish);
+                }
+            }
+            break;
+
+        case CLOSE:
+            if (!tree.size())
+                status = MISSING;
+            else
+                roster = freeze(tree);
+            break;
+
+        default:
+            status = MALFORMED;
+            break;
+    }
+
+    //a failed request answers with its status alone
+    if (status != OK)
+        out.resize(start + sizeof(uint32_t) + 1);
+    out[start + sizeof(uint32_t)] = status;
+    finish(out, start);
+    ++served;
+}
@@ -0,0 +1,171 @@
+/*
+ *********************************************************************
+ * Ian Leuty
+ * inleuty@gmail.com
+ * 10/19/2026
+ *********************************************************************
+ * query server declaration
+ *********************************************************************
+ * Serves the registry to leaderboard screens and desk terminals over
+ * TCP or Unix sockets:
+ *
+ *      program3 -s <address> [-s <address>] [-j <journal>]
+ *
+ * An address with a '/' is a Unix socket path, host:port (or :port
+ * for every interface) is TCP.
+ *
+ * One epoll loop on one thread owns the tree, so requests need no
+ * locks. Clients may pipeline: any number of requests can be sent
+ * without waiting, responses come back in the order they were sent.
+ * Every request that has fully arrived when the loop wakes is run in
+ * one batch and each connection's responses go out in one send.
+ *
+ * A connection whose unsent responses pass OUT_LIMIT is not read from
+ * (nor are its waiting requests run) until they drain, so a client
+ * that sends without reading cannot grow the server's buffers.
+ *
+ * A client may shut down its side once it has sent its requests: the
+ * connection is closed after every one of them has been answered.
+ *
+ * With a journal open, the response to a register or remove (and every
+ * response after it on that connection, to keep them in order) is held
+ * until the journal has synced the change: an acknowledged write
+ * survives a crash. Each wake that held responses syncs once, for all
+ * of them, and a failed sync keeps them held until one succeeds.
+ *
+ * Frames are little endian, strings are <uint16 LENGTH><BYTES>:
+ *      request     <uint32 LENGTH><OP><PAYLOAD>
+ *      response    <uint32 LENGTH><STATUS><PAYLOAD>
+ * LENGTH counts everything after itself.
+ *
+ *      op              payload                     response payload
+ *      F find          <NAME>                      -
+ *      L lookup        <NAME>                      <DISPLAY><float PROJECTED>
+ *      R range         <LOW><HIGH><uint16 LIMIT>   <uint16 COUNT><NAME>...
+ *      P prefix        <PREFIX><uint16 LIMIT>      <uint16 COUNT><NAME>...
+ *      G register      <uint8 TYPE><ROSTER LINE>   -
+ *      D remove        <NAME>                      -
+ *      S standings     <uint16 K>                  <uint16 COUNT>(<NAME><float FINISH>)...
+ *      C close         -                           -
+ *
+ * range returns at most LIMIT names in [LOW, HIGH), prefix at most
+ * LIMIT names starting with PREFIX (for completing a name as a desk
+ * terminal types it). The roster line of register is the roster.in
+ * row without its type. PROJECTED and FINISH are minutes (negative if
+ * the contestant cannot be projected). close closes registration (see
+ * Menu::close_registration): find, lookup, range and prefix read the
+ * frozen roster until the next register or remove opens it again.
+ *********************************************************************
+ */
+
+#ifndef SERVER
+#define SERVER
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "application.h"
+
+//exceptions related to the server
+struct SERVER_ERROR
+{
+    struct listen_exception{
+        std::string msg{"\nFailed to listen on the address.\n"};
+    };
+};
+
+//request ops and response statuses
+namespace Protocol
+{
+    const char FIND{'F'};
+    const char LOOKUP{'L'};
+    const char RANGE{'R'};
+    const char PREFIX{'P'};
+    const char REGISTER{'G'};
+    const char REMOVE{'D'};
+    const char STANDINGS{'S'};
+    const char CLOSE{'C'};
+
+    const char OK{0};
+    const char MISSING{1};
+    const char EXISTS{2};
+    const char MALFORMED{3};
+
+    //largest frame either side accepts
+    const uint32_t MAX_FRAME{1 << 20};
+
+    //frame building and reading shared by the server and its clients
+    size_t begin(std::string &out, char code);
+    void finish(std::string &out, size_t start);
+    void put(std::string &out, const std::string &text);
+    void put(std::string &out, uint16_t number);
+    void put(std::string &out, float number);
+    bool get(const char *&next, const char *end, std::string &text);
+    bool get(const char *&next, const char *end, uint16_t &number);
+    bool get(const char *&next, const char *end, float &number);
+
+    //length of the whole frame at the front of 'bytes', 0 if it has not all arrived
+    //a frame longer than MAX_FRAME is reported as MAX_FRAME + 1
+    size_t framed(const char *bytes, size_t count);
+
+    //host:port or :port is TCP, anything else a Unix socket path
+    //returns a socket (listening or connected), -1 on failure
+    int listen(const std::string &address);
+    int connect(const std::string &address);
+}
+
+class Server : public Menu
+{
+    public:
+        Server();
+        ~Server();
+
+        //add a listening address, throws listen_exception
+        void listen(const std::string &address);
+
+        //run the event loop until stop is called
+        void serve();
+
+        //safe to call from a signal handler or another thread
+        void stop();
+
+        long requests() const;
+        int connections() const;
+
+    private:
+        struct Connection
+        {
+            std::string in;
+            std::string out;
+            size_t sent{};
+            std::string held;           //responses waiting for the journal
+            uint32_t watching{};        //epoll events asked for
+            bool closing{};             //the peer has shut down its side
+        };
+
+        //bytes read from a connection per wake, and unsent responses it may have
+        static const size_t IN_LIMIT{2 * Protocol::MAX_FRAME};
+        static const size_t OUT_LIMIT{4 * Protocol::MAX_FRAME};
+
+        int poller;
+        int waker;
+        std::vector<int> listeners;
+        Red_Black<int, Connection> clients;
+        std::vector<int> holding;       //connections with held responses
+        std::atomic<bool> running;
+        std::atomic<long> served;
+
+        void accept(int listener);
+        bool receive(int fd, Connection &client);
+        bool pump(int fd, Connection &client);
+        bool run(int fd, Connection &client);
+        bool transmit(int fd, Connection &client);
+        void watch(int fd, Connection &client);
+        void release();
+        void drop(int fd);
+        void handle(const char *request, size_t length, std::string &out);
+        static size_t backlog(const Connection &client);
+};
+
+#endif
@@ -0,0 +1,434 @@
+/*
+ *********************************************************************
+ * Ian Leuty
+ * inleuty@gmail.com
+ * 10/19/2026
+ *********************************************************************
+ * shared memory snapshot definition
+ *********************************************************************
+ */
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstring>
+#include <typeinfo>
+#include "snapshot.h"
+
+using std::string, std::string_view;
+
+static const char MAGIC[8]{'L', 'L', 'R', 'B', 'S', 'N', 'A', 'P'};
+static const uint32_t VERSION{1};
+
+//the header gets a cache line of its own, buffers follow it
+static const uint64_t HEADER_BYTES{(sizeof(Snapshot_Header) + 63) & ~uint64_t{63}};
+
+//bytes per buffer of a new segment, it grows to twice what a publish needs
+static const uint64_t FIRST_CAPACITY{1 << 20};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "the segment needs address free atomics");
+static_assert(sizeof(Snapshot_Entry) == 32, "Snapshot_Entry is part of the segment layout");
+
+//POSIX names start with a slash
+static string segment_name(const string &name)
+{
+    return name[0] == '/' ? name : "/" + name;
+}
+
+/*
+ *********************************************************************
+ * Snapshot_View
+ * data members are:
+ *      const Snapshot_Entry *entries;
+ *      const uint32_t *standings;
+ *      const char *names;
+ *      long count;
+ *      long ranked_count;
+ *      uint64_t name_bytes;
+ *      uint64_t published;
+ *********************************************************************
+ */
+
+//a buffer that is being overwritten can hold anything, so every
+//offset is checked against the buffer before it is used
+Snapshot_View::Snapshot_View(const Snapshot_Buffer &buffer, const char *base, uint64_t capacity, uint64_t number) :
+    entries(reinterpret_cast<const Snapshot_Entry*>(base)), standings(nullptr), names(base),
+    count(0), ranked_count(0), name_bytes(0), published(number)
+{
+    const uint64_t entry_count{buffer.count};
+    const uint64_t ranked{buffer.ranked};
+    if (entry_count > capacity / sizeof(Snapshot_Entry) || ranked > entry_count
+    || buffer.standings > capacity || ranked * sizeof(uint32_t) > capacity - buffer.standings
+    || buffer.names > capacity || buffer.name_bytes > capacity - buffer.names)
+        return;
+
+    count = entry_count;
+    ranked_count = ranked;
+    standings = reinterpret_cast<const uint32_t*>(base + buffer.standings);
+    names = base + buffer.names;
+    name_bytes = buffer.name_bytes;
+}
+
+//number of contestants
+long Snapshot_View::size() const
+{
+    return count;
+}
+
+//publish number, higher is newer
+uint64_t Snapshot_View::number() const
+{
+    return published;
+}
+
+//entries in name order
+const Snapshot_Entry* Snapshot_View::begin() const
+{
+    return entries;
+}
+
+const Snapshot_Entry* Snapshot_View::end() const
+{
+    return entries + count;
+}
+
+//binary search by name
+const Snapshot_Entry* Snapshot_View::find(string_view name) const
+{
+    const Snapshot_Entry *found{lower_bound(name)};
+    if (found == end() || this -> name(*found) != name)
+        return nullptr;
+    return found;
+}
+
+//first entry whose name is not less than 'name'
+const Snapshot_Entry* Snapshot_View::lower_bound(string_view name) const
+{
+    return std::lower_bound(begin(), end(), name, [this](const Snapshot_Entry &entry, string_view key){
+        return this -> name(entry) < key;
+    });
+}
+
+//number of contestants on the standings
+long Snapshot_View::ranked() const
+{
+    return ranked_count;
+}
+
+//contestant in 'place', 1 is the leader
+const Snapshot_Entry& Snapshot_View::standing(long place) const
+{
+    uint32_t index{standings[place - 1]};
+    return entries[index < count ? index : 0];
+}
+
+//the entry's name, empty if it points outside the buffer
+string_view Snapshot_View::name(const Snapshot_Entry &entry) const
+{
+    if (entry.name_offset > name_bytes || entry.name_length > name_bytes - entry.name_offset)
+        return string_view();
+    return string_view(names + entry.name_offset, entry.name_length);
+}
+
+/*
+ *********************************************************************
+ * Snapshot_Publisher
+ * data members are:
+ *      std::string name;
+ *      Snapshot_Header *header;
+ *      uint64_t mapped;
+ *      std::vector<std::pair<const Contestant*, uint32_t>> located;
+ *      std::vector<std::pair<const Contestant*, uint32_t>> placed;
+ *********************************************************************
+ */
+
+//constructor
+Snapshot_Publisher::Snapshot_Publisher() : header(nullptr), mapped(0) {}
+
+//destructor
+Snapshot_Publisher::~Snapshot_Publisher()
+{
+    close();
+}
+
+//create the segment, a segment left behind by another run is retired first
+//so its readers move to this one
+void Snapshot_Publisher::open(const string &name)
+{
+    close();
+    this -> name = segment_name(name);
+
+    int stale{shm_open(this -> name.c_str(), O_RDWR, 0)};
+    if (stale >= 0){
+        struct stat info{};
+        if (fstat(stale, &info) == 0 && static_cast<uint64_t>(info.st_size) >= HEADER_BYTES){
+            void *old{mmap(nullptr, HEADER_BYTES, PROT_READ | PROT_WRITE, MAP_SHARED, stale, 0)};
+            if (old != MAP_FAILED){
+                auto *old_header{static_cast<Snapshot_Header*>(old)};
+                if (memcmp(old_header -> magic, MAGIC, sizeof(MAGIC)) == 0)
+                    old_header -> retired.store(1, std::memory_order_release);
+                munmap(old, HEADER_BYTES);
+            }
+        }
+        ::close(stale);
+    }
+    create(FIRST_CAPACITY);
+}
+
+//retire and remove the segment, readers keep what they have mapped
+void Snapshot_Publisher::close()
+{
+    if (!header)
+        return;
+    header -> retired.store(1, std::memory_order_release);
+    munmap(header, mapped);
+    shm_unlink(name.c_str());
+    header = nullptr;
+    mapped = 0;
+}
+
+//true once open succeeded
+bool Snapshot_Publisher::is_open() const
+{
+    return header != nullptr;
+}
+
+//lay the registry out in the spare buffer, then make it the newest
+uint64_t Snapshot_Publisher::publish(const registry &tree, const Leaderboard &leaderboard)
+{
+    if (!header)
+        return 0;
+
+    const uint64_t count(tree.size());
+    const uint64_t ranked(leaderboard.size());
+    uint64_t name_bytes{};
+    tree.for_each([&name_bytes](const string &key, const std::shared_ptr<Contestant> &){
+        name_bytes += key.size();
+    });
+    const uint64_t standings_at{count * sizeof(Snapshot_Entry)};
+    const uint64_t names_at{standings_at + ranked * sizeof(uint32_t)};
+    const uint64_t needed{names_at + name_bytes};
+
+    //a bigger segment under the same name, the old one is retired once this one is published
+    Snapshot_Header *outgrown{nullptr};
+    uint64_t outgrown_size{};
+    if (needed > header -> capacity){
+        outgrown = header;
+        outgrown_size = mapped;
+        create(needed * 2);
+    }
+
+    const uint64_t published{header -> published.load(std::memory_order_relaxed)};
+    Snapshot_Buffer &buffer{header -> buffers[(published + 1) & 1]};
+    char *base{reinterpret_cast<char*>(header) + HEADER_BYTES + ((published + 1) & 1) * header -> capacity};
+
+    //odd while it is written
+    const uint64_t sequence{buffer.sequence.load(std::memory_order_relaxed)};
+    buffer.sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    auto *entries{reinterpret_cast<Snapshot_Entry*>(base)};
+    char *names{base + names_at};
+    uint64_t offset{};
+    located.clear();
+    located.reserve(count);
+    tree.for_each([&](const string &key, const std::shared_ptr<Contestant> &contestant){
+        const Contestant *held{contestant.get()};
+        Snapshot_Entry &entry{entries[located.size()]};
+        located.emplace_back(held, located.size());
+        entry.name_offset = offset;
+        entry.name_length = key.size();
+        memcpy(names + offset, key.data(), key.size());
+        offset += key.size();
+
+        //the exact type is a vtable compare, much cheaper than three dynamic casts
+        const std::type_info &type{typeid(*held)};
+        entry.type = 3;
+        entry.bib = 0;
+        if (type == typeid(Walking_Contestant))
+            entry.type = 1;
+        else if (type == typeid(Bicycle_Contestant))
+            entry.type = 2;
+        else if (type == typeid(Half_Marathon_Contestant))
+            entry.bib = static_cast<const Half_Marathon_Contestant*>(held) -> get_racer_number();
+        entry.status = held -> get_status();
+        entry.unused = 0;
+        entry.covered = held -> get_covered();
+        entry.elapsed = held -> get_elapsed();
+        entry.finish = -1;
+        entry.position = 0;
+    });
+
+    //the board holds the same contestants as the tree, so each place is
+    //matched to its entry by address: both lists sorted by address and merged
+    placed.clear();
+    placed.reserve(ranked);
+    leaderboard.for_each([this](const Standing &, const std::shared_ptr<Contestant> &contestant){
+        placed.emplace_back(contestant.get(), placed.size());
+    });
+    std::sort(located.begin(), located.end());
+    std::sort(placed.begin(), placed.end());
+
+    auto *standings{reinterpret_cast<uint32_t*>(base + standings_at)};
+    auto entry{located.begin()};
+    for (const auto &[held, place] : placed){
+        while (entry != located.end() && entry -> first < held)
+            ++entry;
+        const uint32_t index(entry != located.end() && entry -> first == held ? entry -> second : 0);
+        standings[place] = index;
+        entries[index].position = place + 1;
+    }
+    uint64_t place{};
+    leaderboard.for_each([&](const Standing &standing, const std::shared_ptr<Contestant> &){
+        entries[standings[place++]].finish = standing.finish;
+    });
+
+    buffer.count = count;
+    buffer.standings = standings_at;
+    buffer.ranked = ranked;
+    buffer.names = names_at;
+    buffer.name_bytes = name_bytes;
+
+    buffer.sequence.store(sequence + 2, std::memory_order_release);
+    header -> published.store(published + 1, std::memory_order_release);
+
+    if (outgrown){
+        outgrown -> retired.store(1, std::memory_order_release);
+        munmap(outgrown, outgrown_size);
+    }
+    return published + 1;
+}
+
+//header and both buffers
+uint64_t Snapshot_Publisher::segment_size() const
+{
+    return mapped;
+}
+
+//a new empty segment of two 'capacity' byte buffers under 'name'
+//the name is unlinked first, anyone still mapping the old segment keeps it
+void Snapshot_Publisher::create(uint64_t capacity)
+{
+    capacity = (capacity + 63) & ~uint64_t{63};
+    shm_unlink(name.c_str());
+    int fd{shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644)};
+    if (fd < 0)
+        throw SNAPSHOT_ERROR::segment_exception();
+
+    const uint64_t size{HEADER_BYTES + 2 * capacity};
+    void *memory{MAP_FAILED};
+    if (ftruncate(fd, size) == 0)
+        memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (memory == MAP_FAILED){
+        shm_unlink(name.c_str());
+        throw SNAPSHOT_ERROR::segment_exception();
+    }
+
+    //the segment starts zeroed, so the counters start at 0
+    header = static_cast<Snapshot_Header*>(memory);
+    mapped = size;
+    memcpy(header -> magic, MAGIC, sizeof(MAGIC));
+    header -> version = VERSION;
+    header -> capacity = capacity;
+}
+
+/*
+ *********************************************************************
+ * Snapshot_Reader
+ * data members are:
+ *      std::string name;
+ *      const Snapshot_Header *header;
+ *      uint64_t mapped;
+ *********************************************************************
+ */
+
+//constructor
+Snapshot_Reader::Snapshot_Reader() : header(nullptr), mapped(0) {}
+
+//destructor
+Snapshot_Reader::~Snapshot_Reader()
+{
+    close();
+}
+
+//map the segment
+bool Snapshot_Reader::open(const string &name)
+{
+    close();
+    this -> name = segment_name(name);
+    return map(this -> name);
+}
+
+//unmap the segment
+void Snapshot_Reader::close()
+{
+    if (!header)
+        return;
+    munmap(const_cast<Snapshot_Header*>(header), mapped);
+    header = nullptr;
+    mapped = 0;
+}
+
+//true while a segment is mapped
+bool Snapshot_Reader::is_open() const
+{
+    return header != nullptr;
+}
+
+//seqlock read of the newest buffer
+uint64_t Snapshot_Reader::read(const std::function<void(const Snapshot_View&)> &visit)
+{
+    if (!header)
+        return 0;
+
+    while (true){
+        //the publisher moved to a bigger segment (or went away, then the last one is kept)
+        if (header -> retired.load(std::memory_order_acquire))
+            map(name);
+
+        const uint64_t published{header -> published.load(std::memory_order_acquire)};
+        const Snapshot_Buffer &buffer{header -> buffers[published & 1]};
+        const uint64_t sequence{buffer.sequence.load(std::memory_order_acquire)};
+        if (sequence & 1)
+            continue;
+
+        const char *base{reinterpret_cast<const char*>(header) + HEADER_BYTES + (published & 1) * header -> capacity};
+        visit(Snapshot_View(buffer, base, header -> capacity, published));
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (buffer.sequence.load(std::memory_order_relaxed) == sequence)
+            return published;
+    }
+}
+
+//map '/name' read only in place of the current segment
+//the current one is kept if there is nothing valid to move to
+bool Snapshot_Reader::map(const string &name)
+{
+    int fd{shm_open(name.c_str(), O_RDONLY, 0)};
+    if (fd < 0)
+        return false;
+
+    struct stat info{};
+    void *memory{MAP_FAILED};
+    if (fstat(fd, &info) == 0 && static_cast<uint64_t>(info.st_size) >= HEADER_BYTES)
+        memory = mmap(nullptr, info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (memory == MAP_FAILED)
+        return false;
+
+    auto *mapping{static_cast<const Snapshot_Header*>(memory)};
+    if (memcmp(mapping -> magic, MAGIC, sizeof(MAGIC)) != 0 || mapping -> version != VERSION
+    || HEADER_BYTES + 2 * mapping -> capacity > static_cast<uint64_t>(info.st_size)){
+        munmap(memory, info.st_size);
+        return false;
+    }
+
+    close();
+    header = mapping;
+    mapped = info.st_size;
+    return true;
+}
@@ -0,0 +1,188 @@
+/*
+ *********************************************************************
+ * Ian Leuty
+ * inleuty@gmail.com
+ * 10/19/2026
+ *********************************************************************
+ * shared memory snapshot declaration
+ *********************************************************************
+ * The registry publishes a read only copy of itself to a POSIX shared
+ * memory segment so local scoreboards, displays and exporters can read
+ * the standings without asking the menu or copying anything.
+ *
+ * The segment holds a header and two buffers. Each buffer is the whole
+ * registry laid out with offsets instead of pointers, so it means the
+ * same thing wherever a process maps it:
+ *      <Snapshot_Entry x count, sorted by name>
+ *      <uint32 entry index x count, in standings order>
+ *      <names>
+ *
+ * A publish fills the buffer readers are not using and then points the
+ * header at it. Each buffer has a sequence number that is odd while it
+ * is being written; a reader notes it, reads, and checks it again, and
+ * only reruns if the publisher lapped it (two publishes during one
+ * read). Readers never take a lock or write to the segment.
+ *
+ * A registry that outgrows the segment is moved to a new, larger one
+ * under the same name and the old one is marked retired; readers
+ * notice and map the new one on their next read.
+ *********************************************************************
+ */
+
+#ifndef SNAPSHOT
+#define SNAPSHOT
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "structures.h"
+#include "core.h"
+#include "stats.h"
+#include "leaderboard.h"
+
+//exceptions related to the snapshot
+struct SNAPSHOT_ERROR
+{
+    struct segment_exception{
+        std::string msg{"\nFailed to create the shared memory snapshot.\n"};
+    };
+};
+
+//one contestant, names are offsets into the buffer's name bytes
+struct Snapshot_Entry
+{
+    uint32_t name_offset;
+    uint32_t name_length;
+    uint8_t type;           //1 walking, 2 cycling, 3 half marathon
+    Status status;
+    uint16_t unused;
+    int32_t bib;            //half marathon bib, 0 otherwise
+    float covered;
+    int32_t elapsed;
+    float finish;           //projected finish in minutes, negative if none
+    int32_t position;       //1 based place in the standings, 0 if not on them
+};
+
+//where a buffer's parts are, relative to the buffer
+struct Snapshot_Buffer
+{
+    std::atomic<uint64_t> sequence;
+    uint64_t count;
+    uint64_t standings;
+    uint64_t ranked;
+    uint64_t names;
+    uint64_t name_bytes;
+};
+
+//start of the segment
+struct Snapshot_Header
+{
+    char magic[8];
+    uint32_t version;
+    std::atomic<uint32_t> retired;
+    uint64_t capacity;                  //bytes in each buffer
+    std::atomic<uint64_t> published;    //publishes so far, the newest is in buffer published % 2
+    Snapshot_Buffer buffers[2];
+};
+
+//one published snapshot as a reader sees it, only valid inside Snapshot_Reader::read
+class Snapshot_View
+{
+    public:
+        Snapshot_View(const Snapshot_Buffer &buffer, const char *base, uint64_t capacity, uint64_t number);
+
+        long size() const;
+        uint64_t number() const;
+        const Snapshot_Entry* begin() const;
+        const Snapshot_Entry* end() const;
+
+        //binary search by name, nullptr if absent
+        const Snapshot_Entry* find(std::string_view name) const;
+        //first entry not before 'name', for range scans up to end()
+        const Snapshot_Entry* lower_bound(std::string_view name) const;
+
+        //standings, place 1 first
+        long ranked() const;
+        const Snapshot_Entry& standing(long place) const;
+
+        std::string_view name(const Snapshot_Entry &entry) const;
+
+    private:
+        const Snapshot_Entry *entries;
+        const uint32_t *standings;
+        const char *names;
+        long count;
+        long ranked_count;
+        uint64_t name_bytes;
+        uint64_t published;
+};
+
+//the registry's side, owns the segment
+class Snapshot_Publisher
+{
+    public:
+        typedef Red_Black<std::string, std::shared_ptr<Contestant>, Field_Stats> registry;
+
+        Snapshot_Publisher();
+        ~Snapshot_Publisher();
+        Snapshot_Publisher(const Snapshot_Publisher &source) = delete;
+        Snapshot_Publisher& operator=(const Snapshot_Publisher &source) = delete;
+
+        //create the segment '/name', replacing one left by an earlier run
+        //throws segment_exception
+        void open(const std::string &name);
+        void close();
+        bool is_open() const;
+
+        //write the registry and its standings to the spare buffer and make it current
+        //returns the publish number
+        uint64_t publish(const registry &tree, const Leaderboard &leaderboard);
+
+        //bytes mapped
+        uint64_t segment_size() const;
+
+    private:
+        std::string name;
+        Snapshot_Header *header;
+        uint64_t mapped;
+
+        //each contestant's entry and place, sorted by address, reused by every publish
+        std::vector<std::pair<const Contestant*, uint32_t>> located;
+        std::vector<std::pair<const Contestant*, uint32_t>> placed;
+
+        void create(uint64_t capacity);
+};
+
+//a consumer's side, maps the segment read only
+class Snapshot_Reader
+{
+    public:
+        Snapshot_Reader();
+        ~Snapshot_Reader();
+        Snapshot_Reader(const Snapshot_Reader &source) = delete;
+        Snapshot_Reader& operator=(const Snapshot_Reader &source) = delete;
+
+        //false if nothing is published under '/name'
+        bool open(const std::string &name);
+        void close();
+        bool is_open() const;
+
+        //call 'visit' with the newest complete snapshot and return its number
+        //'visit' is run again if the snapshot was overwritten while it ran,
+        //so it must start over cleanly (clear what it collects)
+        uint64_t read(const std::function<void(const Snapshot_View&)> &visit);
+
+    private:
+        std::string name;
+        const Snapshot_Header *header;
+        uint64_t mapped;
+
+        bool map(const std::string &name);
+};
+
+#endif
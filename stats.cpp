@@ -0,0 +1,58 @@
+/*
+ *********************************************************************
+ * Ian Leuty
+ * inleuty@gmail.com
+ * 10/19/2026
+ *********************************************************************
+ * field statistics definition
+ *********************************************************************
+ */
+
+#include <typeinfo>
+#include "stats.h"
+
+using std::string, std::shared_ptr;
+
+/*
+ *********************************************************************
+ * Field_Summary
+ *********************************************************************
+ */
+
+//mean km/h of those still in, 0 if there are none
+double Field_Summary::average_speed() const
+{
+    return contestants > disqualified ? speed / (contestants - disqualified) : 0;
+}
+
+/*
+ *********************************************************************
+ * Field_Stats
+ *********************************************************************
+ */
+
+//one contestant, speed is the rate their projection uses and a disqualified one has none
+//a node made by operator[] holds no contestant until it is assigned and updated
+Field_Summary Field_Stats::of(const string &, const shared_ptr<Contestant> &contestant)
+{
+    Field_Summary one{identity()};
+    if (!contestant)
+        return one;
+
+    one.contestants = 1;
+    one.racing = contestant -> is_racing();
+    one.finished = contestant -> is_status(Status::FINISHED);
+    one.disqualified = contestant -> is_status(Status::DISQUALIFIED);
+    if (one.disqualified)
+        return one;
+
+    float rate{}, span{};
+    contestant -> gather(rate, span);
+    one.speed = rate;
+    //exact type, no cast needed to tell a cyclist
+    if (typeid(*contestant) == typeid(Bicycle_Contestant)){
+        one.fastest_cyclist = rate;
+        one.fastest = contestant.get();
+    }
+    return one;
+}
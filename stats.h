@@ -0,0 +1,72 @@
+/*
+ *********************************************************************
+ * Ian Leuty
+ * inleuty@gmail.com
+ * 10/19/2026
+ *********************************************************************
+ * field statistics declaration
+ *********************************************************************
+ * The registry tree is augmented with Field_Stats (see the
+ * augmentations in structures.h): every subtree knows how many of its
+ * contestants are racing, finished or disqualified, their summed speed
+ * and its fastest cyclist. Any alphabetical block of the field adds up
+ * in O(log n) instead of a fetch_data and a pass over everyone:
+ *      tree.aggregate("A", "G")        everyone named A through F
+ *      tree.aggregate()                the whole field
+ *
+ * Contestants change in place, so whoever changes one re-reads it
+ * with tree.update(name) (Menu::refresh does).
+ *********************************************************************
+ */
+
+#ifndef STATS
+#define STATS
+
+#include <memory>
+#include <string>
+#include "structures.h"
+#include "core.h"
+
+//what a block of the field adds up to
+//every registry node holds one, so it is kept small (40 bytes)
+struct Field_Summary
+{
+    double speed;                   //summed km/h of those not disqualified
+    const Contestant *fastest;      //the fastest cyclist left in, nullptr if there is none
+    float fastest_cyclist;          //their km/h
+    int contestants;
+    int racing;
+    int finished;
+    int disqualified;
+
+    double average_speed() const;
+};
+
+//augmentation policy of the registry
+//identity and combine run at every node on every insert and removal path, so they are inline
+struct Field_Stats
+{
+    typedef Field_Summary value_type;
+
+    static value_type identity(){ return Field_Summary{0, nullptr, 0, 0, 0, 0, 0}; }
+    static value_type of(const std::string &name, const std::shared_ptr<Contestant> &contestant);
+    static value_type combine(const value_type &left, const value_type &right);
+};
+
+//add the counts and speeds, keep the faster cyclist (the earlier name on a tie)
+inline Field_Summary Field_Stats::combine(const Field_Summary &left, const Field_Summary &right)
+{
+    Field_Summary both{left};
+    both.speed += right.speed;
+    if (right.fastest && (!left.fastest || right.fastest_cyclist > left.fastest_cyclist)){
+        both.fastest = right.fastest;
+        both.fastest_cyclist = right.fastest_cyclist;
+    }
+    both.contestants += right.contestants;
+    both.racing += right.racing;
+    both.finished += right.finished;
+    both.disqualified += right.disqualified;
+    return both;
+}
+
+#endif
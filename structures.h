@@ -17,10 +17,18 @@
 #ifndef RB_TREE
 #define RB_TREE
 
+#include <algorithm>
 #include <sstream>
 #include <iostream>
+#include <fstream>
+#include <cstdint>
+#include <limits>
 #include <memory>
+#include <new>
+#include <optional>
+#include <utility>
 #include <vector>
+#include "footprint.h"
 
 //exceptions related to the red black tree
 struct TREE_ERROR
@@ -34,10 +42,90 @@ struct TREE_ERROR
         };
 };
 
-//red or black node
-enum class Color{RED, BLACK};
+//red or black node, one byte so an empty augmentation fits beside it in the node
+enum class Color : char{RED, BLACK};
 
-template<typename KEY, typename DATA>
+//structural events a tree reports to a Trace
+enum class Event : char{INSERT, REMOVE, ROTATE_LEFT, ROTATE_RIGHT, FLIP};
+
+template<typename KEY> class Trace;
+
+//start loading what a KEY keeps outside its node, nothing unless overloaded
+template<typename T>
+inline void prefetch_key(const T &) {}
+
+//a name longer than the small string buffer is another cache miss away
+inline void prefetch_key(const std::string &key)
+{
+    __builtin_prefetch(key.data());
+}
+
+/*
+ * augmentations: every node keeps AUG's value over its subtree, so the value
+ * over any range of keys is O(log n). AUG is a monoid over the entries:
+ *      value_type                  what is kept
+ *      identity()                  the value of no entries
+ *      of(key, data)               the value of one entry
+ *      combine(left, right)        left's entries are all before right's
+ * combine must be associative and identity must change nothing it is combined
+ * with (sum, min, max and counts all are). The subtree counts behind rank and
+ * select are Count_If<Every>, kept by every tree whatever AUG is.
+ */
+
+//nothing, the default
+struct No_Augment
+{
+    struct value_type{};
+    static value_type identity(){ return {}; }
+    template<typename K, typename D> static value_type of(const K &, const D &){ return {}; }
+    static value_type combine(const value_type &, const value_type &){ return {}; }
+};
+
+//predicate of Count_If that every entry passes
+struct Every
+{
+    template<typename K, typename D> bool operator()(const K &, const D &) const { return true; }
+};
+
+//entries for which PREDICATE(key, data) is true
+template<typename PREDICATE = Every>
+struct Count_If
+{
+    typedef long value_type;
+    static value_type identity(){ return 0; }
+    template<typename K, typename D> static value_type of(const K &key, const D &data){ return PREDICATE{}(key, data) ? 1 : 0; }
+    static value_type combine(const value_type &left, const value_type &right){ return left + right; }
+};
+
+//sum, smallest and largest of GET(key, data)
+template<typename T, typename GET>
+struct Sum
+{
+    typedef T value_type;
+    static value_type identity(){ return T{}; }
+    template<typename K, typename D> static value_type of(const K &key, const D &data){ return GET{}(key, data); }
+    static value_type combine(const value_type &left, const value_type &right){ return left + right; }
+};
+
+template<typename T, typename GET>
+struct Min
+{
+    typedef T value_type;
+    static value_type identity(){ return std::numeric_limits<T>::max(); }
+    template<typename K, typename D> static value_type of(const K &key, const D &data){ return GET{}(key, data); }
+    static value_type combine(const value_type &left, const value_type &right){ return std::min(left, right); }
+};
+
+template<typename T, typename GET>
+struct Max
+{
+    typedef T value_type;
+    static value_type identity(){ return std::numeric_limits<T>::lowest(); }
+    template<typename K, typename D> static value_type of(const K &key, const D &data){ return GET{}(key, data); }
+    static value_type combine(const value_type &left, const value_type &right){ return std::max(left, right); }
+};
+
+template<typename KEY, typename DATA, typename AUG = No_Augment>
 class Node
 {
     public:
@@ -45,14 +133,17 @@ class Node
         Node(KEY key_in, Color color_in);
 
         static bool is_red(const Node *node);
-        std::string to_string() const;
-        void to_string(std::stringstream &ss, const std::string &prefix, const std::string &child_prefix) const;
 
     private:
         KEY key;
         DATA data;
         Color color;
+        //in the block a tree was compacted into, so it is destroyed in place, never deleted
+        bool packed;
+        int count;
         std::unique_ptr<Node> left, right;
+        //after the 8 byte members so it packs, and No_Augment's takes no room at all
+        [[no_unique_address]] typename AUG::value_type summary;
 
    /*
     * tree is a friend
@@ -64,49 +155,246 @@ class Node
     * and the client application cannot touch the data in the container
     * without using the template methods of Red_Black
     */
-    template <typename K, typename D> friend class Red_Black;
+    template <typename K, typename D, typename A> friend class Red_Black;
+
+    //a trace reads and rebuilds the exact shape of a tree
+    template <typename K> friend class Trace;
+
+    friend struct std::default_delete<Node>;
 };
 
+//every unique_ptr to a node frees it through here: a node compact put in its tree's block is
+//only destroyed, the block is released by the tree once none of its nodes are left
+namespace std
+{
+    template<typename KEY, typename DATA, typename AUG>
+    struct default_delete<Node<KEY, DATA, AUG>>
+    {
+        void operator()(Node<KEY, DATA, AUG> *node) const
+        {
+            if (node -> packed)
+                node -> ~Node();
+            else
+                delete node;
+        }
+    };
+}
+
 //red black tree interface
-template<typename KEY, typename DATA>
+template<typename KEY, typename DATA, typename AUG = No_Augment>
 class Red_Black
 {
-    typedef Node<KEY, DATA> rb_node;
+    typedef Node<KEY, DATA, AUG> rb_node;
     typedef std::unique_ptr<rb_node> node_ptr;
 
     public:
+        //owning handle to a node taken out of a tree with extract
+        //the key and data can be changed and the node inserted again,
+        //in this tree or another, without reallocating it
+        class node_handle
+        {
+            public:
+                node_handle();
+                bool empty() const;
+                KEY& key();
+                DATA& data();
+
+            private:
+                explicit node_handle(node_ptr node_in);
+                node_ptr node;
+
+            friend class Red_Black;
+        };
+
+        //remembers a prefix search so the next one, for the same prefix with
+        //characters added (or some taken off), starts in the subtree that held
+        //the matches instead of at the root. Like an iterator, any change to
+        //the tree invalidates it; clear it (or make a new one) after a change
+        class prefix_cursor
+        {
+            public:
+                prefix_cursor();
+                void clear();
+                const KEY& prefix() const;
+                int matches() const;        //keys starting with prefix()
+                int first() const;          //rank of the first of them
+
+            private:
+                //the smallest subtree holding every match of the first 'length' characters
+                struct Step
+                {
+                    int length;
+                    const rb_node *top;
+                    int base;               //rank of the smallest key under 'top'
+                    int first;
+                    int matches;
+                };
+                KEY searched;
+                std::vector<Step> steps;
+
+            friend class Red_Black;
+        };
+
         Red_Black();
         Red_Black(const Red_Black &source);
-        Red_Black<KEY, DATA>& operator=(const Red_Black &source);
+        Red_Black(Red_Black &&source) noexcept;
+        Red_Black<KEY, DATA, AUG>& operator=(const Red_Black &source);
+        Red_Black<KEY, DATA, AUG>& operator=(Red_Black &&source) noexcept;
+        void swap(Red_Black &other) noexcept;
 
         //display methods
-        //'tree_string' is overloaded as <<
+        //'render' is overloaded as <<
         int display();
         std::string tree_string() const;
+        std::ostream& render(std::ostream &out, int depth = -1, bool ansi = true) const;
+        std::ostream& render(std::ostream &out, const KEY &key, int depth = -1, bool ansi = true) const;
 
         //template methods
         int size() const;
         bool insert(const KEY &key, const DATA &data);
         bool find(const KEY &key) const;
         DATA& operator[](const KEY &key);
+        DATA& retrieve(const KEY &key);
         int fetch_keys(std::vector<KEY> &keys) const;
         int fetch_data(std::vector<DATA> &data);
         int remove_all();
         bool remove(const KEY &key);
 
+        //non-throwing counterparts of retrieve and insert
+        //a miss is a nullptr / false / empty optional instead of an exception
+        DATA* find_ptr(const KEY &key);
+        const DATA* find_ptr(const KEY &key) const;
+        std::optional<DATA> lookup(const KEY &key) const;
+        std::pair<DATA*, bool> try_insert(const KEY &key, const DATA &data);
+
+        //a batch of lookups walked in lock step: each step prefetches the next node of
+        //every lookup in flight, so the batch waits on many cache misses at once instead
+        //of one after another. 'found' gets one pointer per key, nullptr on a miss,
+        //and the number found is returned. retrieve_many throws if any key is missing
+        int find_many(const std::vector<KEY> &keys, std::vector<DATA*> &found);
+        int find_many(const std::vector<KEY> &keys, std::vector<const DATA*> &found) const;
+        void retrieve_many(const std::vector<KEY> &keys, std::vector<DATA*> &found);
+
+        //insert near a known position, for sorted and nearly sorted input
+        //'hint' is where 'key' is expected (the number of keys less than it). the way
+        //down is found from the subtree counts, so a right hint compares two KEYs at
+        //most however big the tree is; a wrong one falls back to try_insert.
+        //'hint' is left where the next key of an ascending run is expected
+        std::pair<DATA*, bool> insert_hint(int &hint, const KEY &key, const DATA &data);
+        template<typename... ARGS> std::pair<DATA*, bool> emplace_hint(int &hint, const KEY &key, ARGS&&... args);
+
+        //insert past the largest key with one compare, false (and nothing inserted) if 'key' is not larger
+        bool append(const KEY &key, const DATA &data);
+
+        //move single entries between (or within) trees
+        node_handle extract(const KEY &key);
+        bool insert(node_handle &&handle);
+
+        //remove every entry pred(KEY, DATA) is true for (remove_if) or false for (retain)
+        //and return how many went. pred is called once per entry, in sorted order, before
+        //anything is removed. A few removals are done one at a time, O(k log n); once
+        //they would cost more, the rest of the nodes are relinked into a new balanced
+        //tree in one pass, O(n). A traced tree always removes one at a time
+        template<typename PREDICATE> int remove_if(PREDICATE &&pred);
+        template<typename PREDICATE> int retain(PREDICATE &&pred);
+
+        //order statistics, O(log n) using the subtree counts
+        //'rank' is the number of keys less than 'key'
+        //'select' is the DATA at a 0 based sorted position
+        int rank(const KEY &key) const;
+        DATA& select(int index);
+        int fetch_first(int k, std::vector<KEY> &keys, std::vector<DATA> &data) const;
+
+        //at most 'k' KEYs and DATA in [low, high) in sorted order, O(log n + k)
+        int fetch_range(const KEY &low, const KEY &high, int k, std::vector<KEY> &keys, std::vector<DATA> &data) const;
+
+        //at most 'k' KEYs and DATA that start with 'prefix', in sorted order, O(log n + k)
+        //for string-like KEYs. The cursor version narrows the previous search when
+        //'prefix' extends it, for completing a name as it is typed
+        int prefix_search(const KEY &prefix, int k, std::vector<KEY> &keys, std::vector<DATA> &data) const;
+        int prefix_search(prefix_cursor &cursor, const KEY &prefix, int k, std::vector<KEY> &keys, std::vector<DATA> &data) const;
+
+        //AUG's value over the entries with keys in [low, high), or over every entry, O(log n)
+        typename AUG::value_type aggregate(const KEY &low, const KEY &high) const;
+        typename AUG::value_type aggregate() const;
+
+        //re-read the entry at 'key' into AUG's values after its DATA was changed in place
+        //(through operator[], retrieve, find_ptr, ...), O(log n). false if 'key' is absent
+        bool update(const KEY &key);
+
+        //call visit(KEY, DATA) on every entry in sorted order, nothing is copied
+        template<typename VISIT> void for_each(VISIT &&visit) const;
+
+        //memory of the nodes, of what the KEYs own and of what the DATA own
+        void account(Memory &nodes, Memory &keys, Memory &data) const;
+
+        //report structural events to 'recorder' (nullptr to stop)
+        //the tree's current shape is the trace's starting point
+        void trace(Trace<KEY> *recorder);
+
+        //move every node into one block in van Emde Boas order, keeping the tree's shape:
+        //the top half of the levels comes first, then each subtree below them, each laid out
+        //the same way. A lookup then reads a run of nearby nodes at every level of that
+        //recursion instead of one node wherever the allocator had room, whatever the cache
+        //line or page size. O(n), nothing is copied (what a KEY or DATA points to stays where
+        //it is). Nodes inserted later are allocated on their own and removed ones leave a
+        //hole, so a tree that keeps changing is compacted again now and then
+        void compact();
+
     private:
+        //room for one node in the block
+        struct Slot
+        {
+            alignas(rb_node) unsigned char bytes[sizeof(rb_node)];
+        };
+
+        //the block from the last compact, released after the nodes in it (so declared first)
+        std::unique_ptr<Slot[]> block;
+        int slots{};
+
         node_ptr root;
+        Trace<KEY> *recorder;
+
+        //lookups find_many keeps in flight at once
+        static const int LANES{16};
+
+        //one removal costs about this many times what relinking a node in a rebuild does,
+        //per level of the tree it walks down
+        static const int REMOVAL_COST{1};
+
+        //how a hinted insert ended: the key belongs below or above the hinted position,
+        //it is the key just before or at the position, or it was added there
+        enum class Hinted{BELOW, ABOVE, PREVIOUS, PRESENT, INSERTED};
 
         //public method helpers
         void make_copy(const node_ptr &source, node_ptr &dest);
         int display(const rb_node *root);
-        int size(const rb_node *root) const;
-        node_ptr insert(node_ptr &root, const KEY &key, const DATA &data);
+        std::ostream& render(std::ostream &out, const rb_node *top, const char *label, int depth, bool ansi) const;
+        void render(std::ostream &out, const rb_node *node, std::string &indent, int depth, bool ansi) const;
+        static int size(const rb_node *root);
+        node_ptr insert(node_ptr &root, const KEY &key, const DATA &data, DATA *&placed, bool &inserted);
         DATA& insert(node_ptr &root, const KEY &key);
-        DATA& retrieve(const KEY &key);
+        node_ptr insert(node_ptr &root, node_ptr &node);
+        template<typename... ARGS>
+        node_ptr insert_at(node_ptr &root, int position, const KEY &key, rb_node *below, rb_node *above,
+                           DATA *&placed, Hinted &outcome, ARGS&&... args);
+        const rb_node* locate(const KEY &key) const;
+        int locate_many(const std::vector<KEY> &keys, std::vector<const rb_node*> &nodes) const;
         int fetch_keys(const rb_node *root, std::vector<KEY> &keys) const;
         int fetch_data(const rb_node *root, std::vector<DATA> &data);
-        node_ptr remove(node_ptr &root, const KEY &key);
+        int fetch_first(const rb_node *root, int k, std::vector<KEY> &keys, std::vector<DATA> &data) const;
+        void account(const rb_node *root, Memory &nodes, Memory &keys, Memory &data) const;
+        template<typename VISIT> void for_each(const rb_node *root, VISIT &visit) const;
+        int fetch_range(const rb_node *root, const KEY &low, const KEY &high, int k, std::vector<KEY> &keys, std::vector<DATA> &data) const;
+        int fetch_from(const rb_node *root, int skip, int k, std::vector<KEY> &keys, std::vector<DATA> &data) const;
+        void narrow(const KEY &prefix, const rb_node *top, int base, prefix_cursor &cursor) const;
+        node_ptr remove(node_ptr &root, const KEY &key, node_ptr &detached);
+        template<typename PREDICATE> void mark(const rb_node *root, PREDICATE &pred, std::vector<const rb_node*> &doomed);
+        void flatten(node_ptr &root, const std::vector<const rb_node*> &doomed, size_t &next, std::vector<node_ptr> &kept);
+        node_ptr build(std::vector<node_ptr> &nodes, int first, int count, int height, const std::vector<long> &most);
+        static int height(const rb_node *root);
+        static void layout(rb_node *root, int height, std::vector<rb_node*> &order, std::vector<rb_node*> &below);
+        static void descend(rb_node *root, int depth, std::vector<rb_node*> &below);
 
 
         //insert and removal helper functions
@@ -116,12 +404,58 @@ class Red_Black
         node_ptr red_right(node_ptr &node);
 
         void flip_colors(rb_node *source);
-        KEY& retrieve_ios_key(rb_node *root);
-        DATA& retrieve_ios_data(rb_node *root);
-        node_ptr remove_ios(node_ptr &root);
+        static void resize(rb_node *node);
+        static typename AUG::value_type summary(const rb_node *node);
+        bool update(rb_node *root, const KEY &key);
+        node_ptr remove_ios(node_ptr &root, node_ptr &smallest);
         node_ptr fixup(node_ptr &root);
 
-        bool is_red(const rb_node *node);
+        bool is_red(const rb_node *node) const;
+
+    template <typename K> friend class Trace;
+};
+
+//compact record of what a tree did
+//keys are stored once, each event is an event type and a key index
+//the shape of the tree when recording started is kept (preorder) so
+//a replay starts from exactly the same tree
+template<typename KEY>
+class Trace
+{
+    public:
+        Trace();
+
+        template<typename DATA, typename AUG> void start(const Red_Black<KEY, DATA, AUG> &tree);
+        template<typename DATA, typename AUG> void restore(Red_Black<KEY, DATA, AUG> &tree) const;
+        void record(Event event, const KEY &key);
+        void clear();
+
+        int size() const;
+        Event event(int index) const;
+        const KEY& key(int index) const;
+
+        //export and import for offline playback
+        bool save(const std::string &filename) const;
+        bool load(const std::string &filename);
+
+    private:
+        //one recorded event
+        struct Step{
+            Event event;
+            uint32_t key;
+        };
+
+        std::vector<KEY> keys;
+        Red_Black<KEY, uint32_t> interned;
+        std::vector<Step> steps;
+
+        //starting shape in preorder, flags are red / has left / has right
+        std::vector<uint32_t> shape_keys;
+        std::vector<unsigned char> shape_flags;
+
+        uint32_t intern(const KEY &key);
+        template<typename DATA, typename AUG> void start(const Node<KEY, DATA, AUG> *node);
+        template<typename DATA, typename AUG> std::unique_ptr<Node<KEY, DATA, AUG>> restore(size_t &index) const;
 };
 
 //helpers to avoid dereferencing a nullptr
@@ -139,12 +473,48 @@ void display_data(const std::shared_ptr<D> &data)
     std::cout << *data.get();
 }
 
+//helpers to write and read keys in binary, used by Trace
+//for fixed size (arithmetic) keys
+template<typename K>
+void write_key(std::ostream &out, const K &key)
+{
+    out.write(reinterpret_cast<const char*>(&key), sizeof(K));
+}
+template<typename K>
+void read_key(std::istream &in, K &key)
+{
+    in.read(reinterpret_cast<char*>(&key), sizeof(K));
+}
+//for string keys, length then characters
+inline void write_key(std::ostream &out, const std::string &key)
+{
+    uint32_t length{static_cast<uint32_t>(key.size())};
+    out.write(reinterpret_cast<const char*>(&length), sizeof(length));
+    out.write(key.data(), length);
+}
+//read a piece at a time, so a corrupt length fails at the end of the file
+//instead of allocating it
+inline void read_key(std::istream &in, std::string &key)
+{
+    uint32_t length{};
+    in.read(reinterpret_cast<char*>(&length), sizeof(length));
+    key.clear();
+    char piece[4096];
+    while (in && length){
+        const uint32_t wanted{std::min<uint32_t>(length, sizeof(piece))};
+        in.read(piece, wanted);
+        key.append(piece, in.gcount());
+        length -= wanted;
+    }
+}
+
 //overloaded ostream operator for the tree
 //prints graphical representation of the keys when called
-template<typename KEY, typename DATA>
-std::ostream &operator<<(std::ostream &out, const Red_Black<KEY, DATA> &rb_tree)
+template<typename KEY, typename DATA, typename AUG>
+std::ostream &operator<<(std::ostream &out, const Red_Black<KEY, DATA, AUG> &rb_tree)
 {
-    return out << "\nThe Tree:\n\n" << rb_tree.tree_string() << std::endl;
+    out << "\nThe Tree:\n\n";
+    return rb_tree.render(out) << std::endl;
 }
 
 #include "structures.tpp"
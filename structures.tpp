@@ -24,21 +24,21 @@ using std::unique_ptr, std::make_unique, std::string, std::vector,
 
 //node constructor, uses std::move to transfer in the key, data,
 //and initial color setting
-template<typename KEY, typename DATA>
-Node<KEY, DATA>::Node(KEY key_in, DATA data_in, Color color_in) :
-    key(move(key_in)), data(move(data_in)), color(move(color_in)) {}
+template<typename KEY, typename DATA, typename AUG>
+Node<KEY, DATA, AUG>::Node(KEY key_in, DATA data_in, Color color_in) :
+    key(move(key_in)), data(move(data_in)), color(move(color_in)), packed(false), count(1), summary(AUG::of(key, data)) {}
 
 //node empty data constructor, uses std::move to transfer in the key
 //and initial color setting
-template<typename KEY, typename DATA>
-Node<KEY, DATA>::Node(KEY key_in, Color color_in) :
-    key(move(key_in)), data{}, color(move(color_in)) {}
+template<typename KEY, typename DATA, typename AUG>
+Node<KEY, DATA, AUG>::Node(KEY key_in, Color color_in) :
+    key(move(key_in)), data{}, color(move(color_in)), packed(false), count(1), summary(AUG::of(key, data)) {}
 
 
 //used to check color of a node (argument)
 //null nodes are treated as black
-template<typename KEY, typename DATA>
-bool Node<KEY, DATA>::is_red(const Node<KEY, DATA> *node)
+template<typename KEY, typename DATA, typename AUG>
+bool Node<KEY, DATA, AUG>::is_red(const Node<KEY, DATA, AUG> *node)
 {
     if (node == nullptr)
         return false;
@@ -46,65 +46,6 @@ bool Node<KEY, DATA>::is_red(const Node<KEY, DATA> *node)
     return node -> color == Color::RED;
 }
 
-//return a string of this node and all it's children
-//uses overloaded recursive method
-template<typename KEY, typename DATA>
-string Node<KEY, DATA>::to_string() const
-{
-    stringstream new_stream{};
-    to_string(new_stream, "", "");
-    string graphical = new_stream.str();
-    graphical.insert(0, "\033[38;5;244m║\033[0;0m");
-    graphical.insert(0, 1, '\n');
-    graphical.insert(0, "\033[38;5;244m│\033[0;0m");
-    graphical.insert(0, 1, '\n');
-    graphical.insert(0, "\033[38;5;244m┌─\033[0;0m<root>");
-    graphical.insert(0, 1, '\n');
-    return graphical;
-}
-
-
-//recursive method to build string of a node and its children
-template<typename KEY, typename DATA>
-void Node<KEY, DATA>::to_string(std::stringstream &ss,
-        const std::string &prefix, const std::string &child_prefix) const
-{
-    //append current prefix to the stringstream
-    ss << prefix << key << "\n";
-
-    //colored red and black "nodes"
-    string RED = "\033[38;5;160m──╢\033[0;0m";
-    string BLK = "\033[38;5;244m──╢\033[0;0m";
-
-    //if there is a right node (not nullptr)
-    if (right){
-
-        //create a new prefix starting with current frame's child prefix
-        //for the right appending the correct color
-        string new_prefix = child_prefix + "│\n" + child_prefix + "├─<R>" + (is_red(right.get()) ? RED : BLK);
-        //also update the indentation on the new child prefix
-        string new_child_prefix = child_prefix + "│      ";
-
-        //if there is no left subtree, indent but don't create a new branch
-        if (!left){
-            new_prefix = child_prefix + "│\n" + child_prefix + "├─<R>" + (is_red(right.get()) ? RED : BLK);
-            new_child_prefix = child_prefix + "      ";
-        }
-        //recurse right with new strings built as above
-        right -> to_string(ss, new_prefix, new_child_prefix);
-    }
-
-    //if there is a left node
-    if (left)
-        //recurse left appending a left branch to the child prefix
-        //use argument list to set that as current prefix for next frame
-        //along with the appropriate red/black indicator
-        //also pass new child prefix with correct intentation
-        left -> to_string(ss,
-        child_prefix + "│\n" + child_prefix + "└─<L>" + (is_red(left.get()) ? RED : BLK),
-        child_prefix + "       ");
-}
-
 /*
  *********************************************************************
  * tree template
@@ -112,43 +53,79 @@ void Node<KEY, DATA>::to_string(std::stringstream &ss,
  */
 
 //default constructor
-template<typename KEY, typename DATA>
-Red_Black<KEY, DATA>::Red_Black() : root(nullptr) {}
+template<typename KEY, typename DATA, typename AUG>
+Red_Black<KEY, DATA, AUG>::Red_Black() : root(nullptr), recorder(nullptr) {}
 
 //copy constructor
-template<typename KEY, typename DATA>
-Red_Black<KEY, DATA>::Red_Black(const Red_Black &source) : root(nullptr)
+template<typename KEY, typename DATA, typename AUG>
+Red_Black<KEY, DATA, AUG>::Red_Black(const Red_Black &source) : root(nullptr), recorder(nullptr)
+{
+    make_copy(source.root, root);
+}
+
+//move constructor, takes the source's nodes without reallocating any
+template<typename KEY, typename DATA, typename AUG>
+Red_Black<KEY, DATA, AUG>::Red_Black(Red_Black &&source) noexcept :
+    block(move(source.block)), slots(source.slots), root(move(source.root)), recorder(nullptr)
 {
-    copy(source.root, root);
+    source.slots = 0;
 }
 
 //overloaded assignment operator
-template<typename KEY, typename DATA>
-Red_Black<KEY, DATA>& Red_Black<KEY, DATA>::
-operator=(const Red_Black<KEY, DATA> &source)
+template<typename KEY, typename DATA, typename AUG>
+Red_Black<KEY, DATA, AUG>& Red_Black<KEY, DATA, AUG>::
+operator=(const Red_Black<KEY, DATA, AUG> &source)
 {
     if (this == &source)
         return *this;
     root.reset();
+    block.reset();
+    slots = 0;
     make_copy(source.root, root);
     return *this;
 }
 
+//move assignment operator
+template<typename KEY, typename DATA, typename AUG>
+Red_Black<KEY, DATA, AUG>& Red_Black<KEY, DATA, AUG>::
+operator=(Red_Black<KEY, DATA, AUG> &&source) noexcept
+{
+    if (this == &source)
+        return *this;
+    //this tree's nodes go before the block they may be in
+    root = move(source.root);
+    block = move(source.block);
+    slots = source.slots;
+    source.slots = 0;
+    return *this;
+}
+
+//exchange the contents of two trees, only the roots (and blocks) change hands
+template<typename KEY, typename DATA, typename AUG>
+void Red_Black<KEY, DATA, AUG>::swap(Red_Black<KEY, DATA, AUG> &other) noexcept
+{
+    root.swap(other.root);
+    block.swap(other.block);
+    std::swap(slots, other.slots);
+}
+
 //copy function used by assignment operator and copy constructor
-template<typename KEY, typename DATA>
-void Red_Black<KEY, DATA>::make_copy(const unique_ptr<Node<KEY, DATA>> &source, unique_ptr<Node<KEY, DATA>> &dest)
+template<typename KEY, typename DATA, typename AUG>
+void Red_Black<KEY, DATA, AUG>::make_copy(const unique_ptr<Node<KEY, DATA, AUG>> &source, unique_ptr<Node<KEY, DATA, AUG>> &dest)
 {
     if (!source)
         return;
-    dest = make_unique<Node<KEY, DATA>>(source -> key, source -> data, source -> color);
+    dest = make_unique<Node<KEY, DATA, AUG>>(source -> key, source -> data, source -> color);
+    dest -> count = source -> count;
+    dest -> summary = source -> summary;
     make_copy(source -> left, dest -> left);
     make_copy(source -> right, dest -> right);
 }
 
 //display wrapper - display the contents of the tree
 //overload << for use with class objects
-template<typename KEY, typename DATA>
-int Red_Black<KEY, DATA>::display()
+template<typename KEY, typename DATA, typename AUG>
+int Red_Black<KEY, DATA, AUG>::display()
 {
     if (!root)
         return 0;
@@ -159,8 +136,8 @@ int Red_Black<KEY, DATA>::display()
 //calls overloaded display_data template function
 //to avoid using << without * when DATA is a shared_ptr
 //add other templates if other pointer types will be used
-template<typename KEY, typename DATA>
-int Red_Black<KEY, DATA>::display(const Node<KEY, DATA> *root)
+template<typename KEY, typename DATA, typename AUG>
+int Red_Black<KEY, DATA, AUG>::display(const Node<KEY, DATA, AUG> *root)
 {
     if (!root)
         return 0;
@@ -172,80 +149,269 @@ int Red_Black<KEY, DATA>::display(const Node<KEY, DATA> *root)
 }
 
 
-//recursively build a string representing the current tree
-//using recursion at the node level
+//build a string representing the current tree
 //only displays the keys
-template<typename KEY, typename DATA>
-string Red_Black<KEY, DATA>::tree_string() const
+template<typename KEY, typename DATA, typename AUG>
+string Red_Black<KEY, DATA, AUG>::tree_string() const
 {
-    if (root)
-        return root -> to_string();
-    return "";
+    stringstream new_stream{};
+    render(new_stream);
+    return new_stream.str();
+}
+
+//stream a graphical representation of the tree straight to 'out'
+//'depth' limits the levels shown below the top (-1 for all)
+//'ansi' false renders without color escapes, red/black shown as R/B
+template<typename KEY, typename DATA, typename AUG>
+std::ostream& Red_Black<KEY, DATA, AUG>::render(std::ostream &out, int depth, bool ansi) const
+{
+    if (!root)
+        return out;
+    return render(out, root.get(), "<root>", depth, ansi);
+}
+
+//render only the subtree around 'key'
+//if the key is not present, the subtree where the search ended
+template<typename KEY, typename DATA, typename AUG>
+std::ostream& Red_Black<KEY, DATA, AUG>::render(std::ostream &out, const KEY &key, int depth, bool ansi) const
+{
+    const Node<KEY, DATA, AUG> *node = root.get(), *around = root.get();
+    while (node){
+        around = node;
+        if (key < node -> key)
+            node = node -> left.get();
+        else if (key > node -> key)
+            node = node -> right.get();
+        else
+            break;
+    }
+    if (!around)
+        return out;
+    return render(out, around, "<subtree>", depth, ansi);
+}
+
+//draw the top of the tree, then the nodes below it
+//one indentation buffer is grown and shrunk in place for the whole walk
+template<typename KEY, typename DATA, typename AUG>
+std::ostream& Red_Black<KEY, DATA, AUG>::
+render(std::ostream &out, const Node<KEY, DATA, AUG> *top, const char *label, int depth, bool ansi) const
+{
+    const char *gray{ansi ? "\033[38;5;244m" : ""};
+    const char *reset{ansi ? "\033[0;0m" : ""};
+    out << '\n' << gray << "┌─" << reset << label
+        << '\n' << gray << "│" << reset
+        << '\n' << gray << "║" << reset;
+
+    string indent{};
+    render(out, top, indent, depth, ansi);
+    return out;
+}
+
+//recursive render of a node and its children, right above left
+//'indent' is the prefix for this node's children
+template<typename KEY, typename DATA, typename AUG>
+void Red_Black<KEY, DATA, AUG>::
+render(std::ostream &out, const Node<KEY, DATA, AUG> *node, string &indent, int depth, bool ansi) const
+{
+    out << node -> key;
+
+    //out of levels, show how many nodes are hidden below
+    if (depth == 0 && (node -> left || node -> right)){
+        out << " (+" << node -> count - 1 << ")\n";
+        return;
+    }
+    out << '\n';
+
+    //colored red and black "nodes"
+    const char *RED{ansi ? "\033[38;5;160m──╢\033[0;0m" : "─R╢"};
+    const char *BLK{ansi ? "\033[38;5;244m──╢\033[0;0m" : "─B╢"};
+    const size_t mark{indent.size()};
+
+    if (node -> right){
+        out << indent << "│\n" << indent << "├─<R>" << (is_red(node -> right.get()) ? RED : BLK);
+        //if there is no left subtree, indent but don't continue the branch
+        indent += node -> left ? "│      " : "      ";
+        render(out, node -> right.get(), indent, depth - 1, ansi);
+        indent.resize(mark);
+    }
+
+    if (node -> left){
+        out << indent << "│\n" << indent << "└─<L>" << (is_red(node -> left.get()) ? RED : BLK);
+        indent += "       ";
+        render(out, node -> left.get(), indent, depth - 1, ansi);
+        indent.resize(mark);
+    }
 }
 
 //size wrapper
-template<typename KEY, typename DATA>
-int Red_Black<KEY, DATA>::size() const
+template<typename KEY, typename DATA, typename AUG>
+int Red_Black<KEY, DATA, AUG>::size() const
 {
     return size(root.get());
 }
 
-//size recursive, count the number if items in the tree
-template<typename KEY, typename DATA>
-int Red_Black<KEY, DATA>::size(const Node<KEY, DATA> *root) const
+//size of the subtree at root
+//every node keeps a count of itself and its descendants
+template<typename KEY, typename DATA, typename AUG>
+int Red_Black<KEY, DATA, AUG>::size(const Node<KEY, DATA, AUG> *root)
 {
     if (!root)
         return 0;
-    int counted{size(root -> left.get())};
-    ++counted;
-    counted += size(root -> right.get());
-    return counted;
+    return root -> count;
 }
 
 //insert wrapper
-template<typename KEY, typename DATA>
-bool Red_Black<KEY, DATA>::insert(const KEY &key, const DATA &data)
+//throwing version of try_insert
+template<typename KEY, typename DATA, typename AUG>
+bool Red_Black<KEY, DATA, AUG>::insert(const KEY &key, const DATA &data)
 {
-    //check if the key is already present
-    if (find(key))
+    if (!try_insert(key, data).second)
         throw TREE_ERROR::duplicate_name_exception();
+    return true;
+}
+
+//insert 'data' at 'key' unless the key is already present
+//returns the DATA at key and whether it was inserted, in a single descent
+template<typename KEY, typename DATA, typename AUG>
+std::pair<DATA*, bool> Red_Black<KEY, DATA, AUG>::try_insert(const KEY &key, const DATA &data)
+{
+    DATA *placed{};
+    bool inserted{false};
 
     //make the recursive call and assign the return to this -> root
-    root = insert(root, key, data);
+    root = insert(root, key, data, placed, inserted);
 
     //always make sure root is black
     if (root)
         root -> color = Color::BLACK;
 
-    return true;
+    return {placed, inserted};
+}
+
+//hinted insert wrapper, see emplace_hint
+template<typename KEY, typename DATA, typename AUG>
+std::pair<DATA*, bool> Red_Black<KEY, DATA, AUG>::insert_hint(int &hint, const KEY &key, const DATA &data)
+{
+    return emplace_hint(hint, key, data);
+}
+
+//insert at sorted position 'hint' if that is where 'key' goes, building the DATA
+//from 'args' only if it is added. a wrong hint falls back to a normal insert
+template<typename KEY, typename DATA, typename AUG>
+template<typename... ARGS>
+std::pair<DATA*, bool> Red_Black<KEY, DATA, AUG>::emplace_hint(int &hint, const KEY &key, ARGS&&... args)
+{
+    hint = std::clamp(hint, 0, size(root.get()));
+
+    DATA *placed{};
+    Hinted outcome{};
+    root = insert_at(root, hint, key, nullptr, nullptr, placed, outcome, std::forward<ARGS>(args)...);
+    if (root)
+        root -> color = Color::BLACK;
+
+    switch (outcome){
+        case Hinted::INSERTED:
+            ++hint;
+            return {placed, true};
+        case Hinted::PRESENT:
+            ++hint;
+            return {placed, false};
+        case Hinted::PREVIOUS:
+            return {placed, false};
+        default:
+            break;
+    }
+
+    //the key belongs elsewhere, the run it broke is still expected at 'hint'
+    //(one further on if the key went in below it)
+    auto result{try_insert(key, DATA(std::forward<ARGS>(args)...))};
+    if (outcome == Hinted::BELOW && result.second)
+        ++hint;
+    return result;
+}
+
+//the append fast path, a hint past the end compares 'key' with the largest key only
+template<typename KEY, typename DATA, typename AUG>
+bool Red_Black<KEY, DATA, AUG>::append(const KEY &key, const DATA &data)
+{
+    const rb_node *largest{root.get()};
+    while (largest && largest -> right)
+        largest = largest -> right.get();
+    if (largest && !(largest -> key < key))
+        return false;
+
+    int hint{size(root.get())};
+    return insert_hint(hint, key, data).second;
+}
+
+//hinted insert recursive
+//the path to sorted 'position' is found from the subtree counts alone; 'below' and 'above'
+//follow the nearest keys either side of it and are compared with 'key' once at the bottom.
+//if 'key' does not go there nothing changes, fixup leaves an untouched subtree as it was
+template<typename KEY, typename DATA, typename AUG>
+template<typename... ARGS>
+unique_ptr<Node<KEY, DATA, AUG>> Red_Black<KEY, DATA, AUG>::
+insert_at(unique_ptr<Node<KEY, DATA, AUG>> &root, int position, const KEY &key, Node<KEY, DATA, AUG> *below,
+          Node<KEY, DATA, AUG> *above, DATA *&placed, Hinted &outcome, ARGS&&... args)
+{
+    if (!root){
+        if (below && !(below -> key < key)){
+            outcome = key < below -> key ? Hinted::BELOW : Hinted::PREVIOUS;
+            placed = &below -> data;
+            return nullptr;
+        }
+        if (above && !(key < above -> key)){
+            outcome = above -> key < key ? Hinted::ABOVE : Hinted::PRESENT;
+            placed = &above -> data;
+            return nullptr;
+        }
+
+        auto node{make_unique<Node<KEY, DATA, AUG>>(key, DATA(std::forward<ARGS>(args)...), Color::RED)};
+        placed = &node -> data;
+        outcome = Hinted::INSERTED;
+        if (recorder)
+            recorder -> record(Event::INSERT, key);
+        return node;
+    }
+
+    const int left{size(root -> left.get())};
+    if (position <= left)
+        root -> left = insert_at(root -> left, position, key, below, root.get(), placed, outcome, std::forward<ARGS>(args)...);
+    else
+        root -> right = insert_at(root -> right, position - left - 1, key, root.get(), above, placed, outcome,
+                                  std::forward<ARGS>(args)...);
+
+    return fixup(root);
 }
 
 //insert recursive
-template<typename KEY, typename DATA>
-unique_ptr<Node<KEY, DATA>> Red_Black<KEY, DATA>::
-insert(unique_ptr<Node<KEY, DATA>> &root, const KEY &key, const DATA &data)
+//'placed' is set to the DATA at key, 'inserted' to whether the node is new
+template<typename KEY, typename DATA, typename AUG>
+unique_ptr<Node<KEY, DATA, AUG>> Red_Black<KEY, DATA, AUG>::
+insert(unique_ptr<Node<KEY, DATA, AUG>> &root, const KEY &key, const DATA &data, DATA *&placed, bool &inserted)
 {
     //reached the insert point, make a new node colored red and return it
-    if (!root)
-        return make_unique<Node<KEY, DATA>>(key, data, Color::RED);
-
-    //if root's left and right are red
-    if (is_red(root -> left.get()) && is_red(root -> right.get()))
-        //make root red and it's left and right black
-        flip_colors(root.get());
+    if (!root){
+        auto node{make_unique<Node<KEY, DATA, AUG>>(key, data, Color::RED)};
+        placed = &node -> data;
+        inserted = true;
+        if (recorder)
+            recorder -> record(Event::INSERT, key);
+        return node;
+    }
 
     //standard BST insertion procedude, head recursionn
     //go left if less, assign return to root -> right
     if (key < root -> key)
-        root -> left = insert(root -> left, key, data);
+        root -> left = insert(root -> left, key, data, placed, inserted);
 
     //right if greater, assign return to root -> left
     else if (key > root -> key)
-        root -> right = insert(root -> right, key, data);
+        root -> right = insert(root -> right, key, data, placed, inserted);
 
-    //insert here if equal by putting the data here at root
+    //already here, leave the existing data alone
     else
-        root -> data = data;
+        placed = &root -> data;
 
     //if root's right is red and its left is black, rotate left
     //left-leaning property - if a node has just one red child, it must be the left
@@ -256,6 +422,14 @@ insert(unique_ptr<Node<KEY, DATA>> &root, const KEY &key, const DATA &data)
     if (is_red(root -> left.get()) && is_red(root -> left -> left.get()))
         root = rotate_right(root);
 
+    //if root's left and right are red, make root red and it's left and right black
+    //splitting on the way back up (not down) keeps this a 2-3 tree, which is what removal expects
+    if (is_red(root -> left.get()) && is_red(root -> right.get()))
+        flip_colors(root.get());
+
+    //recount after the new node was added below
+    resize(root.get());
+
     //return root to the previous call
     return move(root);
 }
@@ -265,20 +439,16 @@ insert(unique_ptr<Node<KEY, DATA>> &root, const KEY &key, const DATA &data)
 //in order to hace a return type of DATA
 //used by overloaded[] to insert a "blank" node at key and allow client to modify it's DATA via reference.
 //allows for: tree[KEY] = DATA; style insertion like std::map
-template<typename KEY, typename DATA>
-DATA& Red_Black<KEY, DATA>::
-insert(unique_ptr<Node<KEY, DATA>> &root, const KEY &key)
+template<typename KEY, typename DATA, typename AUG>
+DATA& Red_Black<KEY, DATA, AUG>::
+insert(unique_ptr<Node<KEY, DATA, AUG>> &root, const KEY &key)
 {
     if (!root){
-        root = make_unique<Node<KEY, DATA>>(key, Color::RED);
+        root = make_unique<Node<KEY, DATA, AUG>>(key, Color::RED);
+        if (recorder)
+            recorder -> record(Event::INSERT, key);
         return root -> data;
     }
-    //if root's left and right are red
-
-    if (is_red(root -> left.get()) && is_red(root -> right.get()))
-        //make root red and it's left and right black
-        flip_colors(root.get());
-
     //hold on to the data from the next recursive call
     DATA *temp{};
 
@@ -304,16 +474,22 @@ insert(unique_ptr<Node<KEY, DATA>> &root, const KEY &key)
     if (is_red(root -> left.get()) && is_red(root -> left -> left.get()))
         root = rotate_right(root);
 
+    //split on the way up, same as the other insert
+    if (is_red(root -> left.get()) && is_red(root -> right.get()))
+        flip_colors(root.get());
+
+    resize(root.get());
+
     //return the newly inserted reference
     return *temp;
 }
 
-//return the the data associated with a specific key
-//returns "false" if key is not found
-template<typename KEY, typename DATA>
-bool Red_Black<KEY, DATA>::find(const KEY &key) const
+//the node holding 'key', nullptr if the key is not present
+//every lookup below is built on this one descent
+template<typename KEY, typename DATA, typename AUG>
+const Node<KEY, DATA, AUG>* Red_Black<KEY, DATA, AUG>::locate(const KEY &key) const
 {
-    const Node<KEY, DATA> *node = root.get();
+    const Node<KEY, DATA, AUG> *node = root.get();
     while (node){
         if (key < node -> key)
             node = node -> left.get();
@@ -321,54 +497,549 @@ bool Red_Black<KEY, DATA>::find(const KEY &key) const
             node = node -> right.get();
         else
             //found the data matching key
-            return true;
+            return node;
+    }
+    return nullptr;
+}
+
+//locate every key, LANES of them at a time
+//each round first asks for the key bytes of the nodes the lanes reached (asked for
+//the round before), then compares, steps every lane down a level and asks for the
+//new nodes. a lane that finishes takes the next key, so the lanes stay full
+template<typename KEY, typename DATA, typename AUG>
+int Red_Black<KEY, DATA, AUG>::locate_many(const vector<KEY> &keys, vector<const Node<KEY, DATA, AUG>*> &nodes) const
+{
+    nodes.assign(keys.size(), nullptr);
+    if (!root)
+        return 0;
+
+    struct Lane
+    {
+        const Node<KEY, DATA, AUG> *node;
+        size_t key;
+    };
+    Lane lanes[LANES];
+    int active{};
+    size_t next{};
+    while (active < LANES && next < keys.size())
+        lanes[active++] = Lane{root.get(), next++};
+
+    int found{};
+    while (active){
+        for (int i{}; i < active; ++i)
+            prefetch_key(lanes[i].node -> key);
+
+        for (int i{}; i < active;){
+            Lane &lane{lanes[i]};
+            const KEY &key{keys[lane.key]};
+            const Node<KEY, DATA, AUG> *node{lane.node};
+            const Node<KEY, DATA, AUG> *below{nullptr};
+            if (key < node -> key)
+                below = node -> left.get();
+            else if (key > node -> key)
+                below = node -> right.get();
+            else{
+                nodes[lane.key] = node;
+                ++found;
+            }
+
+            //a node can straddle two cache lines, ask for both
+            if (below){
+                lane.node = below;
+                __builtin_prefetch(below);
+                __builtin_prefetch(reinterpret_cast<const char*>(below) + sizeof(*below) - 1);
+                ++i;
+            }
+            else if (next < keys.size()){
+                lane = Lane{root.get(), next++};
+                ++i;
+            }
+            else
+                lane = lanes[--active];
+        }
     }
-    return false;
+    return found;
+}
+
+//return true if the key is present
+//returns "false" if key is not found
+template<typename KEY, typename DATA, typename AUG>
+bool Red_Black<KEY, DATA, AUG>::find(const KEY &key) const
+{
+    return locate(key) != nullptr;
+}
+
+//pointer to the DATA at key, nullptr on a miss
+template<typename KEY, typename DATA, typename AUG>
+DATA* Red_Black<KEY, DATA, AUG>::find_ptr(const KEY &key)
+{
+    const Node<KEY, DATA, AUG> *node = locate(key);
+    return node ? &const_cast<Node<KEY, DATA, AUG>*>(node) -> data : nullptr;
+}
+
+//const pointer to the DATA at key, nullptr on a miss
+template<typename KEY, typename DATA, typename AUG>
+const DATA* Red_Black<KEY, DATA, AUG>::find_ptr(const KEY &key) const
+{
+    const Node<KEY, DATA, AUG> *node = locate(key);
+    return node ? &node -> data : nullptr;
 }
 
+//copy of the DATA at key, empty on a miss
+template<typename KEY, typename DATA, typename AUG>
+std::optional<DATA> Red_Black<KEY, DATA, AUG>::lookup(const KEY &key) const
+{
+    if (const DATA *data = find_ptr(key))
+        return *data;
+    return std::nullopt;
+}
+
+//pointers to the DATA at each key, nullptr on a miss
+template<typename KEY, typename DATA, typename AUG>
+int Red_Black<KEY, DATA, AUG>::find_many(const vector<KEY> &keys, vector<DATA*> &found)
+{
+    vector<const Node<KEY, DATA, AUG>*> nodes;
+    int hits{locate_many(keys, nodes)};
+    found.resize(nodes.size());
+    for (size_t i{}; i < nodes.size(); ++i)
+        found[i] = nodes[i] ? &const_cast<Node<KEY, DATA, AUG>*>(nodes[i]) -> data : nullptr;
+    return hits;
+}
+
+//const pointers to the DATA at each key, nullptr on a miss
+template<typename KEY, typename DATA, typename AUG>
+int Red_Black<KEY, DATA, AUG>::find_many(const vector<KEY> &keys, vector<const DATA*> &found) const
+{
+    vector<const Node<KEY, DATA, AUG>*> nodes;
+    int hits{locate_many(keys, nodes)};
+    found.resize(nodes.size());
+    for (size_t i{}; i < nodes.size(); ++i)
+        found[i] = nodes[i] ? &nodes[i] -> data : nullptr;
+    return hits;
+}
+
+//throwing version of find_many
+template<typename KEY, typename DATA, typename AUG>
+void Red_Black<KEY, DATA, AUG>::retrieve_many(const vector<KEY> &keys, vector<DATA*> &found)
+{
+    if (find_many(keys, found) != static_cast<int>(keys.size()))
+        throw TREE_ERROR::not_found_exception();
+}
 
 //overloaded [] for inserting/retrieving data DATA
 //behavior similar to map
-template<typename KEY, typename DATA>
-DATA& Red_Black<KEY, DATA>::operator[](const KEY &key)
+//if the data doesn't exist, construct a node with no data yet and return a reference to that.
+//the recursive insert finds or creates in one descent
+template<typename KEY, typename DATA, typename AUG>
+DATA& Red_Black<KEY, DATA, AUG>::operator[](const KEY &key)
 {
-    //if the data doesn't exist, construct a node with no data yet and return a reference to that.
-    if (!find(key)){
-        return insert(root, key);
-    }
-    return retrieve(key);
+    DATA &data = insert(root, key);
+    root -> color = Color::BLACK;
+    return data;
 }
 
 //retrieve a reference to the DATA
 //could be something where a reference is desired
 //even w/ shared pointers this should help keep the reference count down
-template<typename KEY, typename DATA>
-DATA& Red_Black<KEY, DATA>::retrieve(const KEY &key)
+//throwing version of find_ptr
+template<typename KEY, typename DATA, typename AUG>
+DATA& Red_Black<KEY, DATA, AUG>::retrieve(const KEY &key)
+{
+    if (DATA *data = find_ptr(key))
+        return *data;
+    throw TREE_ERROR::not_found_exception();
+}
+
+//number of keys in the tree less than 'key'
+//walks one path, adding up the left subtrees passed on the way
+template<typename KEY, typename DATA, typename AUG>
+int Red_Black<KEY, DATA, AUG>::rank(const KEY &key) const
 {
-    Node<KEY, DATA> *node = root.get();
+    int less{};
+    const Node<KEY, DATA, AUG> *node = root.get();
     while (node){
         if (key < node -> key)
             node = node -> left.get();
-        else if (key > node -> key)
+        else if (key > node -> key){
+            less += size(node -> left.get()) + 1;
             node = node -> right.get();
+        }
+        else
+            return less + size(node -> left.get());
+    }
+    return less;
+}
+
+//DATA at 0 based position 'index' in KEY sorted order
+template<typename KEY, typename DATA, typename AUG>
+DATA& Red_Black<KEY, DATA, AUG>::select(int index)
+{
+    Node<KEY, DATA, AUG> *node = root.get();
+    while (node){
+        int left{size(node -> left.get())};
+        if (index < left)
+            node = node -> left.get();
+        else if (index > left){
+            index -= left + 1;
+            node = node -> right.get();
+        }
         else
-            //found the data matching key
             return node -> data;
     }
     throw TREE_ERROR::not_found_exception();
 }
 
+//fetch the first 'k' KEYs and DATA in sorted order
+//stops descending once k are found, so O(log n + k)
+template<typename KEY, typename DATA, typename AUG>
+int Red_Black<KEY, DATA, AUG>::fetch_first(int k, vector<KEY> &keys, vector<DATA> &data) const
+{
+    keys.clear();
+    data.clear();
+    return fetch_first(root.get(), k, keys, data);
+}
+
+//recursive fetch first
+template<typename KEY, typename DATA, typename AUG>
+int Red_Black<KEY, DATA, AUG>::fetch_first(const Node<KEY, DATA, AUG> *root, int k, vector<KEY> &keys, vector<DATA> &data) const
+{
+    if (!root || static_cast<int>(keys.size()) >= k)
+        return 0;
+    int fetched{fetch_first(root -> left.get(), k, keys, data)};
+    if (static_cast<int>(keys.size()) < k){
+        keys.push_back(root -> key);
+        data.push_back(root -> data);
+        ++fetched;
+    }
+    fetched += fetch_first(root -> right.get(), k, keys, data);
+    return fetched;
+}
+
+//fetch at most 'k' KEYs and DATA in [low, high) in sorted order
+//subtrees entirely outside the range are never visited
+template<typename KEY, typename DATA, typename AUG>
+int Red_Black<KEY, DATA, AUG>::fetch_range(const KEY &low, const KEY &high, int k, vector<KEY> &keys, vector<DATA> &data) const
+{
+    keys.clear();
+    data.clear();
+    return fetch_range(root.get(), low, high, k, keys, data);
+}
+
+//recursive fetch range
+template<typename KEY, typename DATA, typename AUG>
+int Red_Black<KEY, DATA, AUG>::fetch_range(const Node<KEY, DATA, AUG> *root, const KEY &low, const KEY &high, int k, vector<KEY> &keys, vector<DATA> &data) const
+{
+    if (!root || static_cast<int>(keys.size()) >= k)
+        return 0;
+    int fetched{};
+    const bool above_low{!(root -> key < low)};
+    const bool below_high{root -> key < high};
+    if (above_low)
+        fetched += fetch_range(root -> left.get(), low, high, k, keys, data);
+    if (above_low && below_high && static_cast<int>(keys.size()) < k){
+        keys.push_back(root -> key);
+        data.push_back(root -> data);
+        ++fetched;
+    }
+    if (below_high)
+        fetched += fetch_range(root -> right.get(), low, high, k, keys, data);
+    return fetched;
+}
+
+//fetch at most 'k' KEYs and DATA that start with 'prefix'
+template<typename KEY, typename DATA, typename AUG>
+int Red_Black<KEY, DATA, AUG>::prefix_search(const KEY &prefix, int k, vector<KEY> &keys, vector<DATA> &data) const
+{
+    prefix_cursor cursor;
+    return prefix_search(cursor, prefix, k, keys, data);
+}
+
+//prefix search going on from where 'cursor' left off
+//steps for characters 'prefix' no longer shares with the cursor's prefix are dropped
+//and the search starts from the deepest step left, the root if there is none
+template<typename KEY, typename DATA, typename AUG>
+int Red_Black<KEY, DATA, AUG>::prefix_search(prefix_cursor &cursor, const KEY &prefix, int k, vector<KEY> &keys, vector<DATA> &data) const
+{
+    keys.clear();
+    data.clear();
+    const KEY &searched{cursor.searched};
+    const int length{static_cast<int>(prefix.size())};
+    int shared{};
+    while (shared < length && shared < static_cast<int>(searched.size()) && prefix[shared] == searched[shared])
+        ++shared;
+    while (!cursor.steps.empty() && cursor.steps.back().length > shared)
+        cursor.steps.pop_back();
+
+    //the same prefix again needs no search
+    if (cursor.steps.empty() || cursor.steps.back().length < length){
+        const rb_node *top{root.get()};
+        int base{};
+        if (!cursor.steps.empty()){
+            top = cursor.steps.back().top;
+            base = cursor.steps.back().base;
+        }
+        narrow(prefix, top, base, cursor);
+    }
+    cursor.searched = prefix;
+
+    const auto &step{cursor.steps.back()};
+    return fetch_from(step.top, step.first - step.base, std::min(k, step.matches), keys, data);
+}
+
+//find where the KEYs starting with 'prefix' split in the subtree 'top', whose smallest
+//key is at rank 'base', count them, and record it all as the cursor's next step
+template<typename KEY, typename DATA, typename AUG>
+void Red_Black<KEY, DATA, AUG>::narrow(const KEY &prefix, const Node<KEY, DATA, AUG> *top, int base, prefix_cursor &cursor) const
+{
+    const size_t length{prefix.size()};
+    //a KEY that does not match is before every match (go right) or after them all (go left)
+    while (top && top -> key.compare(0, length, prefix) != 0){
+        if (top -> key < prefix){
+            base += size(top -> left.get()) + 1;
+            top = top -> right.get();
+        }
+        else
+            top = top -> left.get();
+    }
+
+    int first{base};
+    int matches{};
+    if (top){
+        //on the left the KEYs before the matches are counted, on the right the matches
+        for (const rb_node *node{top -> left.get()}; node;){
+            if (node -> key < prefix){
+                first += size(node -> left.get()) + 1;
+                node = node -> right.get();
+            }
+            else
+                node = node -> left.get();
+        }
+        matches = base + size(top -> left.get()) - first + 1;
+        for (const rb_node *node{top -> right.get()}; node;){
+            if (node -> key.compare(0, length, prefix) == 0){
+                matches += size(node -> left.get()) + 1;
+                node = node -> right.get();
+            }
+            else
+                node = node -> left.get();
+        }
+    }
+    cursor.steps.push_back(typename prefix_cursor::Step{static_cast<int>(length), top, base, first, matches});
+}
+
+//fetch 'k' KEYs and DATA in sorted order, skipping the first 'skip' of 'root's subtree
+//the subtree counts lead straight to the first one, so O(log n + k)
+template<typename KEY, typename DATA, typename AUG>
+int Red_Black<KEY, DATA, AUG>::fetch_from(const Node<KEY, DATA, AUG> *root, int skip, int k, vector<KEY> &keys, vector<DATA> &data) const
+{
+    if (!root || static_cast<int>(keys.size()) >= k)
+        return 0;
+    int fetched{};
+    const int left{size(root -> left.get())};
+    if (skip < left)
+        fetched += fetch_from(root -> left.get(), skip, k, keys, data);
+    if (skip <= left && static_cast<int>(keys.size()) < k){
+        keys.push_back(root -> key);
+        data.push_back(root -> data);
+        ++fetched;
+    }
+    fetched += fetch_from(root -> right.get(), std::max(0, skip - left - 1), k, keys, data);
+    return fetched;
+}
+
+//AUG's value over [low, high)
+//below the node where the two bounds part, each step towards 'low' that stays at or
+//above it takes in the node and its right subtree whole, and each step towards 'high'
+//that stays below it the node and its left subtree, so two paths down and no more
+template<typename KEY, typename DATA, typename AUG>
+typename AUG::value_type Red_Black<KEY, DATA, AUG>::aggregate(const KEY &low, const KEY &high) const
+{
+    const rb_node *split{root.get()};
+    while (split && (split -> key < low || !(split -> key < high)))
+        split = split -> key < low ? split -> right.get() : split -> left.get();
+    if (!split)
+        return AUG::identity();
+
+    auto before{AUG::identity()};
+    for (const rb_node *node{split -> left.get()}; node;){
+        if (node -> key < low)
+            node = node -> right.get();
+        else{
+            before = AUG::combine(AUG::combine(AUG::of(node -> key, node -> data), summary(node -> right.get())), before);
+            node = node -> left.get();
+        }
+    }
+    auto after{AUG::identity()};
+    for (const rb_node *node{split -> right.get()}; node;){
+        if (!(node -> key < high))
+            node = node -> left.get();
+        else{
+            after = AUG::combine(after, AUG::combine(summary(node -> left.get()), AUG::of(node -> key, node -> data)));
+            node = node -> right.get();
+        }
+    }
+    return AUG::combine(AUG::combine(before, AUG::of(split -> key, split -> data)), after);
+}
+
+//AUG's value over the whole tree, kept at the root
+template<typename KEY, typename DATA, typename AUG>
+typename AUG::value_type Red_Black<KEY, DATA, AUG>::aggregate() const
+{
+    return summary(root.get());
+}
+
+//update wrapper
+template<typename KEY, typename DATA, typename AUG>
+bool Red_Black<KEY, DATA, AUG>::update(const KEY &key)
+{
+    return update(root.get(), key);
+}
+
+//recursive update, every node on the way down to 'key' is recounted on the way back
+template<typename KEY, typename DATA, typename AUG>
+bool Red_Black<KEY, DATA, AUG>::update(Node<KEY, DATA, AUG> *root, const KEY &key)
+{
+    if (!root)
+        return false;
+    bool found{true};
+    if (key < root -> key)
+        found = update(root -> left.get(), key);
+    else if (key > root -> key)
+        found = update(root -> right.get(), key);
+    if (found)
+        resize(root);
+    return found;
+}
+
+//add up the memory of every node and what its KEY and DATA own
+template<typename KEY, typename DATA, typename AUG>
+void Red_Black<KEY, DATA, AUG>::account(Memory &nodes, Memory &keys, Memory &data) const
+{
+    if (block)
+        nodes.allocation(slots * sizeof(Slot), block.get());
+    account(root.get(), nodes, keys, data);
+}
+
+//recursive account
+template<typename KEY, typename DATA, typename AUG>
+void Red_Black<KEY, DATA, AUG>::account(const Node<KEY, DATA, AUG> *root, Memory &nodes, Memory &keys, Memory &data) const
+{
+    if (!root)
+        return;
+    if (!root -> packed)
+        nodes.allocation(sizeof(rb_node), root);
+    heap_usage(root -> key, keys);
+    heap_usage(root -> data, data);
+    account(root -> left.get(), nodes, keys, data);
+    account(root -> right.get(), nodes, keys, data);
+}
+
+//start (or stop, with nullptr) reporting to a recorder
+//the recorder keeps the current shape so a replay starts from the same tree
+template<typename KEY, typename DATA, typename AUG>
+void Red_Black<KEY, DATA, AUG>::trace(Trace<KEY> *recorder)
+{
+    this -> recorder = recorder;
+    if (recorder)
+        recorder -> start(*this);
+}
+
+//lay every node out again in one block, in van Emde Boas order
+template<typename KEY, typename DATA, typename AUG>
+void Red_Black<KEY, DATA, AUG>::compact()
+{
+    const int total{size(root.get())};
+    if (!total){
+        block.reset();
+        slots = 0;
+        return;
+    }
+
+    vector<Node<KEY, DATA, AUG>*> order, below;
+    order.reserve(total);
+    layout(root.get(), height(root.get()), order, below);
+
+    //each node moves to its slot with its links, and its old self keeps its new place in 'count'
+    //(parents come before their children in the order, so a child's place is known when it is needed)
+    unique_ptr<Slot[]> fresh{new Slot[total]};
+    vector<Node<KEY, DATA, AUG>*> placed(total);
+    for (int i{}; i < total; ++i){
+        placed[i] = new (&fresh[i]) Node<KEY, DATA, AUG>(move(*order[i]));
+        placed[i] -> packed = true;
+        order[i] -> count = i;
+    }
+    for (auto *node : placed){
+        if (node -> left)
+            node -> left.reset(placed[node -> left.release() -> count]);
+        if (node -> right)
+            node -> right.reset(placed[node -> right.release() -> count]);
+    }
+
+    //the old nodes are empty shells now, freed before the old block some of them are in
+    root.release();
+    root.reset(placed[0]);
+    for (auto *node : order)
+        std::default_delete<Node<KEY, DATA, AUG>>()(node);
+    block = move(fresh);
+    slots = total;
+}
+
+//levels in the subtree at root
+template<typename KEY, typename DATA, typename AUG>
+int Red_Black<KEY, DATA, AUG>::height(const Node<KEY, DATA, AUG> *root)
+{
+    return root ? 1 + std::max(height(root -> left.get()), height(root -> right.get())) : 0;
+}
+
+//append the top 'height' levels of the subtree at root to 'order' in van Emde Boas order:
+//the top half of the levels, then each subtree hanging below them, left to right
+//'below' is shared scratch space, each call only uses what it appended
+template<typename KEY, typename DATA, typename AUG>
+void Red_Black<KEY, DATA, AUG>::layout(Node<KEY, DATA, AUG> *root, int height, vector<Node<KEY, DATA, AUG>*> &order,
+                                       vector<Node<KEY, DATA, AUG>*> &below)
+{
+    if (!root || height < 1)
+        return;
+    if (height == 1){
+        order.push_back(root);
+        return;
+    }
+
+    const int top{height / 2};
+    layout(root, top, order, below);
+    const size_t first{below.size()};
+    descend(root, top, below);
+    const size_t last{below.size()};
+    for (size_t i{first}; i < last; ++i)
+        layout(below[i], height - top, order, below);
+    below.resize(first);
+}
+
+//the nodes 'depth' levels below root, left to right
+template<typename KEY, typename DATA, typename AUG>
+void Red_Black<KEY, DATA, AUG>::descend(Node<KEY, DATA, AUG> *root, int depth, vector<Node<KEY, DATA, AUG>*> &below)
+{
+    if (!root)
+        return;
+    if (!depth){
+        below.push_back(root);
+        return;
+    }
+    descend(root -> left.get(), depth - 1, below);
+    descend(root -> right.get(), depth - 1, below);
+}
+
 //fetch all the KEY (by value) into a vector in sorted order
-template<typename KEY, typename DATA>
-int Red_Black<KEY, DATA>::fetch_keys(vector<KEY> &keys) const
+template<typename KEY, typename DATA, typename AUG>
+int Red_Black<KEY, DATA, AUG>::fetch_keys(vector<KEY> &keys) const
 {
     keys.reserve(size(root.get()));
     return fetch_keys(root.get(), keys);
 }
 
 //recursively fetch KEYs into a vector
-template<typename KEY, typename DATA>
-int Red_Black<KEY, DATA>::fetch_keys(const Node<KEY, DATA> *root, std::vector<KEY> &keys) const
+template<typename KEY, typename DATA, typename AUG>
+int Red_Black<KEY, DATA, AUG>::fetch_keys(const Node<KEY, DATA, AUG> *root, std::vector<KEY> &keys) const
 {
     if (!root)
         return 0;
@@ -379,17 +1050,37 @@ int Red_Black<KEY, DATA>::fetch_keys(const Node<KEY, DATA> *root, std::vector<KE
     return fetched;
 }
 
+//visit every KEY and DATA in sorted order without copying them
+template<typename KEY, typename DATA, typename AUG>
+template<typename VISIT>
+void Red_Black<KEY, DATA, AUG>::for_each(VISIT &&visit) const
+{
+    for_each(root.get(), visit);
+}
+
+//recursive for each
+template<typename KEY, typename DATA, typename AUG>
+template<typename VISIT>
+void Red_Black<KEY, DATA, AUG>::for_each(const Node<KEY, DATA, AUG> *root, VISIT &visit) const
+{
+    if (!root)
+        return;
+    for_each(root -> left.get(), visit);
+    visit(root -> key, root -> data);
+    for_each(root -> right.get(), visit);
+}
+
 //fetch all the DATA into a vector in KEY sorted order
-template<typename KEY, typename DATA>
-int Red_Black<KEY, DATA>::fetch_data(vector<DATA> &data)
+template<typename KEY, typename DATA, typename AUG>
+int Red_Black<KEY, DATA, AUG>::fetch_data(vector<DATA> &data)
 {
     data.reserve(size(root.get()));
     return fetch_data(root.get(), data);
 }
 
 //recursive fetch all DATA into a vector
-template<typename KEY, typename DATA>
-int Red_Black<KEY, DATA>::fetch_data(const Node<KEY, DATA> *root, vector<DATA> &data)
+template<typename KEY, typename DATA, typename AUG>
+int Red_Black<KEY, DATA, AUG>::fetch_data(const Node<KEY, DATA, AUG> *root, vector<DATA> &data)
 {
     if (!root)
         return 0;
@@ -402,30 +1093,224 @@ int Red_Black<KEY, DATA>::fetch_data(const Node<KEY, DATA> *root, vector<DATA> &
 
 //remove all - smart pointers
 //safely clear entire tree by setting root to null
-template<typename KEY, typename DATA>
-int Red_Black<KEY, DATA>::remove_all()
+template<typename KEY, typename DATA, typename AUG>
+int Red_Black<KEY, DATA, AUG>::remove_all()
 {
     int num_items{size(root.get())};
     root.reset();
+    block.reset();
+    slots = 0;
     return num_items;
 }
 
 //remove wrapper
-template<typename KEY, typename DATA>
-bool Red_Black<KEY, DATA>::remove(const KEY &key)
+template<typename KEY, typename DATA, typename AUG>
+bool Red_Black<KEY, DATA, AUG>::remove(const KEY &key)
 {
-    //if we can assign something back to root, the deletion process ran correctly
-    if ((root = remove(root, key))){
+    //the removal below assumes the key is present
+    if (!find(key))
+        return false;
+    if (recorder)
+        recorder -> record(Event::REMOVE, key);
+
+    //if both of root's children are black, make root red so there is a red to move down
+    if (!is_red(root -> left.get()) && !is_red(root -> right.get()))
+        root -> color = Color::RED;
+
+    //the removed node is destroyed when 'detached' goes out of scope
+    unique_ptr<Node<KEY, DATA, AUG>> detached;
+    root = remove(root, key, detached);
+    if (root)
+        root -> color = Color::BLACK;
+    return true;
+}
+
+//take the node at key out of the tree and hand ownership to the caller
+//returns an empty handle if the key is not present
+template<typename KEY, typename DATA, typename AUG>
+typename Red_Black<KEY, DATA, AUG>::node_handle Red_Black<KEY, DATA, AUG>::extract(const KEY &key)
+{
+    if (!find(key))
+        return node_handle();
+    if (recorder)
+        recorder -> record(Event::REMOVE, key);
+
+    if (!is_red(root -> left.get()) && !is_red(root -> right.get()))
+        root -> color = Color::RED;
+
+    unique_ptr<Node<KEY, DATA, AUG>> detached;
+    root = remove(root, key, detached);
+    if (root)
         root -> color = Color::BLACK;
-        return true;
+
+    //a handle can outlive the tree, so a node in its block leaves as a copy on the heap
+    if (detached -> packed){
+        detached = make_unique<Node<KEY, DATA, AUG>>(move(*detached));
+        detached -> packed = false;
+    }
+
+    //the node leaves as a lone red leaf, ready to be inserted again
+    detached -> color = Color::RED;
+    resize(detached.get());
+    return node_handle(move(detached));
+}
+
+//put an extracted node (back) into a tree
+//the node itself is linked in, nothing is allocated or copied
+//if the key is already present the handle keeps its node and false is returned
+template<typename KEY, typename DATA, typename AUG>
+bool Red_Black<KEY, DATA, AUG>::insert(node_handle &&handle)
+{
+    if (handle.empty() || find(handle.node -> key))
+        return false;
+
+    //the key or data may have changed while it was out
+    resize(handle.node.get());
+    root = insert(root, handle.node);
+    root -> color = Color::BLACK;
+    return true;
+}
+
+//insert recursive for an existing node
+//'node' is moved into place at the bottom, then the path is rebalanced by fixup
+template<typename KEY, typename DATA, typename AUG>
+unique_ptr<Node<KEY, DATA, AUG>> Red_Black<KEY, DATA, AUG>::
+insert(unique_ptr<Node<KEY, DATA, AUG>> &root, unique_ptr<Node<KEY, DATA, AUG>> &node)
+{
+    if (!root){
+        if (recorder)
+            recorder -> record(Event::INSERT, node -> key);
+        return move(node);
+    }
+
+    if (node -> key < root -> key)
+        root -> left = insert(root -> left, node);
+    else
+        root -> right = insert(root -> right, node);
+
+    return fixup(root);
+}
+
+//remove every entry 'pred' picks, one at a time or by rebuilding, whichever is cheaper
+template<typename KEY, typename DATA, typename AUG>
+template<typename PREDICATE>
+int Red_Black<KEY, DATA, AUG>::remove_if(PREDICATE &&pred)
+{
+    vector<const Node<KEY, DATA, AUG>*> doomed;
+    mark(root.get(), pred, doomed);
+    if (doomed.empty())
+        return 0;
+
+    //a removal walks a path of about log2(n) nodes down and back up, a rebuild relinks every node once
+    const int total{size(root.get())};
+    int depth{1};
+    while (total >> depth)
+        ++depth;
+    if (recorder || static_cast<long>(doomed.size()) * depth * REMOVAL_COST < total){
+        //removal splices nodes rather than copying them, so each doomed node (and the key
+        //it is removed by) stays where it is until it is the one removed
+        for (const auto *node : doomed)
+            remove(node -> key);
+        return static_cast<int>(doomed.size());
+    }
+
+    vector<unique_ptr<Node<KEY, DATA, AUG>>> kept;
+    kept.reserve(total - doomed.size());
+    size_t next{};
+    flatten(root, doomed, next, kept);
+
+    //most[h] is the most keys a tree of black height h holds (all 3-nodes), 3^h - 1
+    //the shortest tree that holds them all is built
+    vector<long> most{0};
+    while (most.back() < static_cast<long>(kept.size()))
+        most.push_back(3 * most.back() + 2);
+    root = build(kept, 0, static_cast<int>(kept.size()), static_cast<int>(most.size()) - 1, most);
+    return static_cast<int>(doomed.size());
+}
+
+//keep only the entries 'pred' picks
+template<typename KEY, typename DATA, typename AUG>
+template<typename PREDICATE>
+int Red_Black<KEY, DATA, AUG>::retain(PREDICATE &&pred)
+{
+    return remove_if([&pred](const KEY &key, const DATA &data){ return !pred(key, data); });
+}
+
+//in order, collect the nodes 'pred' is true for
+template<typename KEY, typename DATA, typename AUG>
+template<typename PREDICATE>
+void Red_Black<KEY, DATA, AUG>::mark(const Node<KEY, DATA, AUG> *root, PREDICATE &pred, vector<const Node<KEY, DATA, AUG>*> &doomed)
+{
+    if (!root)
+        return;
+    mark(root -> left.get(), pred, doomed);
+    if (pred(root -> key, root -> data))
+        doomed.push_back(root);
+    mark(root -> right.get(), pred, doomed);
+}
+
+//take the tree apart in order, destroying the doomed nodes (they come up in the same order)
+//and moving the rest to 'kept' unlinked
+template<typename KEY, typename DATA, typename AUG>
+void Red_Black<KEY, DATA, AUG>::flatten(unique_ptr<Node<KEY, DATA, AUG>> &root, const vector<const Node<KEY, DATA, AUG>*> &doomed,
+                                        size_t &next, vector<unique_ptr<Node<KEY, DATA, AUG>>> &kept)
+{
+    if (!root)
+        return;
+    unique_ptr<Node<KEY, DATA, AUG>> left{move(root -> left)}, right{move(root -> right)};
+    flatten(left, doomed, next, kept);
+    if (next < doomed.size() && doomed[next] == root.get()){
+        ++next;
+        root.reset();
+    }
+    else
+        kept.push_back(move(root));
+    flatten(right, doomed, next, kept);
+}
+
+//link nodes[first, first + count) into a left leaning tree of black height 'height', O(count)
+//built as the 2-3 tree it stands for: a 2-node while its two subtrees can hold the rest,
+//otherwise a 3-node (a black node and its red left child) over three subtrees
+template<typename KEY, typename DATA, typename AUG>
+unique_ptr<Node<KEY, DATA, AUG>> Red_Black<KEY, DATA, AUG>::
+build(vector<unique_ptr<Node<KEY, DATA, AUG>>> &nodes, int first, int count, int height, const vector<long> &most)
+{
+    if (!count)
+        return nullptr;
+
+    if (count - 1 <= 2 * most[height - 1]){
+        int left{(count - 1) / 2};
+        unique_ptr<Node<KEY, DATA, AUG>> top{move(nodes[first + left])};
+        top -> left = build(nodes, first, left, height - 1, most);
+        top -> right = build(nodes, first + left + 1, count - 1 - left, height - 1, most);
+        top -> color = Color::BLACK;
+        resize(top.get());
+        return top;
     }
-    return false;
+
+    //split what is left over the three subtrees as evenly as it goes
+    int third{(count - 2) / 3};
+    int left{third + ((count - 2) % 3 > 0)};
+    int middle{third + ((count - 2) % 3 > 1)};
+    unique_ptr<Node<KEY, DATA, AUG>> red{move(nodes[first + left])};
+    red -> left = build(nodes, first, left, height - 1, most);
+    red -> right = build(nodes, first + left + 1, middle, height - 1, most);
+    red -> color = Color::RED;
+    resize(red.get());
+
+    unique_ptr<Node<KEY, DATA, AUG>> top{move(nodes[first + left + 1 + middle])};
+    top -> left = move(red);
+    top -> right = build(nodes, first + left + middle + 2, third, height - 1, most);
+    top -> color = Color::BLACK;
+    resize(top.get());
+    return top;
 }
 
 //remove recursive
-template<typename KEY, typename DATA>
-unique_ptr<Node<KEY, DATA>> Red_Black<KEY, DATA>::
-remove(unique_ptr<Node<KEY, DATA>> &root, const KEY &key)
+//the node holding key is moved into 'detached' rather than destroyed
+template<typename KEY, typename DATA, typename AUG>
+unique_ptr<Node<KEY, DATA, AUG>> Red_Black<KEY, DATA, AUG>::
+remove(unique_ptr<Node<KEY, DATA, AUG>> &root, const KEY &key, unique_ptr<Node<KEY, DATA, AUG>> &detached)
 {
     if (!root) return nullptr;
 
@@ -443,7 +1328,7 @@ remove(unique_ptr<Node<KEY, DATA>> &root, const KEY &key)
                 root = red_left(root);
 
             //continue looking left
-            root -> left = remove(root -> left, key);
+            root -> left = remove(root -> left, key, detached);
         }
     }
 
@@ -454,8 +1339,9 @@ remove(unique_ptr<Node<KEY, DATA>> &root, const KEY &key)
             root = rotate_right(root);
 
         //if a match is found and there is no right subtree
-        //delete the item and return nullptr
+        //detach the item and return nullptr
         if (key == root -> key && !root -> right){
+            detached = move(root);
             return nullptr;
         }
 
@@ -464,13 +1350,19 @@ remove(unique_ptr<Node<KEY, DATA>> &root, const KEY &key)
 
         if (key == root -> key){
 
-            root -> data = retrieve_ios_data(root -> right.get());
-            root -> key = retrieve_ios_key(root -> right.get());
-            root -> right = remove_ios(root -> right);
+            //detach the in order successor and splice it in where root was
+            //instead of copying its key and data over root's
+            unique_ptr<Node<KEY, DATA, AUG>> successor;
+            root -> right = remove_ios(root -> right, successor);
+            successor -> left = move(root -> left);
+            successor -> right = move(root -> right);
+            successor -> color = root -> color;
+            detached = move(root);
+            root = move(successor);
         }
 
         else
-            root -> right = remove(root -> right, key);
+            root -> right = remove(root -> right, key, detached);
     }
 
     //fix the red nodes not on the left and flip colors if needed
@@ -479,12 +1371,15 @@ remove(unique_ptr<Node<KEY, DATA>> &root, const KEY &key)
 
 
 //rotate "node" and it's left and right 1 cycle left
-template<typename KEY, typename DATA>
-unique_ptr<Node<KEY, DATA>> Red_Black<KEY, DATA>::
-rotate_left(unique_ptr<Node<KEY, DATA>> &node)
+template<typename KEY, typename DATA, typename AUG>
+unique_ptr<Node<KEY, DATA, AUG>> Red_Black<KEY, DATA, AUG>::
+rotate_left(unique_ptr<Node<KEY, DATA, AUG>> &node)
 {
+    if (recorder)
+        recorder -> record(Event::ROTATE_LEFT, node -> key);
+
     //hold node's right
-    unique_ptr<Node<KEY, DATA>> temp = move(node -> right);
+    unique_ptr<Node<KEY, DATA, AUG>> temp = move(node -> right);
     //move node's right's left to node's right
     node -> right = move(temp -> left);
     //move node to temp's left
@@ -494,16 +1389,23 @@ rotate_left(unique_ptr<Node<KEY, DATA>> &node)
     temp -> color = temp -> left -> color;
     temp -> left -> color = Color::RED;
 
+    //recount bottom up, node is now below temp
+    resize(temp -> left.get());
+    resize(temp.get());
+
     return temp;
 }
 
 //rotate "node" and it's left and right 1 cycle right
-template<typename KEY, typename DATA>
-unique_ptr<Node<KEY, DATA>> Red_Black<KEY, DATA>::
-rotate_right(unique_ptr<Node<KEY, DATA>> &node)
+template<typename KEY, typename DATA, typename AUG>
+unique_ptr<Node<KEY, DATA, AUG>> Red_Black<KEY, DATA, AUG>::
+rotate_right(unique_ptr<Node<KEY, DATA, AUG>> &node)
 {
+    if (recorder)
+        recorder -> record(Event::ROTATE_RIGHT, node -> key);
+
     //hold the left
-    unique_ptr<Node<KEY, DATA>> temp = move(node -> left);
+    unique_ptr<Node<KEY, DATA, AUG>> temp = move(node -> left);
     //move node's left's right to node's left
     node -> left = move(temp -> right);
     //move node to temp's right
@@ -513,14 +1415,16 @@ rotate_right(unique_ptr<Node<KEY, DATA>> &node)
     temp -> color = temp -> right -> color;
     temp -> right -> color = Color::RED;
 
+    resize(temp -> right.get());
+    resize(temp.get());
 
     return temp;
 }
 
 //move the red pointer left (used on deletion)
-template<typename KEY, typename DATA>
-unique_ptr<Node<KEY, DATA>> Red_Black<KEY, DATA>::
-red_left(unique_ptr<Node<KEY, DATA>> &node)
+template<typename KEY, typename DATA, typename AUG>
+unique_ptr<Node<KEY, DATA, AUG>> Red_Black<KEY, DATA, AUG>::
+red_left(unique_ptr<Node<KEY, DATA, AUG>> &node)
 {
     flip_colors(node.get());
 
@@ -537,9 +1441,9 @@ red_left(unique_ptr<Node<KEY, DATA>> &node)
 }
 
 //move the red node to the right, (used on deletion)
-template<typename KEY, typename DATA>
-unique_ptr<Node<KEY, DATA>> Red_Black<KEY, DATA>::
-red_right(unique_ptr<Node<KEY, DATA>> &node)
+template<typename KEY, typename DATA, typename AUG>
+unique_ptr<Node<KEY, DATA, AUG>> Red_Black<KEY, DATA, AUG>::
+red_right(unique_ptr<Node<KEY, DATA, AUG>> &node)
 {
 
     flip_colors(node.get());
@@ -557,9 +1461,12 @@ red_right(unique_ptr<Node<KEY, DATA>> &node)
 
 //take as black source with red children and make it red with black children
 //assert checks a condition and returns if its false
-template<typename KEY, typename DATA>
-void Red_Black<KEY, DATA>::flip_colors(Node<KEY, DATA> *source)
+template<typename KEY, typename DATA, typename AUG>
+void Red_Black<KEY, DATA, AUG>::flip_colors(Node<KEY, DATA, AUG> *source)
 {
+    if (recorder)
+        recorder -> record(Event::FLIP, source -> key);
+
     //invert colors of parent and child (if exists)
     //check to avoid dereferencing a null left/right pointer.
     if (is_red(source))
@@ -595,47 +1502,32 @@ void Red_Black<KEY, DATA>::flip_colors(Node<KEY, DATA> *source)
     */
 }
 
-//go to the smallest item and get its key
-template<typename KEY, typename DATA>
-KEY& Red_Black<KEY, DATA>::retrieve_ios_key(Node<KEY, DATA> *node)
-{
-    while (node -> left)
-        node = node -> left.get();
-    return node -> key;
-}
-
-//go to the smallest item and get its data
-template<typename KEY, typename DATA>
-DATA& Red_Black<KEY, DATA>::retrieve_ios_data(Node<KEY, DATA> *node)
-{
-    while (node -> left)
-        node = node -> left.get();
-    return node -> data;
-}
-
-//go to the smallest item and remove it
-template<typename KEY, typename DATA>
-unique_ptr<Node<KEY, DATA>> Red_Black<KEY, DATA>::
-remove_ios(unique_ptr<Node<KEY, DATA>> &node)
+//go to the smallest item and detach it into 'smallest'
+template<typename KEY, typename DATA, typename AUG>
+unique_ptr<Node<KEY, DATA, AUG>> Red_Black<KEY, DATA, AUG>::
+remove_ios(unique_ptr<Node<KEY, DATA, AUG>> &node, unique_ptr<Node<KEY, DATA, AUG>> &smallest)
 {
     //no left node
-    if (!node -> left)
-        return move(node -> right);
+    if (!node -> left){
+        unique_ptr<Node<KEY, DATA, AUG>> right{move(node -> right)};
+        smallest = move(node);
+        return right;
+    }
 
     //left and left -> left are black
     if (!is_red(node -> left.get()) && !is_red(node -> left -> left.get()))
         node = red_left(node);
 
     //recurse left and return to the left node
-    node -> left = remove_ios(node -> left);
+    node -> left = remove_ios(node -> left, smallest);
 
     return fixup(node);
 }
 
 //fix tree after deletion, recursive
-template<typename KEY, typename DATA>
-unique_ptr<Node<KEY, DATA>> Red_Black<KEY, DATA>::
-fixup(unique_ptr<Node<KEY, DATA>> &node)
+template<typename KEY, typename DATA, typename AUG>
+unique_ptr<Node<KEY, DATA, AUG>> Red_Black<KEY, DATA, AUG>::
+fixup(unique_ptr<Node<KEY, DATA, AUG>> &node)
 {
     if (!node)
         return nullptr;
@@ -655,16 +1547,316 @@ fixup(unique_ptr<Node<KEY, DATA>> &node)
     if (is_red(node -> left.get()) && is_red(node -> right.get()))
         flip_colors(node.get());
 
+    //every removal path unwinds through here
+    resize(node.get());
 
     return move(node);
 }
 
 
+//recount a node from its children, and its AUG value from theirs and its own entry
+template<typename KEY, typename DATA, typename AUG>
+void Red_Black<KEY, DATA, AUG>::resize(Node<KEY, DATA, AUG> *node)
+{
+    node -> count = 1 + size(node -> left.get()) + size(node -> right.get());
+    node -> summary = AUG::combine(AUG::combine(summary(node -> left.get()), AUG::of(node -> key, node -> data)),
+                                   summary(node -> right.get()));
+}
+
+//AUG value of the subtree at node, identity for an empty one
+template<typename KEY, typename DATA, typename AUG>
+typename AUG::value_type Red_Black<KEY, DATA, AUG>::summary(const Node<KEY, DATA, AUG> *node)
+{
+    return node ? node -> summary : AUG::identity();
+}
+
 //call Node's is_red
-template<typename KEY, typename DATA>
-bool Red_Black<KEY, DATA>::is_red(const Node<KEY, DATA> *node)
+template<typename KEY, typename DATA, typename AUG>
+bool Red_Black<KEY, DATA, AUG>::is_red(const Node<KEY, DATA, AUG> *node) const
 {
-    return Node<KEY, DATA>::is_red(node);
+    return Node<KEY, DATA, AUG>::is_red(node);
 }
 
+/*
+ *********************************************************************
+ * node handle
+ *********************************************************************
+ */
+
+//empty handle
+template<typename KEY, typename DATA, typename AUG>
+Red_Black<KEY, DATA, AUG>::node_handle::node_handle() : node(nullptr) {}
+
+//cursor with nothing searched yet
+template<typename KEY, typename DATA, typename AUG>
+Red_Black<KEY, DATA, AUG>::prefix_cursor::prefix_cursor() {}
+
+//forget every step, the next search starts at the root
+template<typename KEY, typename DATA, typename AUG>
+void Red_Black<KEY, DATA, AUG>::prefix_cursor::clear()
+{
+    searched = KEY();
+    steps.clear();
+}
+
+//the prefix searched last
+template<typename KEY, typename DATA, typename AUG>
+const KEY& Red_Black<KEY, DATA, AUG>::prefix_cursor::prefix() const
+{
+    return searched;
+}
+
+//how many KEYs start with the prefix searched last
+template<typename KEY, typename DATA, typename AUG>
+int Red_Black<KEY, DATA, AUG>::prefix_cursor::matches() const
+{
+    return steps.empty() ? 0 : steps.back().matches;
+}
+
+//rank of the first KEY starting with the prefix searched last
+template<typename KEY, typename DATA, typename AUG>
+int Red_Black<KEY, DATA, AUG>::prefix_cursor::first() const
+{
+    return steps.empty() ? 0 : steps.back().first;
+}
+
+//handle owning an extracted node
+template<typename KEY, typename DATA, typename AUG>
+Red_Black<KEY, DATA, AUG>::node_handle::node_handle(unique_ptr<Node<KEY, DATA, AUG>> node_in) : node(move(node_in)) {}
+
+//true if the handle does not own a node
+template<typename KEY, typename DATA, typename AUG>
+bool Red_Black<KEY, DATA, AUG>::node_handle::empty() const
+{
+    return !node;
+}
+
+//the key can be changed while the node is out of the tree
+template<typename KEY, typename DATA, typename AUG>
+KEY& Red_Black<KEY, DATA, AUG>::node_handle::key()
+{
+    return node -> key;
+}
+
+//the data the node carries
+template<typename KEY, typename DATA, typename AUG>
+DATA& Red_Black<KEY, DATA, AUG>::node_handle::data()
+{
+    return node -> data;
+}
+
+/*
+ *********************************************************************
+ * trace template
+ * data members are:
+ *      std::vector<KEY> keys;
+ *      Red_Black<KEY, uint32_t> interned;
+ *      std::vector<Step> steps;
+ *      std::vector<uint32_t> shape_keys;
+ *      std::vector<unsigned char> shape_flags;
+ *********************************************************************
+ */
 
+//flags kept for each node of the starting shape
+static const unsigned char SHAPE_RED{1}, SHAPE_LEFT{2}, SHAPE_RIGHT{4};
+
+//default constructor
+template<typename KEY>
+Trace<KEY>::Trace() {}
+
+//forget everything and remember the shape of 'tree'
+template<typename KEY>
+template<typename DATA, typename AUG>
+void Trace<KEY>::start(const Red_Black<KEY, DATA, AUG> &tree)
+{
+    clear();
+    start(tree.root.get());
+}
+
+//preorder walk of the starting shape
+template<typename KEY>
+template<typename DATA, typename AUG>
+void Trace<KEY>::start(const Node<KEY, DATA, AUG> *node)
+{
+    if (!node)
+        return;
+    unsigned char flags{};
+    if (node -> color == Color::RED)
+        flags |= SHAPE_RED;
+    if (node -> left)
+        flags |= SHAPE_LEFT;
+    if (node -> right)
+        flags |= SHAPE_RIGHT;
+    shape_keys.push_back(intern(node -> key));
+    shape_flags.push_back(flags);
+    start(node -> left.get());
+    start(node -> right.get());
+}
+
+//rebuild the starting shape in 'tree', DATA is default constructed
+template<typename KEY>
+template<typename DATA, typename AUG>
+void Trace<KEY>::restore(Red_Black<KEY, DATA, AUG> &tree) const
+{
+    size_t index{};
+    tree.root = restore<DATA, AUG>(index);
+}
+
+//recursive restore, consumes the preorder arrays from 'index'
+template<typename KEY>
+template<typename DATA, typename AUG>
+std::unique_ptr<Node<KEY, DATA, AUG>> Trace<KEY>::restore(size_t &index) const
+{
+    if (index >= shape_keys.size())
+        return nullptr;
+    const unsigned char flags{shape_flags[index]};
+    auto node{std::make_unique<Node<KEY, DATA, AUG>>(keys[shape_keys[index]],
+            flags & SHAPE_RED ? Color::RED : Color::BLACK)};
+    ++index;
+    if (flags & SHAPE_LEFT)
+        node -> left = restore<DATA, AUG>(index);
+    if (flags & SHAPE_RIGHT)
+        node -> right = restore<DATA, AUG>(index);
+    Red_Black<KEY, DATA, AUG>::resize(node.get());
+    return node;
+}
+
+//append an event
+template<typename KEY>
+void Trace<KEY>::record(Event event, const KEY &key)
+{
+    steps.push_back(Step{event, intern(key)});
+}
+
+//empty the trace
+template<typename KEY>
+void Trace<KEY>::clear()
+{
+    keys.clear();
+    interned.remove_all();
+    steps.clear();
+    shape_keys.clear();
+    shape_flags.clear();
+}
+
+//number of events recorded
+template<typename KEY>
+int Trace<KEY>::size() const
+{
+    return static_cast<int>(steps.size());
+}
+
+//the event at 'index'
+template<typename KEY>
+Event Trace<KEY>::event(int index) const
+{
+    return steps[index].event;
+}
+
+//the key the event at 'index' happened to
+template<typename KEY>
+const KEY& Trace<KEY>::key(int index) const
+{
+    return keys[steps[index].key];
+}
+
+//index of key in 'keys', adding it the first time it is seen
+template<typename KEY>
+uint32_t Trace<KEY>::intern(const KEY &key)
+{
+    auto [index, inserted] = interned.try_insert(key, static_cast<uint32_t>(keys.size()));
+    if (inserted)
+        keys.push_back(key);
+    return *index;
+}
+
+//binary export
+//magic, keys, starting shape then the events
+template<typename KEY>
+bool Trace<KEY>::save(const string &filename) const
+{
+    std::ofstream out(filename, std::ios::binary);
+    if (!out)
+        return false;
+
+    auto write_count = [&out](size_t count){
+        uint32_t value{static_cast<uint32_t>(count)};
+        out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    };
+
+    out.write("RBTRACE1", 8);
+    write_count(keys.size());
+    for (const KEY &key : keys)
+        write_key(out, key);
+    write_count(shape_keys.size());
+    for (size_t i{}; i < shape_keys.size(); ++i){
+        write_key(out, shape_keys[i]);
+        write_key(out, shape_flags[i]);
+    }
+    write_count(steps.size());
+    for (const Step &step : steps){
+        write_key(out, step.event);
+        write_key(out, step.key);
+    }
+    return static_cast<bool>(out);
+}
+
+//binary import, the trace is left empty if the file is not a trace
+template<typename KEY>
+bool Trace<KEY>::load(const string &filename)
+{
+    clear();
+    std::ifstream in(filename, std::ios::binary);
+    char magic[8]{};
+    in.read(magic, 8);
+    if (!in || string(magic, 8) != "RBTRACE1")
+        return false;
+
+    auto read_count = [&in](){
+        uint32_t value{};
+        in.read(reinterpret_cast<char*>(&value), sizeof(value));
+        return in ? value : 0;
+    };
+
+    //the counts are not trusted: entries are added as they are read, so
+    //a corrupt count fails at the end of the file instead of allocating it
+    uint32_t count{read_count()};
+    for (uint32_t i{}; i < count && in; ++i){
+        KEY key{};
+        read_key(in, key);
+        if (in)
+            intern(key);
+    }
+
+    count = read_count();
+    for (uint32_t i{}; i < count && in; ++i){
+        uint32_t index{};
+        unsigned char flags{};
+        read_key(in, index);
+        read_key(in, flags);
+        if (in){
+            shape_keys.push_back(index);
+            shape_flags.push_back(flags);
+        }
+    }
+
+    count = read_count();
+    for (uint32_t i{}; i < count && in; ++i){
+        Step step{};
+        read_key(in, step.event);
+        read_key(in, step.key);
+        if (in)
+            steps.push_back(step);
+    }
+
+    //every index must refer to a key that was read, every event must be one we know
+    bool valid{static_cast<bool>(in)};
+    for (uint32_t index : shape_keys)
+        valid = valid && index < keys.size();
+    for (const Step &step : steps)
+        valid = valid && step.key < keys.size()
+                      && static_cast<unsigned char>(step.event) <= static_cast<unsigned char>(Event::FLIP);
+    if (!valid)
+        clear();
+    return valid;
+}